@@ -0,0 +1,137 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <filesystem>
+
+#include "computer_graphics/Math.h"
+#include "computer_graphics/File.h"
+#include "computer_graphics/Thread_Pool.h"
+#include "computer_graphics/LAZ.h"
+#include "computer_graphics/Point_Cloud.h"
+
+//reads Cloud Optimized Point Cloud (COPC) files, LAS 1.4 LAZ files whose chunks are the nodes of an octree described by the hierarchy EVLR.
+//Opening a file only reads its header and the root hierarchy page, queries then walk the octree and only load the hierarchy pages and decompress the nodes they actually touch
+class COPC_Reader {
+
+ public:
+
+#pragma pack(push, 1)
+	//the "copc" VLR with record ID 1, which has to be the first VLR of the file
+	struct COPC_Info {
+
+		double center_x, center_y, center_z;
+		double halfsize;
+		double spacing;
+		uint64_t root_hierarchy_offset;
+		uint64_t root_hierarchy_size;
+		double gpstime_minimum, gpstime_maximum;
+		uint64_t reserved[11];
+
+	};
+#pragma pack(pop)
+
+	//a node of the octree, at *level* the cube of the root is split into 2^level cells along each axis and *x*, *y*, *z* index one of them
+	struct Voxel_Key {
+
+		int32_t level;
+		int32_t x;
+		int32_t y;
+		int32_t z;
+
+		bool operator==(const Voxel_Key& key) const {
+
+			return this->level == key.level && this->x == key.x && this->y == key.y && this->z == key.z;
+
+		};
+
+		Voxel_Key get_child(const int& i) const {
+
+			return { this->level + 1, (this->x << 1) | (i & 1), (this->y << 1) | ((i >> 1) & 1), (this->z << 1) | ((i >> 2) & 1) };
+
+		};
+
+	};
+
+	struct Voxel_Key_Hasher {
+
+		size_t operator()(const Voxel_Key& key) const {
+
+			size_t hash = std::hash<int32_t>()(key.level);
+			hash ^= std::hash<int32_t>()(key.x) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+			hash ^= std::hash<int32_t>()(key.y) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+			hash ^= std::hash<int32_t>()(key.z) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+			return hash;
+
+		};
+
+	};
+
+#pragma pack(push, 1)
+	//a hierarchy page is an array of these 32 byte entries. A *point_count* of -1 means *offset* and *byte_size* point to the child page holding the entries of the key and its descendants,
+	//otherwise they point to the LAZ chunk holding the *point_count* points of the node
+	struct Hierarchy_Entry {
+
+		Voxel_Key key;
+		uint64_t offset;
+		int32_t byte_size;
+		int32_t point_count;
+
+	};
+#pragma pack(pop)
+
+	static constexpr int32_t CHILD_HIERARCHY_PAGE = -1;
+
+	//a node returned by a query, with the bounds of its cube in openGL space
+	struct Node {
+
+		Hierarchy_Entry entry;
+		vec3 minimum_bounds;
+		vec3 maximum_bounds;
+
+	};
+
+	COPC_Info info;
+	uint64_t number_of_point_records;
+
+	//reads the header, the VLRs and the root hierarchy page of the file. The file stays mapped for as long as the reader exists
+	COPC_Reader(const std::filesystem::path& path_to_COPC_file);
+
+	//the bounds of the root cube in openGL space
+	std::pair<vec3, vec3> get_openGL_bounds() const;
+
+	//nodes down to *max_depth* (0 being the root) whose cube intersects the openGL space box [minimum, maximum]
+	std::vector<Node> query_box(const vec3& minimum, const vec3& maximum, const int32_t& max_depth);
+
+	//nodes down to *max_depth* whose cube intersects the view volume of *view_projection*, which transforms from openGL space into clip space
+	std::vector<Node> query_frustum(const mat4& view_projection, const int32_t& max_depth);
+
+	//decompresses the points of *nodes* back to back into *positions* and *colors*, which are resized to hold exactly them. Nodes are decoded in parallel, each one into its own slice
+	void decode_nodes(const std::vector<Node>& nodes, std::vector<vec3>& positions, std::vector<vec3>& colors);
+
+	COPC_Reader(const COPC_Reader&) = delete;
+	COPC_Reader& operator=(const COPC_Reader&) = delete;
+
+ private:
+
+	Memory_Mapped_File file;
+	Point_Cloud cloud;
+	Point_Cloud::Public_Header_Block_Version_1_4 header;
+	std::unique_ptr<LAZ_Decoder> LAZ_decoder;
+
+	//every entry of the hierarchy pages loaded so far
+	std::unordered_map<Voxel_Key, Hierarchy_Entry, Voxel_Key_Hasher> hierarchy;
+
+	void load_hierarchy_page(const uint64_t& offset, const uint64_t& byte_size);
+
+	//the entry of *key*, loading its hierarchy page first if needed. Null if the node doesnt exist
+	const Hierarchy_Entry* get_hierarchy_entry(const Voxel_Key& key);
+
+	std::pair<vec3, vec3> get_openGL_bounds(const Voxel_Key& key) const;
+
+	//walks the octree from the root and collects every node down to *max_depth* whose bounds pass *intersects*, children of rejected nodes are skipped
+	std::vector<Node> query(const int32_t& max_depth, const std::function<bool(const vec3& minimum, const vec3& maximum)>& intersects);
+
+};
@@ -326,3 +326,38 @@ static void move_files_with_extension(const std::filesystem::path& source_direct
 	};
 
 };
+
+//maps the whole file into memory as read only, so its bytes can be decoded in place without issuing a stream call or a copy for every record. The mapping lives as long as the object does
+class Memory_Mapped_File {
+
+ public:
+
+	const char* data;
+	size_t size;
+
+	Memory_Mapped_File(const std::filesystem::path& file_path);
+
+	//tells the OS that the bytes [offset, offset + n_bytes) wont be read again, so their pages can be dropped from memory. Used to keep the resident size bounded while streaming through big files
+	void discard(const size_t& offset, const size_t& n_bytes) const;
+
+	//move constructor
+	Memory_Mapped_File(Memory_Mapped_File&& other) noexcept;
+
+	//move assignment operator
+	Memory_Mapped_File& operator=(Memory_Mapped_File&& other) noexcept;
+
+	//the mapping is owned by exactly one instance, hence copying is not allowed
+	Memory_Mapped_File(const Memory_Mapped_File&) = delete;
+	Memory_Mapped_File& operator=(const Memory_Mapped_File&) = delete;
+
+	//destructor
+	~Memory_Mapped_File();
+
+ private:
+
+	void* file_handle;
+	void* mapping_handle;
+
+	void unmap();
+
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+#include "computer_graphics/Thread_Pool.h"
+
+//groups equal keys in parallel by sorting: the elements are scattered into buckets by a hash of their key and every bucket is then sorted on its own, so equal keys sit next to each other
+//inside their bucket and nothing is shared between the threads. Used by *Voxel_Downsampler* for the cells of the points and by *Vertex_Deduplicator* for the vertices
+class Hash_Binning {
+
+ public:
+
+	static constexpr size_t ELEMENTS_PER_TASK = 1 << 16;
+
+	//spreads the bits of *value* over the whole 64 bits, so keys that differ in a few bits land in different buckets
+	static uint64_t mix(uint64_t value);
+
+	//sorts the elements *make_element(i)* for every i in [0, *n_elements*) into *binned*, bucket after bucket, the bucket of an element being *hash_element(element)* masked to the number of buckets.
+	//Every bucket is sorted with the *operator<* of the element. Returns where every bucket starts in *binned*, followed by the number of elements
+	template<typename Element, typename Make_Element, typename Hash_Element>
+	static std::vector<size_t> bin(const size_t& n_elements, std::vector<Element>& binned, const Make_Element& make_element, const Hash_Element& hash_element) {
+
+		binned.resize(n_elements);
+		if (n_elements == 0) { return { 0, 0 }; };
+
+		//roughly one bucket per task so every bucket sorts in cache, a power of two so the bucket is a mask of the hash
+		size_t n_buckets = 1;
+		while (n_buckets < 1024 && n_buckets * ELEMENTS_PER_TASK < n_elements) { n_buckets <<= 1; };
+		const uint64_t bucket_mask = n_buckets - 1;
+
+		//every chunk counts its elements per bucket, the prefix sum over buckets then chunks gives every chunk its own range inside every bucket so the scatter needs no synchronization
+		const size_t n_chunks = (n_elements + ELEMENTS_PER_TASK - 1) / ELEMENTS_PER_TASK;
+		std::vector<size_t> chunk_offsets(n_chunks * n_buckets, 0);
+		Thread_Pool::shared().parallel_for(n_chunks, 1, [&](const size_t& first, const size_t& last) {
+
+			for (size_t chunk = first; chunk < last; ++chunk) {
+
+				size_t* counts = &chunk_offsets[chunk * n_buckets];
+				const size_t end = std::min(n_elements, (chunk + 1) * ELEMENTS_PER_TASK);
+				for (size_t i = chunk * ELEMENTS_PER_TASK; i < end; ++i) { ++counts[hash_element(make_element(i)) & bucket_mask]; };
+
+			};
+
+		});
+
+		std::vector<size_t> bucket_offsets(n_buckets + 1, 0);
+		size_t offset = 0;
+		for (size_t bucket = 0; bucket < n_buckets; ++bucket) {
+
+			bucket_offsets[bucket] = offset;
+			for (size_t chunk = 0; chunk < n_chunks; ++chunk) {
+
+				const size_t count = chunk_offsets[chunk * n_buckets + bucket];
+				chunk_offsets[chunk * n_buckets + bucket] = offset;
+				offset += count;
+
+			};
+
+		};
+		bucket_offsets[n_buckets] = offset;
+
+		//the elements are made again instead of kept from the counting pass, which keeps the memory at one element per input
+		Thread_Pool::shared().parallel_for(n_chunks, 1, [&](const size_t& first, const size_t& last) {
+
+			for (size_t chunk = first; chunk < last; ++chunk) {
+
+				size_t* offsets = &chunk_offsets[chunk * n_buckets];
+				const size_t end = std::min(n_elements, (chunk + 1) * ELEMENTS_PER_TASK);
+				for (size_t i = chunk * ELEMENTS_PER_TASK; i < end; ++i) {
+
+					const Element element = make_element(i);
+					binned[offsets[hash_element(element) & bucket_mask]++] = element;
+
+				};
+
+			};
+
+		});
+
+		Thread_Pool::shared().parallel_for(n_buckets, 1, [&](const size_t& first, const size_t& last) {
+
+			for (size_t bucket = first; bucket < last; ++bucket) { std::sort(binned.begin() + bucket_offsets[bucket], binned.begin() + bucket_offsets[bucket + 1]); };
+
+		});
+
+		return bucket_offsets;
+
+	};
+
+};
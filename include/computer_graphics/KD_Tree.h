@@ -0,0 +1,91 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <functional>
+
+#include "computer_graphics/Math.h"
+#include "computer_graphics/Thread_Pool.h"
+
+//a balanced k-d tree over a point cloud for radius, k nearest and ray queries. Every node splits its points at their median along the longest side of its cell, so the shape of the tree only depends on
+//the number of points: the nodes are a flat array where the children of node i are 2i + 1 and 2i + 2 and the range of points of a node is worked out while descending, which leaves 5 bytes per node.
+//The points are reordered so every leaf is a contiguous run of positions next to their original indices, and every level of the tree is built in parallel over its nodes
+class KD_Tree {
+
+ public:
+
+	//leaves hold at most this many points, a leaf is scanned linearly which is faster than descending any further
+	static constexpr size_t MAX_POINTS_PER_LEAF = 16;
+
+	uint64_t number_of_points;
+	vec3 minimum_bounds;
+	vec3 maximum_bounds;
+
+	//the indices, into the positions the tree was built from, of the points within *radius* of *center*, in no particular order
+	std::vector<uint32_t> radius_search(const vec3& center, const float& radius) const;
+
+	//the indices of the *k* points closest to *point*, closest first. *squared_distances* receives their squared distances unless null
+	std::vector<uint32_t> k_nearest(const vec3& point, const size_t& k, std::vector<float>* squared_distances = nullptr) const;
+
+	//the point closest to *origin* along the ray among the points at most *radius* away from the ray, which is how a pick ray through a pixel finds the point the pixel shows.
+	//Returns false when no point is close enough, otherwise *index* and *distance*, unless null, receive the point and its distance along the ray
+	bool ray_nearest(const vec3& origin, const vec3& direction, const float& radius, uint32_t& index, float* distance = nullptr) const;
+
+	//calls *visit* from the pool for every point with the offsets of its *k* nearest other points from it, closest first. The points are queried in parallel in the order of the leaves,
+	//so consecutive queries walk the same nodes, and the offsets are in the frame the tree was built in so neighbours from different tiles of a mosaic line up
+	void for_each_neighbourhood(const size_t& k, const std::function<void(const uint32_t& index, const std::vector<vec3>& neighbours)>& visit) const;
+
+	//the mean distance of every point to its *k* nearest other points, by the index of the point
+	std::vector<float> compute_mean_neighbour_distances(const size_t& k) const;
+
+	//builds the tree over *n_points* positions, which are copied so they dont have to outlive the tree
+	KD_Tree(const vec3* positions, const size_t& n_points);
+	KD_Tree(const std::vector<vec3>& positions);
+
+ private:
+
+#pragma pack(push, 1)
+	struct Node {
+
+		float split;
+		uint8_t axis;
+
+	};
+#pragma pack(pop)
+
+#pragma pack(push, 1)
+	struct Indexed_Point {
+
+		vec3 position;
+		uint32_t index;
+
+	};
+#pragma pack(pop)
+
+	//the levels above the leaves, the first *nodes.size()* nodes are split and every node past them is a leaf
+	uint32_t n_levels;
+	std::vector<Node> nodes;
+	std::vector<Indexed_Point> points;
+
+	//the range of points of a node halves with every level, the left child takes the lower half
+	static size_t get_middle(const size_t& first, const size_t& last) { return first + (last - first) / 2; };
+	static float get_coordinate(const vec3& position, const uint8_t& axis) { return axis == 0 ? position.x : axis == 1 ? position.y : position.z; };
+	static void set_coordinate(vec3& position, const uint8_t& axis, const float& value) { if (axis == 0) { position.x = value; } else if (axis == 1) { position.y = value; } else { position.z = value; }; };
+
+	void build();
+
+	void radius_search(const uint32_t& node, const size_t& first, const size_t& last, const vec3& center, const float& squared_radius, std::vector<uint32_t>& indices) const;
+
+	static constexpr size_t POINTS_PER_TASK = 1 << 16;
+
+	//*nearest* holds the best squared distances found so far and where their points are in *points*, closest first
+	void k_nearest(const uint32_t& node, const size_t& first, const size_t& last, const vec3& point, const size_t& k, std::vector<std::pair<float, uint32_t>>& nearest) const;
+
+	//*cell_minimum* and *cell_maximum* bound the points of the node. *inverse_direction* is 1 / *direction* per axis for the slab test of the cells
+	void ray_nearest(const uint32_t& node, const size_t& first, const size_t& last, vec3 cell_minimum, vec3 cell_maximum, const vec3& origin, const vec3& direction, const vec3& inverse_direction, const float& radius, float& best_distance, uint32_t& best_index) const;
+
+};
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <future>
+#include <algorithm>
+#include <filesystem>
+
+#include "computer_graphics/Math.h"
+#include "computer_graphics/Thread_Pool.h"
+#include "computer_graphics/Point_Cloud.h"
+
+//writes decoded points back into an uncompressed LAS file. The positions are turned back into geospatial coordinates through the frame they were decoded in and quantized with the scale and offset
+//of their source file, so points that came straight from a file get their original integers back. Records are encoded in parallel into one batch whilst the previous batch is written out on another thread
+class LAS_Writer {
+
+ public:
+
+	//LAS 1.2 files get point format 2, or 3 when there are GPS times, and LAS 1.4 files get point format 7
+	static constexpr uint8_t VERSION_1_2 = 2;
+	static constexpr uint8_t VERSION_1_4 = 4;
+
+	//a run of consecutive points that were decoded in the same frame, a mosaic has one per tile
+	struct Point_Range {
+
+		const vec3* positions;
+
+		//null writes black points
+		const vec3* colors;
+		uint64_t n_points;
+		Point_Cloud::Geospatial_Frame frame;
+
+		//the coordinate reference system records of the file the points came from, see *Point_Cloud::read_coordinate_reference_system*. Null when it isnt known
+		const std::vector<Point_Cloud::Coordinate_Reference_System_Record>* coordinate_reference_system = nullptr;
+
+	};
+
+	//writes the points of all *point_ranges*, in order, into *path_to_LASer_file*, with the coordinate reference system of the first range as VLRs: LAS 1.4 files keep its WKT and LAS 1.2 files its GeoTIFF keys. *point_attributes*, indexed like the points of all ranges one after the other, fills intensity, classification,
+	//returns and GPS time, null leaves them empty. Unless null, only the points whose indices are in *selection*, sorted ascending, are written. Returns false, after saying why, if the file couldnt be written
+	static bool write(const std::filesystem::path& path_to_LASer_file, const std::vector<Point_Range>& point_ranges, const Point_Cloud::Point_Attributes* point_attributes = nullptr, const std::vector<uint64_t>* selection = nullptr, const uint8_t& version_minor = VERSION_1_4);
+
+ private:
+
+	static constexpr size_t POINTS_PER_TASK = 1 << 16;
+
+	//points encoded before a batch is handed to the writing thread
+	static constexpr size_t POINTS_PER_BATCH = 1 << 21;
+
+	//what every task learns about the records it encoded, merged into the header once all are written
+	struct Chunk_Statistics {
+
+		int32_t minimum[3];
+		int32_t maximum[3];
+		uint64_t number_of_points_by_return[15];
+
+	};
+
+	//encodes the points *first* to *last* of the written points into consecutive records at *records*
+	template<typename Point_Data_Record_Format_X>
+	static void encode_records(const std::vector<Point_Range>& point_ranges, const std::vector<uint64_t>& range_starts, const Point_Cloud::Point_Attributes* point_attributes, const std::vector<uint64_t>* selection, const double scale[3], const double offset[3],
+		const uint64_t& first, const uint64_t& last, char* records, Chunk_Statistics& statistics) {
+
+		constexpr bool extended_format = requires(Point_Data_Record_Format_X record) { record.scanner_channel; };
+		constexpr bool has_GPS_time = requires(Point_Data_Record_Format_X record) { record.GPS_time; };
+
+		for (int axis = 0; axis < 3; axis++) { statistics.minimum[axis] = INT32_MAX; statistics.maximum[axis] = INT32_MIN; };
+		std::fill(statistics.number_of_points_by_return, statistics.number_of_points_by_return + 15, 0);
+
+		size_t range = 0;
+		for (uint64_t i = first; i < last; i++) {
+
+			const uint64_t point = selection ? (*selection)[i] : i;
+			while (range + 1 < point_ranges.size() && point >= range_starts[range + 1]) { range++; };
+			const Point_Range& point_range = point_ranges[range];
+			const uint64_t point_in_range = point - range_starts[range];
+
+			double geospatial_position[3];
+			point_range.frame.compute_geospatial_coordinates(point_range.positions[point_in_range], geospatial_position);
+
+			Point_Data_Record_Format_X record = {};
+			int32_t coordinates[3];
+			for (int axis = 0; axis < 3; axis++) {
+
+				coordinates[axis] = static_cast<int32_t>(std::llround((geospatial_position[axis] - offset[axis]) / scale[axis]));
+				statistics.minimum[axis] = std::min(statistics.minimum[axis], coordinates[axis]);
+				statistics.maximum[axis] = std::max(statistics.maximum[axis], coordinates[axis]);
+
+			};
+			record.X = coordinates[0]; record.Y = coordinates[1]; record.Z = coordinates[2];
+
+			//the decoders divide the colors by 255, whatever their bit depth
+			if (point_range.colors) {
+
+				const vec3& color = point_range.colors[point_in_range];
+				record.red = static_cast<uint16_t>(std::clamp(std::lround(color.x * 255.0f), 0l, long(UINT16_MAX)));
+				record.green = static_cast<uint16_t>(std::clamp(std::lround(color.y * 255.0f), 0l, long(UINT16_MAX)));
+				record.blue = static_cast<uint16_t>(std::clamp(std::lround(color.z * 255.0f), 0l, long(UINT16_MAX)));
+
+			};
+
+			uint8_t return_number = 1, number_of_returns = 1;
+			if (point_attributes) {
+
+				record.intensity = point_attributes->intensities[point];
+				record.classification = extended_format ? point_attributes->classifications[point] : point_attributes->classifications[point] & 0x1F;
+				return_number = point_attributes->returns[point] & 0x0F;
+				number_of_returns = point_attributes->returns[point] >> 4;
+				if constexpr (has_GPS_time) { if (!point_attributes->GPS_times.empty()) { record.GPS_time = point_attributes->GPS_times[point]; }; };
+
+			};
+			if constexpr (!extended_format) { return_number = std::min<uint8_t>(return_number, 7); number_of_returns = std::min<uint8_t>(number_of_returns, 7); };
+			record.return_number = return_number;
+			record.number_of_returns = number_of_returns;
+			if (return_number >= 1 && return_number <= 15) { statistics.number_of_points_by_return[return_number - 1]++; };
+
+			std::memcpy(records + (i - first) * sizeof(Point_Data_Record_Format_X), &record, sizeof(Point_Data_Record_Format_X));
+
+		};
+
+	};
+
+	//the header of the written file, filled with everything but the counts and bounds
+	template<typename Public_Header_Block_Version_X_X>
+	static Public_Header_Block_Version_X_X create_header(const uint8_t& version_minor, const uint8_t& point_data_record_format, const double scale[3], const double offset[3]) {
+
+		Public_Header_Block_Version_X_X header = {};
+		std::memcpy(header.file_signature, "LASF", 4);
+		header.version_major = 1;
+		header.version_minor = version_minor;
+		std::memcpy(header.system_identifier, "EXPORT", 6);
+		std::memcpy(header.generating_software, "computer_graphics", 17);
+		header.header_size = sizeof(Public_Header_Block_Version_X_X);
+		header.offset_to_point_data = sizeof(Public_Header_Block_Version_X_X);
+		header.point_data_record_format = point_data_record_format;
+		header.point_data_record_length = Point_Cloud::get_point_data_record_size(point_data_record_format);
+		header.X_scale_factor = scale[0]; header.Y_scale_factor = scale[1]; header.Z_scale_factor = scale[2];
+		header.X_offset = offset[0]; header.Y_offset = offset[1]; header.Z_offset = offset[2];
+		return header;
+
+	};
+
+	//encodes and writes all records after the header and the *coordinate_reference_system* VLRs, then the header with the counts and bounds of what was written
+	template<typename Public_Header_Block_Version_X_X, typename Point_Data_Record_Format_X>
+	static bool write_points(std::ofstream& file, const std::vector<Point_Range>& point_ranges, const std::vector<uint64_t>& range_starts, const Point_Cloud::Point_Attributes* point_attributes, const std::vector<uint64_t>* selection,
+		const uint64_t& n_points, const uint8_t& version_minor, const uint8_t& point_data_record_format, const double scale[3], const double offset[3],
+		const std::vector<const Point_Cloud::Coordinate_Reference_System_Record*>& coordinate_reference_system, const bool& WKT);
+
+};
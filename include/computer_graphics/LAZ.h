@@ -0,0 +1,96 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+//decompresses LASzip compressed point data (LAZ) back into uncompressed LAS point data records, so they can go through the exact same decoding as the records of a LAS file.
+//Supports the pointwise chunked compressor with the version 2 items of point formats 0 to 3 and the layered chunked compressor with the version 3 items of point formats 6 to 8, both with extra bytes.
+//Every chunk is compressed on its own, so different chunks can be decompressed on different threads at the same time
+class LAZ_Decoder {
+
+ public:
+
+#pragma pack(push, 1)
+	//the LASzip VLR (user ID "laszip encoded", record ID 22204) starts with this header, followed by *number_of_items* items
+	struct LASzip_Record_Header {
+
+		uint16_t compressor;
+		uint16_t coder;
+		uint8_t version_major;
+		uint8_t version_minor;
+		uint16_t version_revision;
+		uint32_t options;
+		uint32_t chunk_size;
+		int64_t number_of_special_extended_variable_length_records;
+		int64_t offset_to_special_extended_variable_length_records;
+		uint16_t number_of_items;
+
+	};
+#pragma pack(pop)
+
+#pragma pack(push, 1)
+	//the items of a record are compressed one after the other in the order of the VLR, each one covering the next *size* bytes of the record
+	struct Item {
+
+		uint16_t type;
+		uint16_t size;
+		uint16_t version;
+
+	};
+#pragma pack(pop)
+
+	static constexpr uint16_t ITEM_BYTE = 0;
+	static constexpr uint16_t ITEM_POINT10 = 6;
+	static constexpr uint16_t ITEM_GPSTIME11 = 7;
+	static constexpr uint16_t ITEM_RGB12 = 8;
+	static constexpr uint16_t ITEM_WAVEPACKET13 = 9;
+	static constexpr uint16_t ITEM_POINT14 = 10;
+	static constexpr uint16_t ITEM_RGB14 = 11;
+	static constexpr uint16_t ITEM_RGBNIR14 = 12;
+	static constexpr uint16_t ITEM_WAVEPACKET14 = 13;
+	static constexpr uint16_t ITEM_BYTE14 = 14;
+
+	static constexpr uint16_t COMPRESSOR_POINTWISE = 1;
+	static constexpr uint16_t COMPRESSOR_POINTWISE_CHUNKED = 2;
+	static constexpr uint16_t COMPRESSOR_LAYERED_CHUNKED = 3;
+
+	//chunk size written when the chunks have different sizes, their point counts are then stored in the chunk table
+	static constexpr uint32_t VARIABLE_CHUNK_SIZE = 0xFFFFFFFF;
+
+	uint16_t compressor;
+	uint32_t chunk_size;
+	std::vector<Item> items;
+	uint16_t point_data_record_length;
+	uint64_t number_of_point_records;
+
+	//file offset and first point of every chunk, both with one extra entry marking where the last chunk ends
+	std::vector<uint64_t> chunk_offsets;
+	std::vector<uint64_t> chunk_first_points;
+
+	//reads the LASzip VLR stored at *laszip_record* and checks that its items can be decompressed and add up to *point_data_record_length*
+	LAZ_Decoder(const char* laszip_record, const uint64_t& laszip_record_length, const uint16_t& point_data_record_length);
+
+	//additionally reads the chunk table of the point data block starting at *offset_to_point_data*. The decoder refers to *file_data*, which has to outlive it
+	LAZ_Decoder(const char* file_data, const size_t& file_size, const char* laszip_record, const uint64_t& laszip_record_length, const uint64_t& offset_to_point_data, const uint64_t& number_of_point_records, const uint16_t& point_data_record_length);
+
+	size_t get_chunk_of_point(const uint64_t& point) const;
+
+	//decompresses the points [first_point, last_point) into *records*, which receives their uncompressed records back to back.
+	//Every chunk touched is decompressed from its start, so ranges beginning at a chunk boundary waste no work
+	void decompress(uint64_t first_point, const uint64_t& last_point, char* records) const;
+
+	//decompresses the points [first_in_chunk, last_in_chunk) of the chunk holding *n_points_in_chunk* points in the *chunk_n_bytes* bytes at *chunk_data*
+	void decompress_chunk(const char* chunk_data, const uint64_t& chunk_n_bytes, const uint64_t& n_points_in_chunk, const uint64_t& first_in_chunk, const uint64_t& last_in_chunk, char* records) const;
+
+ private:
+
+	const char* file_data;
+	size_t file_size;
+
+	void read_chunk_table(const uint64_t& offset_to_point_data);
+
+};
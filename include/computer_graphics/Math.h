@@ -1210,6 +1210,53 @@ static mat4 create_model_view_projection_matrix(const mat4& model_transformation
 
 };
 
+//the 6 planes (left, right, bottom, top, near, far) bounding the view volume of a (model) view projection matrix, each one as (normal, distance) with the normal pointing inwards.
+//Extracted straight from the rows of the matrix, so boxes can be culled in the same space the matrix transforms from
+class Frustum {
+
+public:
+
+	vec4 planes[6];
+
+	Frustum(const mat4& view_projection) {
+
+		vec4 row_1(view_projection.a11, view_projection.a12, view_projection.a13, view_projection.a14);
+		vec4 row_2(view_projection.a21, view_projection.a22, view_projection.a23, view_projection.a24);
+		vec4 row_3(view_projection.a31, view_projection.a32, view_projection.a33, view_projection.a34);
+		vec4 row_4(view_projection.a41, view_projection.a42, view_projection.a43, view_projection.a44);
+
+		this->planes[0] = row_4 + row_1;
+		this->planes[1] = row_4 - row_1;
+		this->planes[2] = row_4 + row_2;
+		this->planes[3] = row_4 - row_2;
+		this->planes[4] = row_4 + row_3;
+		this->planes[5] = row_4 - row_3;
+		for (vec4& plane : this->planes) {
+
+			float length = vec3(plane.x, plane.y, plane.z).magnitude();
+			if (length > 0.0f) { plane *= 1.0f / length; };
+
+		};
+
+	};
+
+	//conservative test, a box is only rejected when it lies completely behind one of the planes
+	bool intersects_box(const vec3& minimum, const vec3& maximum) const {
+
+		for (const vec4& plane : this->planes) {
+
+			//the corner furthest along the normal
+			vec3 corner(plane.x >= 0.0f ? maximum.x : minimum.x, plane.y >= 0.0f ? maximum.y : minimum.y, plane.z >= 0.0f ? maximum.z : minimum.z);
+			if (plane.x * corner.x + plane.y * corner.y + plane.z * corner.z + plane.w < 0.0f) { return false; };
+
+		};
+
+		return true;
+
+	};
+
+};
+
 static float get_area_of_circle(const float& radius) {
 
 	return radius * radius * 3.14159265359f;
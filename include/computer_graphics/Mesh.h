@@ -2,6 +2,7 @@
 #include <iostream>
 #include <vector>
 #include <array>
+#include <memory>
 #include <unordered_map>
 
 #include <glad/glad.h>
@@ -9,30 +10,22 @@
 #include "computer_graphics/Math.h"
 #include "computer_graphics/File.h"
 #include "computer_graphics/Point_Cloud.h"
-
-//struct used to hash the unordered_map we are using in our *Mesh* class
-struct vec3_vec3_vec2_hasher {
-
-	std::size_t operator()(const std::tuple<vec3, vec3, vec2>& tuple) const {
-
-		std::size_t h1 = vec3_hasher()(std::get<0>(tuple));
-		std::size_t h2 = vec3_hasher()(std::get<1>(tuple));
-		std::size_t h3 = vec2_hasher()(std::get<2>(tuple));
-
-		std::size_t seed = h1;
-		seed = hash_combine(seed, h2);
-		seed = hash_combine(seed, h3);
-		return seed;
-
-	};
-
-};
+#include "computer_graphics/Octree.h"
+#include "computer_graphics/Point_Cloud_Cache.h"
+#include "computer_graphics/Voxel_Downsampler.h"
+#include "computer_graphics/KD_Tree.h"
+#include "computer_graphics/Outlier_Filter.h"
+#include "computer_graphics/Normal_Estimator.h"
+#include "computer_graphics/LAS_Writer.h"
+#include "computer_graphics/OBJ_Parser.h"
+#include "computer_graphics/Vertex_Deduplicator.h"
+#include "computer_graphics/Mesh_Optimizer.h"
 
 class Vertex {
 
 public:
 
-	unsigned short index;
+	uint32_t index;
 
 	vec3 position;
 	vec3 normal;
@@ -68,6 +61,24 @@ public:
 
 };
 
+#pragma pack(push, 1)
+//a point of a point cloud the way it is stored on the GPU: the position quantized to 16 bits per axis inside a box and the color as 8 bit RGBA, interleaved in 12 bytes instead of
+//the 24 bytes of a float position and color in two buffers. The LAS_POINTS vertex shader reads both as normalized attributes and turns the position back into *box_minimum + position * box_size*
+struct Quantized_Point {
+
+	uint16_t x, y, z;
+
+	//unused, keeps every point 4 byte aligned
+	uint16_t padding;
+
+	uint8_t red, green, blue, alpha;
+
+	//quantizes *n_points* positions and colors in parallel. Positions outside the box are clamped to it and colors to [0, 1], which is what the screen shows of them anyway
+	static void quantize(const vec3* positions, const vec3* colors, const size_t& n_points, const vec3& box_minimum, const vec3& box_size, Quantized_Point* quantized_points);
+
+};
+#pragma pack(pop)
+
 class Texture {
 
  public:
@@ -107,7 +118,8 @@ class Mesh {
 	Texture displacement_map;
 
 	vec2 mesh_dimensions;
-	std::unordered_map<std::tuple<vec3, vec3, vec2>, unsigned short, vec3_vec3_vec2_hasher> vertices_map;
+	//the unique vertices added so far by *check_accumalate_add*, freed once the mesh is built
+	Vertex_Deduplicator vertices_table;
 
 	std::vector<unsigned int> indices;
 	std::vector<vec3> positions;
@@ -117,6 +129,9 @@ class Mesh {
 	std::vector<vec2> texture_coordinates;
 	std::vector<vec3> colors;
 
+	//the surface variation of every point of a point cloud whose normals were estimated, see *Normal_Estimator*, empty for every other mesh
+	std::vector<float> curvatures;
+
 	//used as a signal to the shader to decide if buffers and textures of this mesh have been already generated or not
 	bool generate_buffers_and_textures;
 	bool draw_as_elements;
@@ -124,17 +139,80 @@ class Mesh {
 	vec3 minimum_bounds;
 	vec3 maximum_bounds;
 
-	void add_without_check(Vertex& vertex, int& index_counter);
-	void add_without_check(Triangle& triangle, int& index_counter);
+	//per point attributes of a LAS file described by its Extra Bytes VLR, empty for every other mesh
+	std::vector<Point_Cloud::Extra_Bytes_Column> extra_bytes_columns;
+
+	//set when the mesh is a LAS file streamed in batches, the shader then pre-sizes the GPU buffers and appends every decoded batch into them as it arrives, drawing only the *n_streamed_vertices* uploaded so far
+	bool streamed = false;
+	uint64_t n_streamed_vertices = 0;
+	std::unique_ptr<Point_Cloud_Stream> point_cloud_stream;
+
+	//set when the LAS file was opened from its cache, the positions and colors then stay in the mapping and are uploaded straight from it as a single buffer
+	std::unique_ptr<Point_Cloud_Cache> point_cloud_cache;
+
+	//when set, the points of a LAS mesh are uploaded as *Quantized_Point* inside the bounds of the mesh, or of every tile or octree node, instead of as float positions and colors
+	bool quantized_points = false;
+
+	//set when the intensity, classification, returns and GPS time of a LAS mesh are kept, in *point_attributes* or in the cache it was opened from, and uploaded for the shaders to color the points by
+	bool keep_point_attributes = false;
+	Point_Cloud::Point_Attributes point_attributes;
 
-	void check_accumalate_add(Vertex& vertex, int& index_counter);
-	void check_accumalate_add(Triangle& triangle, int& index_counter);
+	//the frame the points of a single LAS file were decoded in, which turns them back into the coordinates of the file when exporting. Tiles carry their own
+	Point_Cloud::Geospatial_Frame geospatial_frame = {};
+
+	//the WKT and GeoTIFF records of the LAS file, or of the first tile of a mosaic, copied into its exports
+	std::vector<Point_Cloud::Coordinate_Reference_System_Record> coordinate_reference_system;
+
+	//set when the mesh is a mosaic of LAS tiles, the positions of every tile are then relative to its origin and the shader draws the tiles one by one
+	std::vector<Point_Cloud_Mosaic::Tile> point_cloud_tiles;
+
+	//set when the mesh is a level of detail octree, the shader then picks the nodes to draw every frame and only keeps those on the GPU instead of the whole cloud
+	std::unique_ptr<Octree> octree;
+	std::vector<uint32_t> drawn_octree_nodes;
+
+	//spatial index over the points, built by *get_KD_tree* the first time it is needed
+	std::unique_ptr<KD_Tree> KD_tree;
+
+	void add_without_check(Vertex& vertex, uint32_t& index_counter);
+	void add_without_check(Triangle& triangle, uint32_t& index_counter);
+
+	void check_accumalate_add(Vertex& vertex, uint32_t& index_counter);
+	void check_accumalate_add(Triangle& triangle, uint32_t& index_counter);
+
+	//merges the vertices added without check that share their position, normal and uv, accumalating their TBNs the way *check_accumalate_add* does and in the same order,
+	//with the sort based deduplication of *Vertex_Deduplicator*
+	void deduplicate_vertices();
+
+	//reorders the triangles of an indexed mesh for the post transform cache of *cache_size* vertices and against overdraw, then the vertices for the fetch, see *Mesh_Optimizer*,
+	//printing the ACMR and ATVR before and after. Run by *generate_terrain* and *extract_from_OBJ_file* on the meshes they build with unique vertices
+	void optimize_vertex_order(const uint32_t& cache_size = Mesh_Optimizer::DEFAULT_CACHE_SIZE);
 	
 	void set_as_single_face(Vertex& top_left, Vertex& bottom_left, Vertex& top_right, Vertex& bottom_right);
 	
 	void generate_terrain(const uint8_t& ADD_VERTICES);
 	void extract_from_OBJ_file(const std::filesystem::path& file_path, const uint8_t& ADD_VERTICES);
-	void extract_from_LAS_file(const std::filesystem::path& file_path);
+	//points rejected by *point_filter* are never decoded. A filtered cloud is neither read from nor written to the cache, which only holds whole files
+	void extract_from_LAS_file(const std::filesystem::path& file_path, const Point_Cloud::Point_Filter& point_filter = Point_Cloud::Point_Filter(), const bool& keep_point_attributes = false);
+
+	//keeps one point per cell of size *voxel_size*, or of the size that leaves at most *point_budget* points when *voxel_size* is 0, see *Voxel_Downsampler*
+	void downsample_points(const float& voxel_size, const uint64_t& point_budget, const uint8_t& SELECTION);
+
+	//removes the isolated points of a LAS mesh, see *Outlier_Filter*, then centres and scales the points that are left on their own bounds, moving *geospatial_frame* along so they still write back
+	//to the same coordinates. Mosaics keep their points since the tiles own fixed ranges of them
+	void remove_outliers(const uint32_t& neighbours = Outlier_Filter::DEFAULT_NEIGHBOURS, const float& standard_deviations = Outlier_Filter::DEFAULT_STANDARD_DEVIATIONS);
+
+	//copies the points out of the cache into the vectors so they can be changed, the cache is left as it is on disk for the next full resolution open
+	void copy_points_out_of_cache();
+
+	//the k-d tree over the points of the mesh, in the frame the bounds are in, so the positions of tiles are moved off their origins first. Streamed and octree meshes hold no points to index
+	const KD_Tree& get_KD_tree();
+
+	//fills *normals* and *curvatures* of a point cloud from its *neighbours* nearest points, see *Normal_Estimator*, so the points can be lit. Streamed and octree meshes hold no points to estimate them for
+	void estimate_normals(const uint32_t& neighbours = Normal_Estimator::DEFAULT_NEIGHBOURS);
+
+	//writes the points of a LAS mesh, with their attributes when kept, into an uncompressed LAS file, see *LAS_Writer*. Unless *crop_minimum* is above *crop_maximum*, only the points inside that box,
+	//in the frame the bounds are in, are written. Streamed and octree meshes hold no points to write. Returns false, after saying why, when nothing was written
+	bool write_LAS(const std::filesystem::path& path_to_LASer_file, const uint8_t& version_minor = LAS_Writer::VERSION_1_4, const vec3& crop_minimum = vec3(1.0f, 1.0f, 1.0f), const vec3& crop_maximum = vec3(0.0f, 0.0f, 0.0f));
 
  private:
 
@@ -149,13 +227,19 @@ class Mesh {
 	Mesh(const vec2& mesh_dimensions, const std::filesystem::path& path_maps_folder, const uint8_t& ADD_VERTICES);
 	Mesh(const std::filesystem::path& obj_file_path, const std::filesystem::path& path_maps_folder, const uint8_t& ADD_VERTICES);
 
-	Mesh(const std::filesystem::path& las_file_path);
+	Mesh(const std::filesystem::path& las_file_path, const float& voxel_size, const uint64_t& point_budget, const uint8_t& SELECTION, const Point_Cloud::Point_Filter& point_filter, const bool& keep_point_attributes, const bool& remove_outliers, const bool& estimate_normals);
+	Mesh(const std::filesystem::path& las_file_path, const size_t& host_memory_budget);
+	Mesh(const std::filesystem::path& las_file_path, const std::filesystem::path& octree_directory);
+	Mesh(const std::vector<std::filesystem::path>& las_file_paths, const Point_Cloud::Point_Filter& point_filter, const bool& keep_point_attributes, const bool& estimate_normals);
 
  public:
 
 	static constexpr uint8_t ADD_ONLY_UNIQUE_VERTICES = 0;
 	static constexpr uint8_t ADD_ALL_VERTICES = 1;
 
+	//the same mesh as ADD_ONLY_UNIQUE_VERTICES, built by adding every vertex and deduplicating them all at once in parallel instead of one at a time through the table
+	static constexpr uint8_t ADD_ONLY_UNIQUE_VERTICES_BY_SORTING = 2;
+
 	static Mesh empty();
 	static Mesh empty_quad();
 
@@ -187,6 +271,17 @@ class Mesh {
 
 	static Mesh from_procedural_folder(const vec2& mesh_dimensions, const std::filesystem::path& path_maps_folder, const uint8_t& ADD_VERTICES = ADD_ALL_VERTICES);
 	static Mesh from_OBJ_folder(const std::filesystem::path& obj_file_path, const std::filesystem::path& path_maps_folder, const uint8_t& ADD_VERTICES = ADD_ALL_VERTICES);
-	static Mesh from_LAS(const std::filesystem::path& las_file_path);
+
+	//when *voxel_size* or *point_budget* is set the points are downsampled to one per voxel, a *voxel_size* of 0 with a *point_budget* picks the voxel size that fits the budget
+	//only the points accepted by *point_filter* are decoded, before any downsampling. With *keep_point_attributes* the attributes the shaders can color the points by are kept as well,
+	//with *remove_outliers* the isolated points are removed before the cloud is downsampled and its bounds are taken, and with *estimate_normals* the points that are left get normals to be lit with
+	static Mesh from_LAS(const std::filesystem::path& las_file_path, const float& voxel_size = 0.0f, const uint64_t& point_budget = 0, const uint8_t& SELECTION = Voxel_Downsampler::FIRST_POINT, const Point_Cloud::Point_Filter& point_filter = Point_Cloud::Point_Filter(), const bool& keep_point_attributes = false, const bool& remove_outliers = false, const bool& estimate_normals = false);
+	static Mesh from_LAS_stream(const std::filesystem::path& las_file_path, const size_t& host_memory_budget = 64 * 1024 * 1024);
+
+	//builds the level of detail octree of the LAS file into *octree_directory* unless it is already there, by default a directory next to the file named after it with the extension .octree
+	static Mesh from_LAS_octree(const std::filesystem::path& las_file_path, const std::filesystem::path& octree_directory = "");
+
+	//loads several LAS tiles as one point cloud, placed in a frame shared by all of them so adjacent tiles line up
+	static Mesh from_LAS_mosaic(const std::vector<std::filesystem::path>& las_file_paths, const Point_Cloud::Point_Filter& point_filter = Point_Cloud::Point_Filter(), const bool& keep_point_attributes = false, const bool& estimate_normals = false);
 
 };
\ No newline at end of file
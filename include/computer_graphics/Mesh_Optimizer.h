@@ -0,0 +1,75 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+
+#include "computer_graphics/Math.h"
+#include "computer_graphics/Thread_Pool.h"
+
+//reorders the triangles and vertices of an indexed triangle mesh for the GPU, the way Tipsify (Sander, Nehab and Barczak, "Fast triangle reordering for vertex locality and reduced overdraw") does:
+//the triangles are fanned around vertices still in the post transform cache, the runs between cache flushes are cut into clusters that are drawn outside in so nearer surfaces
+//tend to come first, and the vertices are then renumbered in the order the triangles use them so the vertex fetch walks the attribute arrays forward
+class Mesh_Optimizer {
+
+ public:
+
+	//the FIFO post transform cache assumed by the reordering and the statistics, a size most GPUs are at or above
+	static constexpr uint32_t DEFAULT_CACHE_SIZE = 16;
+
+	//how much worse than its own run a cluster may be on the cache before it is cut, 1.05 lets the cache lose 5% for finer clusters to sort against overdraw
+	static constexpr float DEFAULT_OVERDRAW_THRESHOLD = 1.05f;
+
+	struct Statistics {
+
+		//average cache miss ratio: vertices transformed per triangle, 0.5 is the limit of a regular grid and 3 is no reuse at all
+		float ACMR;
+
+		//average transform to vertex ratio: vertices transformed per vertex used, 1 is every vertex transformed once
+		float ATVR;
+
+	};
+
+	//simulates a FIFO cache of *cache_size* vertices over the triangles of *indices*
+	static Statistics analyze_vertex_cache(const std::vector<unsigned int>& indices, const size_t& n_vertices, const uint32_t& cache_size = DEFAULT_CACHE_SIZE);
+
+	//reorders the triangles of *indices* for a cache of *cache_size* vertices with Tipsify. Unless null, *clusters* receives the first triangle of every run that starts after the cache was flushed
+	static void optimize_vertex_cache(std::vector<unsigned int>& indices, const size_t& n_vertices, const uint32_t& cache_size = DEFAULT_CACHE_SIZE, std::vector<uint32_t>* clusters = nullptr);
+
+	//cuts the runs starting at *clusters* wherever the cache has done within *threshold* of the whole run, then sorts the clusters by how far they face away from the centroid of the mesh
+	static void optimize_overdraw(std::vector<unsigned int>& indices, const std::vector<vec3>& positions, const std::vector<uint32_t>& clusters, const uint32_t& cache_size = DEFAULT_CACHE_SIZE, const float& threshold = DEFAULT_OVERDRAW_THRESHOLD);
+
+	//renumbers the vertices in the order *indices* first uses them, the vertices no triangle uses go last. Returns the new index of every old vertex, for *remap_vertices*
+	static std::vector<uint32_t> optimize_vertex_fetch(std::vector<unsigned int>& indices, const size_t& n_vertices);
+
+	//moves every vertex of *attribute* to the index *remap* gives it
+	template<typename T>
+	static void remap_vertices(std::vector<T>& attribute, const std::vector<uint32_t>& remap) {
+
+		if (attribute.size() != remap.size()) { return; };
+		std::vector<T> remapped(attribute.size());
+		Thread_Pool::shared().parallel_for(attribute.size(), VERTICES_PER_TASK, [&](const size_t& first, const size_t& last) {
+
+			for (size_t i = first; i < last; i++) { remapped[remap[i]] = attribute[i]; };
+
+		});
+		attribute = std::move(remapped);
+
+	};
+
+ private:
+
+	static constexpr size_t VERTICES_PER_TASK = 1 << 16;
+
+	//the triangles around every vertex, those of vertex v are *triangles[offsets[v]]* up to *triangles[offsets[v + 1]]*
+	struct Adjacency {
+
+		std::vector<uint32_t> offsets;
+		std::vector<uint32_t> triangles;
+
+	};
+
+	static Adjacency build_adjacency(const std::vector<unsigned int>& indices, const size_t& n_vertices);
+
+};
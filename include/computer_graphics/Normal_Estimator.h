@@ -0,0 +1,34 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+
+#include "computer_graphics/Math.h"
+#include "computer_graphics/Thread_Pool.h"
+#include "computer_graphics/KD_Tree.h"
+
+//normals of a point cloud by principal component analysis: the covariance of every point and its nearest neighbours has the normal of the surface they sample as the eigenvector of its smallest
+//eigenvalue, and that eigenvalue over the sum of all three is the surface variation, 0 on a plane and 1/3 where the points are spread evenly in all directions, which serves as curvature.
+//The neighbourhoods come from a *KD_Tree* queried in parallel
+class Normal_Estimator {
+
+ public:
+
+	static constexpr uint32_t DEFAULT_NEIGHBOURS = 16;
+
+	//fills *normals*, and *curvatures* unless null, for every point the tree was built over, indexed like its positions. PCA leaves the sign of a normal open, so every normal is turned
+	//to face *up*, which is the side an aerial scan sees. Points with too few or coincident neighbours get *up* and a curvature of 0
+	static void estimate(const KD_Tree& KD_tree, std::vector<vec3>& normals, std::vector<float>* curvatures = nullptr, const uint32_t& neighbours = DEFAULT_NEIGHBOURS, const vec3& up = vec3(0.0f, 1.0f, 0.0f));
+
+ private:
+
+	//the eigenvalues of the symmetric 3x3 matrix *covariance*, stored as xx, xy, xz, yy, yz, zz, in closed form, smallest first
+	static void compute_eigenvalues(const double covariance[6], double eigenvalues[3]);
+
+	//the eigenvector of *eigenvalue*, false when it isnt unique, i.e. the eigenvalue is repeated
+	static bool compute_eigenvector(const double covariance[6], const double& eigenvalue, double eigenvector[3]);
+
+};
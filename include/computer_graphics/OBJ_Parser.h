@@ -0,0 +1,103 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <charconv>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+#include "computer_graphics/Math.h"
+#include "computer_graphics/File.h"
+#include "computer_graphics/Thread_Pool.h"
+
+//parses Wavefront OBJ files over a memory map of the file. Numbers are read in place with std::from_chars, nothing is allocated per line, and the faces are fanned into
+//triangles whose corners index straight into the attribute arrays. The file can be split into chunks on line boundaries that are parsed in parallel and stitched back together,
+//the result is the same as parsing it serially
+class OBJ_Parser {
+
+ public:
+
+	//0 based indices into the attribute arrays, -1 when the face doesnt give the attribute, as in the v and v/vt forms
+	struct Corner {
+
+		int32_t position;
+		int32_t texture_coordinates;
+		int32_t normal;
+
+	};
+
+	std::vector<vec3> positions;
+	std::vector<vec2> texture_coordinates;
+	std::vector<vec3> normals;
+
+	//three per triangle, every face fanned around its first corner: a,b,c,d = abc and acd. Example: a,b,c,d,e = abc and acd and ade
+	std::vector<Corner> triangle_corners;
+	uint64_t number_of_faces = 0;
+
+	static constexpr uint8_t PARSE_SERIALLY = 0;
+	static constexpr uint8_t PARSE_IN_PARALLEL = 1;
+
+	//parses the v, vt, vn and f lines of the file, every other line is skipped. Faces take the v, v/vt, v//vn and v/vt/vn forms with 1 based or negative, i.e. relative to the end, indices
+	void parse(const std::filesystem::path& path_to_OBJ_file, const uint8_t& PARSE_MODE = PARSE_IN_PARALLEL);
+
+	//parses the OBJ text in [*data*, *data* + *size*), appending to what was parsed before
+	void parse(const char* data, const size_t& size, const uint8_t& PARSE_MODE = PARSE_IN_PARALLEL);
+
+ private:
+
+	//below this a chunk isnt worth handing to another thread
+	static constexpr size_t MINIMUM_CHUNK_SIZE = 1 << 20;
+
+	//a run of whole lines and what was parsed from it. The attributes declared before the chunk are only counted, its faces resolve their indices against those counts plus its own attributes
+	struct Chunk {
+
+		const char* first = nullptr;
+		const char* last = nullptr;
+
+		size_t positions_before = 0;
+		size_t texture_coordinates_before = 0;
+		size_t normals_before = 0;
+
+		std::vector<vec3> positions;
+		std::vector<vec2> texture_coordinates;
+		std::vector<vec3> normals;
+		std::vector<Corner> triangle_corners;
+		uint64_t number_of_faces = 0;
+
+	};
+
+	static const char* skip_spaces(const char* cursor, const char* end) {
+
+		while (cursor < end && (*cursor == ' ' || *cursor == '\t')) { ++cursor; };
+		return cursor;
+
+	};
+
+	//the start of the next line
+	static const char* skip_line(const char* cursor, const char* end) {
+
+		const char* new_line = static_cast<const char*>(std::memchr(cursor, '\n', end - cursor));
+		return new_line ? new_line + 1 : end;
+
+	};
+
+	static bool is_end_of_line(const char* cursor, const char* end) { return cursor == end || *cursor == '\n' || *cursor == '\r' || *cursor == '#'; };
+
+	//the line of *cursor* in [*data*, *end*), only worked out for error messages
+	static size_t get_line_number(const char* data, const char* cursor) { return std::count(data, cursor, '\n') + 1; };
+
+	static const char* parse_floats(const char* data, const char* cursor, const char* end, float* values, const int& n_required, const int& n_values);
+	static const char* parse_index(const char* data, const char* cursor, const char* end, const size_t& count, int32_t& index);
+	static const char* parse_face(const char* data, const char* cursor, const char* end, Chunk& chunk);
+
+	//counts the v, vt and vn lines of *chunk* without parsing them, so every chunk knows how many attributes come before it
+	static void count_attributes(const Chunk& chunk, size_t& n_positions, size_t& n_texture_coordinates, size_t& n_normals);
+
+	//*data* is the start of the whole text, for the line numbers of error messages
+	static void parse_chunk(const char* data, Chunk& chunk);
+
+	void parse_in_parallel(const char* data, const size_t& size);
+
+};
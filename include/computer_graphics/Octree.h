@@ -0,0 +1,189 @@
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <array>
+#include <queue>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <filesystem>
+
+#include "computer_graphics/Math.h"
+#include "computer_graphics/File.h"
+#include "computer_graphics/Thread_Pool.h"
+#include "computer_graphics/Point_Cloud.h"
+#include "computer_graphics/Point_Cloud_Cache.h"
+#include "computer_graphics/COPC.h"
+
+//a Potree style level of detail octree stored on disk. Every node keeps a subsample of the points inside its cube, at most one per cell of a grid whose spacing halves with every level, and passes the rest down to its children.
+//Drawing any cut through the tree therefore shows the whole cloud, only as dense as the nodes in the cut. *build* creates the tree from a LAS file without ever holding the whole file in memory, and an *Octree* only keeps
+//the hierarchy in memory while the point data stays mapped, so nodes are paged in from disk once they are actually drawn
+class Octree {
+
+ public:
+
+	using Voxel_Key = COPC_Reader::Voxel_Key;
+
+	struct Node {
+
+		Voxel_Key key;
+		uint32_t n_points;
+
+		//offset of the positions of the node inside the point data file, its colors follow right after them
+		uint64_t offset;
+
+		//indices into *nodes*, -1 for children that dont exist
+		std::array<int32_t, 8> children;
+
+		vec3 minimum_bounds;
+		vec3 maximum_bounds;
+
+		//distance between the cells of the sampling grid of the node
+		float spacing;
+
+	};
+
+	//what *select_nodes* needs to know about the camera
+	struct View {
+
+		//transforms from the space of the points into clip space
+		mat4 model_view_projection;
+
+		//how much the model transformation scales the points
+		float model_scale;
+
+		//a22 of the projection matrix, 1 / tan(FOV / 2) for perspective and 1 / orthogonal_size for orthographic projections
+		float projection_scale;
+		bool perspective;
+		float screen_height;
+
+	};
+
+	//nodes keep at most one point per cell of a grid with this many cells along each axis of their cube
+	static constexpr uint32_t SAMPLING_GRID_RESOLUTION = 128;
+
+	//nodes holding at most this many points arent split any further
+	static constexpr uint32_t MAX_POINTS_PER_LEAF = 20000;
+	static constexpr int32_t MAX_DEPTH = 20;
+
+	//the input is counted on a grid with 2^COUNTING_GRID_LEVEL cells along each axis, which is then merged into chunks small enough to build their subtrees in memory
+	static constexpr int32_t COUNTING_GRID_LEVEL = 5;
+
+	static constexpr const char* HIERARCHY_FILE_NAME = "hierarchy.bin";
+	static constexpr const char* POINTS_FILE_NAME = "octree.bin";
+
+	//the root comes first and parents always come before their children
+	std::vector<Node> nodes;
+	uint64_t number_of_points;
+
+	//the cube of the root in openGL space
+	vec3 minimum_bounds;
+	float size;
+
+	//partitions the points of a LAS or LAZ file into an octree written to *octree_directory*. The file is read twice in batches, once to count the points on a coarse grid and once to spread them into chunk files,
+	//then every chunk builds its subtree in memory on the shared *Thread_Pool*. *host_memory_budget* bounds the batches, the buffered chunk files and the chunks being built at the same time
+	static void build(const std::filesystem::path& path_to_LASer_file, const std::filesystem::path& octree_directory, const size_t& host_memory_budget = 512 * 1024 * 1024);
+
+	//whether *octree_directory* holds an octree of the current *VERSION* built from *path_to_LASer_file* as it is now, the size, modification time and hash of the file have to match the ones
+	//the octree was built from, see *Point_Cloud_Cache::identify_source*. When the LAS file is gone the octree is still used
+	static bool exists(const std::filesystem::path& octree_directory, const std::filesystem::path& path_to_LASer_file);
+
+	//reads the hierarchy of an octree written by *build* and maps its point data
+	Octree(const std::filesystem::path& octree_directory);
+
+	const vec3* get_positions(const Node& node) const;
+	const vec3* get_colors(const Node& node) const;
+
+	//picks the nodes to draw for *view*, largest screen space error first. A node is refined into its children while its spacing covers more than *max_screen_space_error* pixels on screen,
+	//nodes outside the view frustum are skipped and the walk stops once the next node would push the points past *point_budget*. Parents always come before their children in the result
+	std::vector<uint32_t> select_nodes(const View& view, const uint64_t& point_budget, const float& max_screen_space_error) const;
+
+	Octree(const Octree&) = delete;
+	Octree& operator=(const Octree&) = delete;
+
+ private:
+
+	//raised whenever the layout or the decoding of the points changes, so older octrees are built again. 2 since the positions are decoded around the double origin of the file,
+	//3 since the header identifies the LAS file
+	static constexpr uint32_t VERSION = 3;
+
+#pragma pack(push, 1)
+	struct Hierarchy_Header {
+
+		char signature[4];
+		uint32_t version;
+		uint64_t number_of_points;
+		uint32_t number_of_nodes;
+		uint64_t source_size;
+		int64_t source_modification_time;
+		uint64_t source_hash;
+		float minimum_bounds[3];
+		float size;
+
+	};
+#pragma pack(pop)
+
+#pragma pack(push, 1)
+	struct Hierarchy_Entry {
+
+		Voxel_Key key;
+		uint64_t offset;
+		uint32_t n_points;
+
+	};
+#pragma pack(pop)
+
+	struct Point {
+
+		vec3 position;
+		vec3 color;
+
+	};
+
+	//a node built in memory, before it is written out
+	struct Built_Node {
+
+		Voxel_Key key;
+		std::vector<Point> points;
+
+	};
+
+	//a node above the chunks, sampled by every chunk below it
+	struct Sampled_Node {
+
+		std::unordered_set<uint32_t> occupied_cells;
+		std::vector<Point> points;
+
+	};
+
+	//a point of a chunk that took a cell of the node *level* above the chunk, among the points of that chunk alone
+	struct Upper_Sample {
+
+		uint32_t index;
+		int32_t level;
+		Point point;
+
+	};
+
+	Memory_Mapped_File points_file;
+
+	//the cell of *position* along each axis in the grid of *level*, clamped into the root cube
+	static std::array<int64_t, 3> get_cell(const vec3& position, const vec3& minimum_bounds, const float& size, const int32_t& level);
+
+	//the index of the sampling grid cell of *position* inside the node *key*
+	static uint32_t get_sampling_cell(const vec3& position, const vec3& minimum_bounds, const float& size, const Voxel_Key& key);
+
+	//samples *points* into the node *key*, hands the rest to its children and recurses, appending every node to *built_nodes*
+	static void build_subtree(const Voxel_Key& key, std::vector<Point>& points, const vec3& minimum_bounds, const float& size, std::vector<Built_Node>& built_nodes);
+
+	//how many pixels the spacing of *node* covers on screen at its point closest to the camera, nodes reaching behind the camera need infinite refinement
+	float compute_screen_space_error(const Node& node, const View& view) const;
+
+};
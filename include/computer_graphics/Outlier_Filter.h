@@ -0,0 +1,30 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+
+#include "computer_graphics/Math.h"
+#include "computer_graphics/Thread_Pool.h"
+#include "computer_graphics/KD_Tree.h"
+
+//statistical outlier removal: every point gets the mean distance to its nearest neighbours, and the points whose mean distance lies too far above the mean of the whole cloud are isolated returns,
+//birds or multipath noise rather than surface. The neighbours are found with a *KD_Tree* queried in parallel
+class Outlier_Filter {
+
+ public:
+
+	static constexpr uint32_t DEFAULT_NEIGHBOURS = 8;
+	static constexpr float DEFAULT_STANDARD_DEVIATIONS = 2.0f;
+
+	//removes the points whose mean distance to their *neighbours* nearest points is more than *standard_deviations* standard deviations above the mean over all points, and their colors with them.
+	//Unless null, *kept* receives the original index of every point that is left, so other per point data can follow the positions. Returns the number of points removed
+	static uint64_t remove_statistical_outliers(std::vector<vec3>& positions, std::vector<vec3>& colors, const uint32_t& neighbours = DEFAULT_NEIGHBOURS, const float& standard_deviations = DEFAULT_STANDARD_DEVIATIONS, std::vector<uint32_t>* kept = nullptr);
+
+ private:
+
+	static constexpr size_t POINTS_PER_TASK = 1 << 16;
+
+};
@@ -10,9 +10,21 @@
 #include <cstdarg>
 #include <cstdio>
 #include <functional>
+#include <memory>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstring>
+#include <cstddef>
+#include <bitset>
+#include <chrono>
 
 #include "computer_graphics/File.h"
 #include "computer_graphics/Math.h"
+#include "computer_graphics/Thread_Pool.h"
+#include "computer_graphics/LAZ.h"
 
 class Point_Cloud {
 
@@ -21,11 +33,19 @@ private:
 	std::string Public_Header_Block_Version;
 	std::string Point_Data_Record_Format;
 
-	vec3 openGL_min_position;
-	vec3 openGL_max_position;
-	vec3 openGL_center;
-	float length;
-	float scale_factor;
+	//the openGL frame, in geospatial units but openGL axis order (x, z, -y). All of it stays in double since georeferenced coordinates lose their centimetres in a float long before the center is subtracted
+	double openGL_min_position[3];
+	double openGL_max_position[3];
+	double openGL_center[3];
+	double length;
+	double scale_factor;
+
+	//what decoded points are made relative to, in the same units as *openGL_center*. It is the center of the frame unless *set_openGL_origin* moved it
+	double openGL_origin[3];
+
+	//the header quantization used to turn the raw integer X, Y and Z of a record into geospatial coordinates
+	double quantization_scale[3];
+	double quantization_offset[3];
 
 public:
 
@@ -146,7 +166,7 @@ public:
 		uint8_t point_data_record_format;
 		uint16_t point_data_record_length;
 		uint32_t number_of_point_records;
-		uint32_t number_of_points_by_return[7];
+		uint32_t number_of_points_by_return[5];
 		double X_scale_factor, Y_scale_factor, Z_scale_factor;
 		double X_offset, Y_offset, Z_offset;
 		double max_X, min_X;
@@ -183,8 +203,9 @@ public:
 		uint32_t legacy_number_of_point_by_return[5];
 		double X_scale_factor, Y_scale_factor, Z_scale_factor;
 		double X_offset, Y_offset, Z_offset;
-		double max_X, max_Y, max_Z;
-		double min_X, min_Y, min_Z;
+		double max_X, min_X;
+		double max_Y, min_Y;
+		double max_Z, min_Z;
 		uint64_t start_of_waveform_data_packet_record;
 		uint64_t start_of_first_extended_variable_length_record;
 		uint32_t number_of_extended_variable_length_records;
@@ -465,42 +486,264 @@ public:
 	};
 #pragma pack(pop)
 
+	//the VLRs directly follow the public header block, each one is this 54 byte header followed by *record_length_after_header* bytes of data
+#pragma pack(push, 1) 
+	struct Variable_Length_Record_Header {
+
+		uint16_t reserved;
+		char user_ID[16];
+		uint16_t record_ID;
+		uint16_t record_length_after_header;
+		char description[32];
+
+	};
+#pragma pack(pop)
+
+	//the EVLRs of LAS 1.4 start at *start_of_first_extended_variable_length_record*, same as a VLR header but with a 64 bit length
+#pragma pack(push, 1) 
+	struct Extended_Variable_Length_Record_Header {
+
+		uint16_t reserved;
+		char user_ID[16];
+		uint16_t record_ID;
+		uint64_t record_length_after_header;
+		char description[32];
+
+	};
+#pragma pack(pop)
+
+	//the Extra Bytes VLR (user ID "LASF_Spec", record ID 4) holds one of these 192 byte descriptors per attribute, in the same order as the attributes sit in the extra bytes of every record
+#pragma pack(push, 1) 
+	struct Extra_Bytes_Descriptor {
+
+		uint8_t reserved[2];
+		uint8_t data_type;
+		uint8_t options;
+		char name[32];
+		uint8_t unused[4];
+		uint64_t no_data[3];
+		uint64_t min[3];
+		uint64_t max[3];
+		double scale[3];
+		double offset[3];
+		char description[32];
+
+	};
+#pragma pack(pop)
+
+	//one entry of the VLR or EVLR directory, *offset_to_data* counts from the start of the file
+	struct Variable_Length_Record {
+
+		std::string user_ID;
+		uint16_t record_ID;
+		std::string description;
+		uint64_t offset_to_data;
+		uint64_t record_length;
+		bool extended;
+
+	};
+
+	//one attribute stored in the extra bytes of every record. The values of all points are copied raw and tightly packed, *size* bytes per point made of *n_elements* values of *element_size* bytes.
+	//*get* reads a value in the type it was stored with and *get_value* reads it as a double with the descriptor scale and offset applied
+	struct Extra_Bytes_Column {
+
+		std::string name;
+		std::string description;
+		uint8_t data_type;
+		uint8_t options;
+		uint8_t n_elements;
+		uint8_t element_size;
+		uint16_t offset_in_record;
+		uint16_t size;
+		double scale[3];
+		double offset[3];
+		std::vector<uint8_t> values;
+
+		static constexpr uint8_t UNDOCUMENTED_EXTRA_BYTES = 0;
+		static constexpr uint8_t UNSIGNED_CHAR = 1;
+		static constexpr uint8_t CHAR = 2;
+		static constexpr uint8_t UNSIGNED_SHORT = 3;
+		static constexpr uint8_t SHORT = 4;
+		static constexpr uint8_t UNSIGNED_LONG = 5;
+		static constexpr uint8_t LONG = 6;
+		static constexpr uint8_t UNSIGNED_LONG_LONG = 7;
+		static constexpr uint8_t LONG_LONG = 8;
+		static constexpr uint8_t FLOAT = 9;
+		static constexpr uint8_t DOUBLE = 10;
+
+		static constexpr uint8_t SCALE_IS_RELEVANT = 1 << 3;
+		static constexpr uint8_t OFFSET_IS_RELEVANT = 1 << 4;
+
+		template<typename T>
+		T get(const uint64_t& point, const uint8_t& element = 0) const {
+
+			T value;
+			std::memcpy(&value, this->values.data() + point * this->size + element * this->element_size, sizeof(T));
+			return value;
+
+		};
+
+		double get_value(const uint64_t& point, const uint8_t& element = 0) const;
+
+	};
+
+	std::vector<Variable_Length_Record> variable_length_records;
+	std::vector<Extra_Bytes_Column> extra_bytes_columns;
+
+	//when set, the memory mapped paths also copy the values of every Extra Bytes attribute into *extra_bytes_columns*, otherwise only their descriptors are read
+	bool extract_extra_bytes = false;
+
+	//decides from the attributes of a record, before it is dequantized, whether its point is kept. Rejected points are skipped by every decoding path, so they never take space in the output
+	//or on the GPU. The default filter keeps every point
+	struct Point_Filter {
+
+		//bit *c* set keeps the points of classification *c*. Formats 0 to 5 only have 5 bits of classification, their synthetic, key-point and withheld flags are ignored
+		std::bitset<256> classifications;
+
+		static constexpr uint8_t ALL_RETURNS = 0;
+		static constexpr uint8_t FIRST_RETURNS = 1;
+		static constexpr uint8_t LAST_RETURNS = 2;
+		uint8_t RETURNS = ALL_RETURNS;
+
+		uint16_t minimum_intensity = 0;
+		uint16_t maximum_intensity = UINT16_MAX;
+
+		Point_Filter() { this->classifications.set(); };
+
+		void keep_only_classifications(const std::vector<uint8_t>& kept_classifications) {
+
+			this->classifications.reset();
+			for (const uint8_t& classification : kept_classifications) { this->classifications.set(classification); };
+
+		};
+
+		bool is_active() const { return !this->classifications.all() || this->RETURNS != ALL_RETURNS || this->minimum_intensity != 0 || this->maximum_intensity != UINT16_MAX; };
+
+		//the return fields are bit fields, so they are read from the byte after the intensity, which is where they sit in every format
+		template<typename Point_Data_Record_Format_X>
+		bool accepts(const char* record) const {
+
+			constexpr bool extended_format = requires(Point_Data_Record_Format_X point_data_record) { point_data_record.classification_flags; };
+
+			uint16_t intensity;
+			std::memcpy(&intensity, record + offsetof(Point_Data_Record_Format_X, intensity), sizeof(uint16_t));
+			if (intensity < this->minimum_intensity || intensity > this->maximum_intensity) { return false; };
+
+			uint8_t classification = static_cast<uint8_t>(record[offsetof(Point_Data_Record_Format_X, classification)]);
+			if (!this->classifications.test(extended_format ? classification : classification & 0x1F)) { return false; };
+
+			if (this->RETURNS != ALL_RETURNS) {
+
+				const uint8_t returns = static_cast<uint8_t>(record[offsetof(Point_Data_Record_Format_X, intensity) + sizeof(uint16_t)]);
+				const uint8_t return_number = extended_format ? returns & 0x0F : returns & 0x07;
+				const uint8_t number_of_returns = extended_format ? returns >> 4 : (returns >> 3) & 0x07;
+				if (this->RETURNS == FIRST_RETURNS && return_number > 1) { return false; };
+				if (this->RETURNS == LAST_RETURNS && return_number < number_of_returns) { return false; };
+
+			};
+
+			return true;
+
+		};
+
+		//the same for a record whose format is only known at run time
+		bool accepts(const char* record, const uint8_t& point_data_record_format) const;
+
+	};
+
+	//picked up by every decoder of this instance, including those created before it was set
+	Point_Filter point_filter;
+
+	//the attributes of the points besides their position and color, one array per attribute so each can be uploaded as its own compact vertex buffer for shaders to color the points by
+	struct Point_Attributes {
+
+		std::vector<uint16_t> intensities;
+		std::vector<uint8_t> classifications;
+
+		//the return number in the low 4 bits and the number of returns in the high 4 bits, which is how formats 6 to 10 store them
+		std::vector<uint8_t> returns;
+
+		//empty when the format has no GPS time
+		std::vector<double> GPS_times;
+
+		uint64_t size() const { return this->intensities.size(); };
+		bool empty() const { return this->intensities.empty(); };
+
+		void resize(const uint64_t& n_points, const bool& has_GPS_times);
+		void shrink_to_fit();
+
+		//copies *n_points* attributes from *source* starting at *first_source_point* over the ones starting at *first_point*, the ranges may overlap when *source* is this instance
+		void copy(const Point_Attributes& source, const uint64_t& first_source_point, const uint64_t& first_point, const uint64_t& n_points);
+
+		//the attributes of the points at *indices*, in their order
+		Point_Attributes gather(const std::vector<uint32_t>& indices) const;
+
+	};
+
+	//when set, the memory mapped paths also keep the *point_attributes* of the decoded points
+	bool extract_point_attributes = false;
+	Point_Attributes point_attributes;
+
+	static bool has_GPS_time(const uint8_t& point_data_record_format) { return point_data_record_format != 0 && point_data_record_format != 2; };
+
+	//copies the attributes of the *n_records* records at *records* into *point_attributes* from the point *first_value* on, skipping the records *point_filter* rejects like *decode* does
+	template<typename Point_Data_Record_Format_X>
+	void extract_point_attributes_columns(const char* records, const uint64_t& point_data_record_length, const uint64_t& n_records, const uint64_t& first_value) {
+
+		constexpr bool extended_format = requires(Point_Data_Record_Format_X point_data_record) { point_data_record.classification_flags; };
+		constexpr bool has_GPS_time = requires(Point_Data_Record_Format_X point_data_record) { point_data_record.GPS_time; };
+		const bool filtering = this->point_filter.is_active();
+
+		const char* record = records;
+		uint64_t value = first_value;
+		for (uint64_t i = 0; i < n_records; i++, record += point_data_record_length) {
+
+			if (filtering && !this->point_filter.accepts<Point_Data_Record_Format_X>(record)) { continue; };
+
+			std::memcpy(&this->point_attributes.intensities[value], record + offsetof(Point_Data_Record_Format_X, intensity), sizeof(uint16_t));
+
+			const uint8_t classification = static_cast<uint8_t>(record[offsetof(Point_Data_Record_Format_X, classification)]);
+			this->point_attributes.classifications[value] = extended_format ? classification : classification & 0x1F;
+
+			const uint8_t returns = static_cast<uint8_t>(record[offsetof(Point_Data_Record_Format_X, intensity) + sizeof(uint16_t)]);
+			this->point_attributes.returns[value] = extended_format ? returns : (returns & 0x07) | (((returns >> 3) & 0x07) << 4);
+
+			if constexpr (has_GPS_time) { std::memcpy(&this->point_attributes.GPS_times[value], record + offsetof(Point_Data_Record_Format_X, GPS_time), sizeof(double)); };
+			value++;
+
+		};
+
+	};
+
+	void extract_point_attributes_columns(const char* records, const uint64_t& point_data_record_length, const uint8_t& point_data_record_format, const uint64_t& n_records, const uint64_t& first_value);
+
 	template<typename Public_Header_Block_Version_X_X>
 	void extract_members_data(const Public_Header_Block_Version_X_X& header) {
 
 		this->Public_Header_Block_Version = std::to_string(header.version_major) + "." + std::to_string(header.version_minor);
 		this->Point_Data_Record_Format = std::to_string(header.point_data_record_format);
 
-		this->openGL_min_position = vec3(header.min_X, header.min_Y, header.min_Z);
-		this->openGL_min_position = vec3(this->openGL_min_position.x, this->openGL_min_position.z, -this->openGL_min_position.y);
-
-		this->openGL_max_position = vec3(header.max_X, header.max_Y, header.max_Z);
-		this->openGL_max_position = vec3(this->openGL_max_position.x, this->openGL_max_position.z, -this->openGL_max_position.y);
+		const double minimum_bounds[3] = { header.min_X, header.min_Y, header.min_Z };
+		const double maximum_bounds[3] = { header.max_X, header.max_Y, header.max_Z };
+		this->set_openGL_frame(minimum_bounds, maximum_bounds);
 
-		this->openGL_center = (this->openGL_min_position + this->openGL_max_position) * 0.5f;
-		this->length = (this->openGL_min_position - this->openGL_max_position).magnitude();
-		this->scale_factor = 100.0f / this->length;
+		this->quantization_scale[0] = header.X_scale_factor; this->quantization_scale[1] = header.Y_scale_factor; this->quantization_scale[2] = header.Z_scale_factor;
+		this->quantization_offset[0] = header.X_offset; this->quantization_offset[1] = header.Y_offset; this->quantization_offset[2] = header.Z_offset;
 
 	};
 
-	template<typename Public_Header_Block_Version_X_X, typename Point_Data_Record_Format_X>
-	vec3 compute_geospatial_point_coordinates(const Public_Header_Block_Version_X_X& header, const Point_Data_Record_Format_X& point_data_record) {
+	//the geospatial position of a point relative to *openGL_origin* and scaled down, worked out in double and only rounded to float at the very end.
+	//Since the LAS geospace takes Z as up whilst openGL takes Y(and Y inverted at that), we need to switch them. The inverted axis is written as (y + origin) * -scale so the vectorized kernel can do the same operations
+	vec3 compute_openGL_point_coordinates(const double& x, const double& y, const double& z) const {
 
-		float x = (point_data_record.X * header.X_scale_factor) + header.X_offset;
-		float y = (point_data_record.Y * header.Y_scale_factor) + header.Y_offset;
-		float z = (point_data_record.Z * header.Z_scale_factor) + header.Z_offset;
-
-		return vec3(x, y, z);
+		return vec3((x - this->openGL_origin[0]) * this->scale_factor, (z - this->openGL_origin[1]) * this->scale_factor, (y + this->openGL_origin[2]) * -this->scale_factor);
 
 	};
 
 	template<typename Public_Header_Block_Version_X_X, typename Point_Data_Record_Format_X>
 	vec3 compute_openGL_point_coordinates(const Public_Header_Block_Version_X_X& header, const Point_Data_Record_Format_X& point_data_record) {
 
-		vec3 geospatial_coordinates = this->compute_geospatial_point_coordinates(header, point_data_record);
-
-		//since the LAS geospace takes Z as up whilst openGL takes Y(and Y inverted at that), we need to switch them.
-		return (vec3(geospatial_coordinates.x, geospatial_coordinates.z, -geospatial_coordinates.y) - this->openGL_center) * this->scale_factor;//move to origin and scale down
+		return this->compute_openGL_point_coordinates((point_data_record.X * header.X_scale_factor) + header.X_offset, (point_data_record.Y * header.Y_scale_factor) + header.Y_offset, (point_data_record.Z * header.Z_scale_factor) + header.Z_offset);
 
 	};
 
@@ -511,30 +754,586 @@ public:
 
 	};
 
+	//returns whether *point_filter* keeps the point, *position* and *color* are written either way
 	template<typename Public_Header_Block_Version_X_X>
-	void read_point_and_extract_openGL_attributes(const Public_Header_Block_Version_X_X& header, std::ifstream& data, vec3& position, vec3& color) {
+	bool read_point_and_extract_openGL_attributes(const Public_Header_Block_Version_X_X& header, std::ifstream& data, vec3& position, vec3& color) {
 
+		//records can be longer than their format because of extra bytes, those are skipped so the next read starts on the next record
+		const std::streamsize n_extra_bytes = static_cast<std::streamsize>(header.point_data_record_length) - static_cast<std::streamsize>(get_point_data_record_size(header.point_data_record_format));
+		if (n_extra_bytes < 0) { std::cerr << "ERROR: point data record length " << header.point_data_record_length << " is smaller than its format!\n"; data.clear(); data.close(); exit(EXIT_FAILURE); };
+
+		bool accepted = true;
 		switch (header.point_data_record_format) {
 
-		    case 0: { Point_Data_Record_Format_0 point_data_record; data.read(reinterpret_cast<char*>(&point_data_record), sizeof(Point_Data_Record_Format_0)); position = std::move(compute_openGL_point_coordinates(header, point_data_record)); color = std::move(vec3(1.0f, 1.0f, 1.0f)); break; };
-			case 1: { Point_Data_Record_Format_1 point_data_record; data.read(reinterpret_cast<char*>(&point_data_record), sizeof(Point_Data_Record_Format_1)); position = std::move(compute_openGL_point_coordinates(header, point_data_record)); color = std::move(vec3(1.0f, 1.0f, 1.0f)); break; };
-			case 2: { Point_Data_Record_Format_2 point_data_record; data.read(reinterpret_cast<char*>(&point_data_record), sizeof(Point_Data_Record_Format_2)); position = std::move(compute_openGL_point_coordinates(header, point_data_record)); color = std::move(compute_openGL_point_colors(point_data_record)); break; };
-			case 3: { Point_Data_Record_Format_3 point_data_record; data.read(reinterpret_cast<char*>(&point_data_record), sizeof(Point_Data_Record_Format_3)); position = std::move(compute_openGL_point_coordinates(header, point_data_record)); color = std::move(compute_openGL_point_colors(point_data_record)); break; };
-			case 4: { Point_Data_Record_Format_4 point_data_record; data.read(reinterpret_cast<char*>(&point_data_record), sizeof(Point_Data_Record_Format_4)); position = std::move(compute_openGL_point_coordinates(header, point_data_record)); color = std::move(vec3(1.0f, 1.0f, 1.0f)); break; };
-			case 5: { Point_Data_Record_Format_5 point_data_record; data.read(reinterpret_cast<char*>(&point_data_record), sizeof(Point_Data_Record_Format_5)); position = std::move(compute_openGL_point_coordinates(header, point_data_record)); color = std::move(compute_openGL_point_colors(point_data_record)); break; };
-			case 6: { Point_Data_Record_Format_6 point_data_record; data.read(reinterpret_cast<char*>(&point_data_record), sizeof(Point_Data_Record_Format_6)); position = std::move(compute_openGL_point_coordinates(header, point_data_record)); color = std::move(vec3(1.0f, 1.0f, 1.0f)); break; };
-			case 7: { Point_Data_Record_Format_7 point_data_record; data.read(reinterpret_cast<char*>(&point_data_record), sizeof(Point_Data_Record_Format_7)); position = std::move(compute_openGL_point_coordinates(header, point_data_record)); color = std::move(compute_openGL_point_colors(point_data_record)); break; };
-			case 8: { Point_Data_Record_Format_8 point_data_record; data.read(reinterpret_cast<char*>(&point_data_record), sizeof(Point_Data_Record_Format_8)); position = std::move(compute_openGL_point_coordinates(header, point_data_record)); color = std::move(compute_openGL_point_colors(point_data_record)); break; };
-			case 9: { Point_Data_Record_Format_9 point_data_record; data.read(reinterpret_cast<char*>(&point_data_record), sizeof(Point_Data_Record_Format_9)); position = std::move(compute_openGL_point_coordinates(header, point_data_record)); color = std::move(vec3(1.0f, 1.0f, 1.0f)); break; };
-			case 10: { Point_Data_Record_Format_10 point_data_record; data.read(reinterpret_cast<char*>(&point_data_record), sizeof(Point_Data_Record_Format_10)); position = std::move(compute_openGL_point_coordinates(header, point_data_record)); color = std::move(compute_openGL_point_colors(point_data_record)); break; };
+		    case 0: { Point_Data_Record_Format_0 point_data_record; data.read(reinterpret_cast<char*>(&point_data_record), sizeof(Point_Data_Record_Format_0)); accepted = this->point_filter.accepts<Point_Data_Record_Format_0>(reinterpret_cast<const char*>(&point_data_record)); position = std::move(compute_openGL_point_coordinates(header, point_data_record)); color = std::move(vec3(1.0f, 1.0f, 1.0f)); break; };
+			case 1: { Point_Data_Record_Format_1 point_data_record; data.read(reinterpret_cast<char*>(&point_data_record), sizeof(Point_Data_Record_Format_1)); accepted = this->point_filter.accepts<Point_Data_Record_Format_1>(reinterpret_cast<const char*>(&point_data_record)); position = std::move(compute_openGL_point_coordinates(header, point_data_record)); color = std::move(vec3(1.0f, 1.0f, 1.0f)); break; };
+			case 2: { Point_Data_Record_Format_2 point_data_record; data.read(reinterpret_cast<char*>(&point_data_record), sizeof(Point_Data_Record_Format_2)); accepted = this->point_filter.accepts<Point_Data_Record_Format_2>(reinterpret_cast<const char*>(&point_data_record)); position = std::move(compute_openGL_point_coordinates(header, point_data_record)); color = std::move(compute_openGL_point_colors(point_data_record)); break; };
+			case 3: { Point_Data_Record_Format_3 point_data_record; data.read(reinterpret_cast<char*>(&point_data_record), sizeof(Point_Data_Record_Format_3)); accepted = this->point_filter.accepts<Point_Data_Record_Format_3>(reinterpret_cast<const char*>(&point_data_record)); position = std::move(compute_openGL_point_coordinates(header, point_data_record)); color = std::move(compute_openGL_point_colors(point_data_record)); break; };
+			case 4: { Point_Data_Record_Format_4 point_data_record; data.read(reinterpret_cast<char*>(&point_data_record), sizeof(Point_Data_Record_Format_4)); accepted = this->point_filter.accepts<Point_Data_Record_Format_4>(reinterpret_cast<const char*>(&point_data_record)); position = std::move(compute_openGL_point_coordinates(header, point_data_record)); color = std::move(vec3(1.0f, 1.0f, 1.0f)); break; };
+			case 5: { Point_Data_Record_Format_5 point_data_record; data.read(reinterpret_cast<char*>(&point_data_record), sizeof(Point_Data_Record_Format_5)); accepted = this->point_filter.accepts<Point_Data_Record_Format_5>(reinterpret_cast<const char*>(&point_data_record)); position = std::move(compute_openGL_point_coordinates(header, point_data_record)); color = std::move(compute_openGL_point_colors(point_data_record)); break; };
+			case 6: { Point_Data_Record_Format_6 point_data_record; data.read(reinterpret_cast<char*>(&point_data_record), sizeof(Point_Data_Record_Format_6)); accepted = this->point_filter.accepts<Point_Data_Record_Format_6>(reinterpret_cast<const char*>(&point_data_record)); position = std::move(compute_openGL_point_coordinates(header, point_data_record)); color = std::move(vec3(1.0f, 1.0f, 1.0f)); break; };
+			case 7: { Point_Data_Record_Format_7 point_data_record; data.read(reinterpret_cast<char*>(&point_data_record), sizeof(Point_Data_Record_Format_7)); accepted = this->point_filter.accepts<Point_Data_Record_Format_7>(reinterpret_cast<const char*>(&point_data_record)); position = std::move(compute_openGL_point_coordinates(header, point_data_record)); color = std::move(compute_openGL_point_colors(point_data_record)); break; };
+			case 8: { Point_Data_Record_Format_8 point_data_record; data.read(reinterpret_cast<char*>(&point_data_record), sizeof(Point_Data_Record_Format_8)); accepted = this->point_filter.accepts<Point_Data_Record_Format_8>(reinterpret_cast<const char*>(&point_data_record)); position = std::move(compute_openGL_point_coordinates(header, point_data_record)); color = std::move(compute_openGL_point_colors(point_data_record)); break; };
+			case 9: { Point_Data_Record_Format_9 point_data_record; data.read(reinterpret_cast<char*>(&point_data_record), sizeof(Point_Data_Record_Format_9)); accepted = this->point_filter.accepts<Point_Data_Record_Format_9>(reinterpret_cast<const char*>(&point_data_record)); position = std::move(compute_openGL_point_coordinates(header, point_data_record)); color = std::move(vec3(1.0f, 1.0f, 1.0f)); break; };
+			case 10: { Point_Data_Record_Format_10 point_data_record; data.read(reinterpret_cast<char*>(&point_data_record), sizeof(Point_Data_Record_Format_10)); accepted = this->point_filter.accepts<Point_Data_Record_Format_10>(reinterpret_cast<const char*>(&point_data_record)); position = std::move(compute_openGL_point_coordinates(header, point_data_record)); color = std::move(compute_openGL_point_colors(point_data_record)); break; };
 			default: std::cerr << "ERROR: unsupported Data Record Format " << static_cast<int>(header.point_data_record_format) << "\n"; data.clear(); data.close(); exit(EXIT_FAILURE);
 
 		};
+		if (n_extra_bytes > 0) data.ignore(n_extra_bytes);
+		return accepted;
+
+	};
+
+	//number of records gathered from the point data block before they are handed to the vectorized dequantization kernel
+	static constexpr size_t DEQUANTIZATION_BATCH_SIZE = 256;
+
+	//converts a batch of raw record integers into openGL space in one pass: int32 -> double with the header scale and offset, the LAS Z-up to openGL Y-up swizzle,
+	//the origin subtraction and the scale down, all in double and then rounded to float, plus the uint16 colors to float. Uses AVX2 or SSE2 depending on what the compiler targets and a scalar loop otherwise.
+	//Every lane does exactly the same operations as *compute_openGL_point_coordinates* and *compute_openGL_point_colors*, so the results are bit identical. *red* being null means the format has no colors
+	void dequantize_openGL_points_attributes(const int32_t* X, const int32_t* Y, const int32_t* Z, const uint16_t* red, const uint16_t* green, const uint16_t* blue, const size_t& n_points, vec3* positions, vec3* colors) const;
+
+	//decodes the records [first_point, last_point) directly from the memory holding the point data block into *positions* and *colors*, which point to the slot of *first_point*.
+	//The fields we need are gathered batch by batch into small structure of arrays buffers on the stack and then dequantized by the vectorized kernel, no stream calls or heap allocations are involved
+	template<typename Public_Header_Block_Version_X_X, typename Point_Data_Record_Format_X>
+	uint64_t decode_points_and_extract_openGL_attributes(const Public_Header_Block_Version_X_X& header, const char* point_data, const uint64_t& first_point, const uint64_t& last_point, vec3* positions, vec3* colors) {
+
+		constexpr bool has_colors = requires(Point_Data_Record_Format_X point_data_record) { point_data_record.red; };
+		const bool filtering = this->point_filter.is_active();
+
+		alignas(32) int32_t X[DEQUANTIZATION_BATCH_SIZE], Y[DEQUANTIZATION_BATCH_SIZE], Z[DEQUANTIZATION_BATCH_SIZE];
+		alignas(32) uint16_t red[DEQUANTIZATION_BATCH_SIZE], green[DEQUANTIZATION_BATCH_SIZE], blue[DEQUANTIZATION_BATCH_SIZE];
+
+		//the stride comes from the header since records may carry extra bytes after the fields of their format
+		const uint64_t record_length = header.point_data_record_length;
+		const char* record = point_data + first_point * record_length;
+		uint64_t point = first_point;
+		uint64_t n_kept_points = 0;
+		while (point < last_point) {
+
+			//rejected records are skipped while gathering, so every batch is full of kept points
+			size_t n_points = 0;
+			for (; point < last_point && n_points < DEQUANTIZATION_BATCH_SIZE; point++, record += record_length) {
+
+				if (filtering && !this->point_filter.accepts<Point_Data_Record_Format_X>(record)) { continue; };
+
+				//memcpy of single fields is lowered to plain unaligned loads, so this is still a zero-copy read of the mapped bytes
+				std::memcpy(&X[n_points], record + offsetof(Point_Data_Record_Format_X, X), sizeof(int32_t));
+				std::memcpy(&Y[n_points], record + offsetof(Point_Data_Record_Format_X, Y), sizeof(int32_t));
+				std::memcpy(&Z[n_points], record + offsetof(Point_Data_Record_Format_X, Z), sizeof(int32_t));
+				if constexpr (has_colors) {
+
+					std::memcpy(&red[n_points], record + offsetof(Point_Data_Record_Format_X, red), sizeof(uint16_t));
+					std::memcpy(&green[n_points], record + offsetof(Point_Data_Record_Format_X, green), sizeof(uint16_t));
+					std::memcpy(&blue[n_points], record + offsetof(Point_Data_Record_Format_X, blue), sizeof(uint16_t));
+
+				};
+				n_points++;
+
+			};
+
+			this->dequantize_openGL_points_attributes(X, Y, Z, has_colors ? red : nullptr, green, blue, n_points, positions + n_kept_points, colors + n_kept_points);
+			n_kept_points += n_points;
+
+		};
+
+		return n_kept_points;
+
+	};
+
+	//the data record format is resolved once for the whole range instead of once per point. The kept points are written one after the other from *positions* and *colors*, their number is returned
+	template<typename Public_Header_Block_Version_X_X>
+	uint64_t decode_points_and_extract_openGL_attributes(const Public_Header_Block_Version_X_X& header, const char* point_data, const uint64_t& first_point, const uint64_t& last_point, vec3* positions, vec3* colors) {
+
+		switch (header.point_data_record_format) {
+
+			case 0: { return decode_points_and_extract_openGL_attributes<Public_Header_Block_Version_X_X, Point_Data_Record_Format_0>(header, point_data, first_point, last_point, positions, colors); };
+			case 1: { return decode_points_and_extract_openGL_attributes<Public_Header_Block_Version_X_X, Point_Data_Record_Format_1>(header, point_data, first_point, last_point, positions, colors); };
+			case 2: { return decode_points_and_extract_openGL_attributes<Public_Header_Block_Version_X_X, Point_Data_Record_Format_2>(header, point_data, first_point, last_point, positions, colors); };
+			case 3: { return decode_points_and_extract_openGL_attributes<Public_Header_Block_Version_X_X, Point_Data_Record_Format_3>(header, point_data, first_point, last_point, positions, colors); };
+			case 4: { return decode_points_and_extract_openGL_attributes<Public_Header_Block_Version_X_X, Point_Data_Record_Format_4>(header, point_data, first_point, last_point, positions, colors); };
+			case 5: { return decode_points_and_extract_openGL_attributes<Public_Header_Block_Version_X_X, Point_Data_Record_Format_5>(header, point_data, first_point, last_point, positions, colors); };
+			case 6: { return decode_points_and_extract_openGL_attributes<Public_Header_Block_Version_X_X, Point_Data_Record_Format_6>(header, point_data, first_point, last_point, positions, colors); };
+			case 7: { return decode_points_and_extract_openGL_attributes<Public_Header_Block_Version_X_X, Point_Data_Record_Format_7>(header, point_data, first_point, last_point, positions, colors); };
+			case 8: { return decode_points_and_extract_openGL_attributes<Public_Header_Block_Version_X_X, Point_Data_Record_Format_8>(header, point_data, first_point, last_point, positions, colors); };
+			case 9: { return decode_points_and_extract_openGL_attributes<Public_Header_Block_Version_X_X, Point_Data_Record_Format_9>(header, point_data, first_point, last_point, positions, colors); };
+			case 10: { return decode_points_and_extract_openGL_attributes<Public_Header_Block_Version_X_X, Point_Data_Record_Format_10>(header, point_data, first_point, last_point, positions, colors); };
+			default: std::cerr << "ERROR: unsupported Data Record Format " << static_cast<int>(header.point_data_record_format) << "\n"; exit(EXIT_FAILURE);
+
+		};
+
+	};
+
+	static uint64_t get_point_data_record_size(const uint8_t& point_data_record_format) {
+
+		switch (point_data_record_format) {
+
+			case 0: return sizeof(Point_Data_Record_Format_0);
+			case 1: return sizeof(Point_Data_Record_Format_1);
+			case 2: return sizeof(Point_Data_Record_Format_2);
+			case 3: return sizeof(Point_Data_Record_Format_3);
+			case 4: return sizeof(Point_Data_Record_Format_4);
+			case 5: return sizeof(Point_Data_Record_Format_5);
+			case 6: return sizeof(Point_Data_Record_Format_6);
+			case 7: return sizeof(Point_Data_Record_Format_7);
+			case 8: return sizeof(Point_Data_Record_Format_8);
+			case 9: return sizeof(Point_Data_Record_Format_9);
+			case 10: return sizeof(Point_Data_Record_Format_10);
+			default: std::cerr << "ERROR: unsupported Data Record Format " << static_cast<int>(point_data_record_format) << "\n"; exit(EXIT_FAILURE);
+
+		};
+
+	};
+
+	//number of records a worker decodes at once in the multithreaded path. Every chunk writes to its own disjoint slice of the pre-sized output vectors
+	static constexpr uint64_t POINTS_PER_DECODING_CHUNK = 65536;
+
+	//LAZ files flag their compression in the two high bits of the point data record format, the format itself stays in the low bits
+	static constexpr uint8_t COMPRESSED_POINT_DATA_RECORD_FORMAT_BITS = 0xC0;
+
+	//copies the header out of the mapped file and strips the compression bits from its point data record format, so compressed and uncompressed files share the same decoding
+	template<typename Public_Header_Block_Version_X_X>
+	Public_Header_Block_Version_X_X read_header_from_memory(const Memory_Mapped_File& file) {
+
+		Public_Header_Block_Version_X_X header;
+		if (file.size < sizeof(Public_Header_Block_Version_X_X)) { std::cerr << "ERROR: failed to read LAS header!\n"; exit(EXIT_FAILURE); };
+		std::memcpy(&header, file.data, sizeof(Public_Header_Block_Version_X_X));
+		if (header.header_size != sizeof(header)) { std::cerr << "ERROR: size of header was incorrect! Current size: " << static_cast<int>(header.header_size) << ", should be: " << sizeof(header) << "\n"; exit(EXIT_FAILURE); };
+
+		header.point_data_record_format &= ~COMPRESSED_POINT_DATA_RECORD_FORMAT_BITS;
+		if (header.point_data_record_length < get_point_data_record_size(header.point_data_record_format)) { std::cerr << "ERROR: point data record length " << header.point_data_record_length << " is smaller than its format!\n"; exit(EXIT_FAILURE); };
+
+		return header;
+
+	};
+
+	static std::string fixed_length_string(const char* characters, const size_t& max_length) {
+
+		return std::string(characters, strnlen(characters, max_length));
+
+	};
+
+	//walks the VLRs after the public header block and, for LAS 1.4, the EVLRs after the point data. Records that would run past the end of the file end the walk with a warning instead of failing the load
+	template<typename Public_Header_Block_Version_X_X>
+	void read_variable_length_records(const Public_Header_Block_Version_X_X& header, const Memory_Mapped_File& file) {
+
+		this->variable_length_records.clear();
+
+		uint64_t offset = header.header_size;
+		for (uint32_t i = 0; i < header.number_of_variable_length_records; i++) {
+
+			Variable_Length_Record_Header record_header;
+			if (offset + sizeof(record_header) > file.size) { std::cerr << "WARNING: VLR " << i << " exceeds the file size, ignoring the remaining VLRs!\n"; break; };
+			std::memcpy(&record_header, file.data + offset, sizeof(record_header));
+
+			Variable_Length_Record record = { fixed_length_string(record_header.user_ID, 16), record_header.record_ID, fixed_length_string(record_header.description, 32), offset + sizeof(record_header), record_header.record_length_after_header, false };
+			if (record.record_length > file.size - record.offset_to_data) { std::cerr << "WARNING: VLR " << i << " exceeds the file size, ignoring the remaining VLRs!\n"; break; };
+
+			this->variable_length_records.push_back(std::move(record));
+			offset += sizeof(record_header) + record_header.record_length_after_header;
+
+		};
+
+		if constexpr (requires { header.number_of_extended_variable_length_records; }) {
+
+			offset = header.start_of_first_extended_variable_length_record;
+			for (uint32_t i = 0; i < header.number_of_extended_variable_length_records; i++) {
+
+				Extended_Variable_Length_Record_Header record_header;
+				if (offset > file.size || sizeof(record_header) > file.size - offset) { std::cerr << "WARNING: EVLR " << i << " exceeds the file size, ignoring the remaining EVLRs!\n"; break; };
+				std::memcpy(&record_header, file.data + offset, sizeof(record_header));
+
+				Variable_Length_Record record = { fixed_length_string(record_header.user_ID, 16), record_header.record_ID, fixed_length_string(record_header.description, 32), offset + sizeof(record_header), record_header.record_length_after_header, true };
+				if (record.record_length > file.size - record.offset_to_data) { std::cerr << "WARNING: EVLR " << i << " exceeds the file size, ignoring the remaining EVLRs!\n"; break; };
+
+				this->variable_length_records.push_back(std::move(record));
+				offset += sizeof(record_header) + record_header.record_length_after_header;
+
+			};
+
+		};
+
+	};
+
+	//turns the descriptors of the Extra Bytes VLR, if the file has one, into *extra_bytes_columns* without values. Attributes that dont fit inside the extra bytes of a record are dropped with a warning
+	void read_extra_bytes_descriptors(const Memory_Mapped_File& file, const uint64_t& point_data_record_size, const uint64_t& point_data_record_length);
+
+	//copies the extra bytes of the *n_records* records at *records* into the values of every column from the value *first_value* on, skipping the records *point_filter* rejects
+	//so the values line up with the decoded points. The columns must already be sized for all points
+	void extract_extra_bytes_columns(const char* records, const uint64_t& point_data_record_length, const uint8_t& point_data_record_format, const uint64_t& n_records, const uint64_t& first_value);
+
+	//everything needed to decode any range of records of a mapped LAS file into openGL space, independent of the header version
+	struct Points_Decoder {
+
+		uint64_t number_of_point_records;
+		uint64_t offset_to_point_data;
+		uint64_t point_data_record_length;
+		uint8_t point_data_record_format;
+
+		//ranges handed to *decode* should start on a multiple of this. For LAZ files it is the LASzip chunk size, since every range decompresses the chunks it touches from their start
+		uint64_t points_per_chunk;
+
+		//null for uncompressed files
+		std::shared_ptr<const LAZ_Decoder> LAZ_decoder;
+
+		//writes the points of the records [first_point, last_point) that pass the *point_filter* of the cloud one after the other and returns their number
+		std::function<uint64_t(const uint64_t& first_point, const uint64_t& last_point, vec3* positions, vec3* colors)> decode;
+
+		//copies the Extra Bytes values when *extract_extra_bytes* is set and the *point_attributes* when *extract_point_attributes* is set. The values of the kept records go to the slots from *first_point* on,
+		//the same slots *decode* fills when it is given the positions of *first_point*. Null for LAZ files, whose *decode* does both for the records it decompresses
+		std::function<void(const uint64_t& first_point, const uint64_t& last_point)> decode_attributes;
+
+		//file offset and size of the bytes holding the records [first_point, last_point)
+		std::pair<uint64_t, uint64_t> get_byte_range(const uint64_t& first_point, const uint64_t& last_point) const {
+
+			if (!this->LAZ_decoder) { return { this->offset_to_point_data + first_point * this->point_data_record_length, (last_point - first_point) * this->point_data_record_length }; };
+
+			const uint64_t first_byte = this->LAZ_decoder->chunk_offsets[this->LAZ_decoder->get_chunk_of_point(first_point)];
+			const uint64_t last_byte = this->LAZ_decoder->chunk_offsets[this->LAZ_decoder->get_chunk_of_point(last_point - 1) + 1];
+			return { first_byte, last_byte - first_byte };
+
+		};
+
+	};
+
+	//decompresses the records [first_point, last_point) of a LAZ file one chunk at a time into a buffer, which then goes through the same decoding as the mapped records of a LAS file
+	template<typename Public_Header_Block_Version_X_X>
+	uint64_t decompress_points_and_extract_openGL_attributes(const Public_Header_Block_Version_X_X& header, const LAZ_Decoder& LAZ_decoder, uint64_t first_point, const uint64_t& last_point, vec3* positions, vec3* colors) {
+
+		const uint64_t record_length = header.point_data_record_length;
+		const uint64_t first_value = first_point;
+		uint64_t n_kept_points = 0;
+		std::vector<char> records;
+		while (first_point < last_point) {
+
+			const uint64_t chunk_last_point = std::min(last_point, LAZ_decoder.chunk_first_points[LAZ_decoder.get_chunk_of_point(first_point) + 1]);
+			const uint64_t n_points = chunk_last_point - first_point;
+			records.resize(n_points * record_length);
+			LAZ_decoder.decompress(first_point, chunk_last_point, records.data());
+
+			const uint64_t n_chunk_kept_points = this->decode_points_and_extract_openGL_attributes(header, records.data(), 0, n_points, positions + n_kept_points, colors + n_kept_points);
+			if (this->extract_extra_bytes) { this->extract_extra_bytes_columns(records.data(), record_length, header.point_data_record_format, n_points, first_value + n_kept_points); };
+			if (this->extract_point_attributes) { this->extract_point_attributes_columns(records.data(), record_length, header.point_data_record_format, n_points, first_value + n_kept_points); };
+
+			n_kept_points += n_chunk_kept_points;
+			first_point = chunk_last_point;
+
+		};
+
+		return n_kept_points;
+
+	};
+
+	template<typename Public_Header_Block_Version_X_X>
+	Points_Decoder create_openGL_points_decoder(const Memory_Mapped_File& file) {
+
+		Public_Header_Block_Version_X_X header = this->read_header_from_memory<Public_Header_Block_Version_X_X>(file);
+		this->extract_members_data(header);
+		this->read_variable_length_records(header, file);
+		this->read_extra_bytes_descriptors(file, get_point_data_record_size(header.point_data_record_format), header.point_data_record_length);
+
+		const bool compressed = static_cast<uint8_t>(file.data[offsetof(Public_Header_Block_Version_X_X, point_data_record_format)]) & COMPRESSED_POINT_DATA_RECORD_FORMAT_BITS;
+		auto laszip_record = std::find_if(this->variable_length_records.begin(), this->variable_length_records.end(), [](const Variable_Length_Record& record) { return record.user_ID == "laszip encoded" && record.record_ID == 22204; });
+		if (compressed && laszip_record == this->variable_length_records.end()) { std::cerr << "ERROR: point data is compressed but the file has no LASzip VLR!\n"; exit(EXIT_FAILURE); };
+
+		const uint64_t point_data_record_length = header.point_data_record_length;
+		if (compressed) {
+
+			std::shared_ptr<const LAZ_Decoder> LAZ_decoder = std::make_shared<LAZ_Decoder>(file.data, file.size, file.data + laszip_record->offset_to_data, laszip_record->record_length, header.offset_to_point_data, header.number_of_point_records, header.point_data_record_length);
+
+			//ranges starting inside a chunk have to decompress it from its start, so with variable chunks ranges are as long as the largest chunk, which keeps every chunk split across at most 2 ranges
+			uint64_t points_per_chunk = LAZ_decoder->chunk_size;
+			if (LAZ_decoder->chunk_size == LAZ_Decoder::VARIABLE_CHUNK_SIZE) {
+
+				points_per_chunk = 1;
+				for (size_t i = 1; i < LAZ_decoder->chunk_first_points.size(); i++) { points_per_chunk = std::max(points_per_chunk, LAZ_decoder->chunk_first_points[i] - LAZ_decoder->chunk_first_points[i - 1]); };
+
+			};
+			return { header.number_of_point_records, header.offset_to_point_data, point_data_record_length, header.point_data_record_format, points_per_chunk, LAZ_decoder,
+				[this, header, LAZ_decoder](const uint64_t& first_point, const uint64_t& last_point, vec3* positions, vec3* colors) {
+
+					return this->decompress_points_and_extract_openGL_attributes(header, *LAZ_decoder, first_point, last_point, positions, colors);
+
+				},
+				nullptr
+			};
+
+		};
+
+		//makes sure the point data block actually fits inside the file
+		const uint64_t number_of_point_records = header.number_of_point_records;
+		const uint64_t point_data_size = number_of_point_records * point_data_record_length;
+		if (header.offset_to_point_data > file.size || point_data_size > file.size - header.offset_to_point_data) { std::cerr << "ERROR: LAS file is truncated, point data block exceeds the file size!\n"; exit(EXIT_FAILURE); };
+
+		const char* point_data = file.data + header.offset_to_point_data;
+		return { header.number_of_point_records, header.offset_to_point_data, point_data_record_length, header.point_data_record_format, POINTS_PER_DECODING_CHUNK, nullptr,
+			[this, header, point_data](const uint64_t& first_point, const uint64_t& last_point, vec3* positions, vec3* colors) {
+
+				return this->decode_points_and_extract_openGL_attributes(header, point_data, first_point, last_point, positions, colors);
+
+			},
+			[this, header, point_data, point_data_record_length](const uint64_t& first_point, const uint64_t& last_point) {
+
+				const char* records = point_data + first_point * point_data_record_length;
+				if (this->extract_extra_bytes) { this->extract_extra_bytes_columns(records, point_data_record_length, header.point_data_record_format, last_point - first_point, first_point); };
+				if (this->extract_point_attributes) { this->extract_point_attributes_columns(records, point_data_record_length, header.point_data_record_format, last_point - first_point, first_point); };
+
+			}
+		};
+
+	};
+
+	//checks the signature and version of the mapped file, extracts the members data from its header and returns a decoder for its records. The decoder refers to this instance and to *file*, both have to outlive it
+	Points_Decoder create_openGL_points_decoder(const Memory_Mapped_File& file);
+
+	//the bounds of the decoded points in openGL space, known from the header alone
+	std::pair<vec3, vec3> get_openGL_bounds() const;
+
+	//maps a geospatial position into the openGL frame, which is also where the decoded points are unless *set_openGL_origin* moved their origin
+	vec3 compute_openGL_coordinates(const double& x, const double& y, const double& z) const;
+
+	//centres and scales the openGL space on the given geospatial bounds instead of the header bounds of this cloud. Has to be called after the header was read, decoders created before still pick it up.
+	//Clouds given the same bounds decode into the same openGL space, which is how adjacent tiles are put side by side
+	void set_openGL_frame(const double minimum_bounds[3], const double maximum_bounds[3]);
+
+	//decodes the points relative to the geospatial position (x, y, z) instead of the center of the frame, so their floats only have to cover the distance to it.
+	//The origin itself stays in double, *get_openGL_origin* gives where it lies inside the frame
+	void set_openGL_origin(const double& x, const double& y, const double& z);
+	void get_openGL_origin(double origin[3]) const;
+
+	//what it takes to turn decoded points back into the geospatial coordinates and header quantization of their file, which is all a writer needs to know about where they came from
+	struct Geospatial_Frame {
+
+		//*openGL_origin* and *scale_factor* of the cloud the points were decoded by
+		double origin[3];
+		double scale_factor;
+
+		double quantization_scale[3];
+		double quantization_offset[3];
+
+		//the inverse of *compute_openGL_point_coordinates*, in double so the points land back on the integers they were decoded from
+		void compute_geospatial_coordinates(const vec3& position, double geospatial_position[3]) const {
+
+			geospatial_position[0] = double(position.x) / this->scale_factor + this->origin[0];
+			geospatial_position[1] = -double(position.z) / this->scale_factor - this->origin[2];
+			geospatial_position[2] = double(position.y) / this->scale_factor + this->origin[1];
+
+		};
+
+	};
+
+	Geospatial_Frame get_geospatial_frame() const;
+
+	//the frame a LAS file is decoded in, from its header alone. Used when the points come from the cache instead of the file
+	static Geospatial_Frame read_geospatial_frame(const std::filesystem::path& path_to_LASer_file);
+
+	//a record placing the points of a LAS file on the earth, kept raw so it can be written back as it was. All of them have the user ID "LASF_Projection"
+	struct Coordinate_Reference_System_Record {
+
+		uint16_t record_ID;
+		std::string description;
+		std::vector<char> data;
+
+	};
+
+	//the OGC WKT of LAS 1.4 and the GeoTIFF keys of the older versions
+	static constexpr uint16_t WKT_MATH_TRANSFORM_RECORD_ID = 2111;
+	static constexpr uint16_t WKT_COORDINATE_SYSTEM_RECORD_ID = 2112;
+	static constexpr uint16_t GEO_KEY_DIRECTORY_RECORD_ID = 34735;
+	static constexpr uint16_t GEO_DOUBLE_PARAMS_RECORD_ID = 34736;
+	static constexpr uint16_t GEO_ASCII_PARAMS_RECORD_ID = 34737;
+
+	//the coordinate reference system records among the VLRs and EVLRs of a LAS file, in the order they are stored. Empty when the file has none
+	static std::vector<Coordinate_Reference_System_Record> read_coordinate_reference_system(const std::filesystem::path& path_to_LASer_file);
+
+	//what the public header block of a LAS file says about it, enough to plan memory and level of detail without touching the point data
+	struct Header_Summary {
+
+		std::filesystem::path path;
+
+		//false when the file couldnt be read or isnt a LAS file, *error* then says why and the remaining members are zero
+		bool valid;
+		std::string error;
+
+		uint64_t file_size;
+		uint8_t version_major;
+		uint8_t version_minor;
+
+		//without the compression bits, which are reported through *compressed*
+		uint8_t point_data_record_format;
+		uint16_t point_data_record_length;
+		bool compressed;
+
+		uint64_t number_of_point_records;
+		uint32_t number_of_variable_length_records;
+
+		//geospatial, as written in the header
+		double minimum_bounds[3];
+		double maximum_bounds[3];
+
+		//the quantization of the record integers
+		double scale[3];
+		double offset[3];
+
+	};
+
+	//reads only the first bytes of the file holding its public header block. Unlike loading a file, a bad file doesnt end the program, it just comes back not *valid*
+	static Header_Summary read_header_summary(const std::filesystem::path& path_to_LASer_file);
+
+	//reads the header summaries of all *paths_to_LASer_files* in parallel, in the same order
+	static std::vector<Header_Summary> read_header_summaries(const std::vector<std::filesystem::path>& paths_to_LASer_files);
+
+	//fills *summary* from the public header block at *header_bytes*, of which only *n_header_bytes* could be read
+	template<typename Public_Header_Block_Version_X_X>
+	static void summarize_header(const char* header_bytes, const size_t& n_header_bytes, Header_Summary& summary) {
+
+		Public_Header_Block_Version_X_X header;
+		if (n_header_bytes < sizeof(header)) { summary.error = "file is smaller than its public header block"; return; };
+		std::memcpy(&header, header_bytes, sizeof(header));
+		if (header.header_size < sizeof(header)) { summary.error = "header size " + std::to_string(header.header_size) + " is smaller than " + std::to_string(sizeof(header)); return; };
+
+		summary.point_data_record_format = header.point_data_record_format & ~COMPRESSED_POINT_DATA_RECORD_FORMAT_BITS;
+		summary.compressed = header.point_data_record_format & COMPRESSED_POINT_DATA_RECORD_FORMAT_BITS;
+		summary.point_data_record_length = header.point_data_record_length;
+		summary.number_of_variable_length_records = header.number_of_variable_length_records;
+		summary.number_of_point_records = header.number_of_point_records;
+
+		//LAS 1.4 writers may leave the 64 bit count empty for files that also fit the legacy one
+		if constexpr (requires { header.legacy_number_of_point_records; }) {
+
+			if (summary.number_of_point_records == 0) { summary.number_of_point_records = header.legacy_number_of_point_records; };
+
+		};
+
+		summary.minimum_bounds[0] = header.min_X; summary.minimum_bounds[1] = header.min_Y; summary.minimum_bounds[2] = header.min_Z;
+		summary.maximum_bounds[0] = header.max_X; summary.maximum_bounds[1] = header.max_Y; summary.maximum_bounds[2] = header.max_Z;
+		summary.scale[0] = header.X_scale_factor; summary.scale[1] = header.Y_scale_factor; summary.scale[2] = header.Z_scale_factor;
+		summary.offset[0] = header.X_offset; summary.offset[1] = header.Y_offset; summary.offset[2] = header.Z_offset;
+		summary.valid = true;
+
+	};
+
+	void extract_openGL_points_attributes_from_stream(const std::filesystem::path& path_to_LASer_file, std::vector<vec3>& points_coordinates, std::vector<vec3>& points_colors);
+	void extract_openGL_points_attributes_from_memory(const std::filesystem::path& path_to_LASer_file, std::vector<vec3>& points_coordinates, std::vector<vec3>& points_colors, const bool& in_parallel);
+
+	static constexpr uint8_t READ_WITH_STREAM = 0;
+	static constexpr uint8_t READ_WITH_MEMORY_MAP = 1;
+	static constexpr uint8_t READ_WITH_MEMORY_MAP_MULTITHREADED = 2;
+
+	//*READ_MODE* chooses between the old per point *std::ifstream::read* path, the serial memory mapped path and the multithreaded memory mapped path. All print their load throughput so they can be compared on the same file
+	void extract_openGL_points_attributes(const std::filesystem::path& path_to_LASer_file, std::vector<vec3>& points_coordinates, std::vector<vec3>& points_colors, const uint8_t& READ_MODE = READ_WITH_MEMORY_MAP_MULTITHREADED);
+
+};
+
+//loads a set of LAS tiles into one openGL space. The frame spans the union of the header bounds of all tiles and is fixed before anything is decoded, so every tile is placed by the same center and scale and adjacent tiles line up exactly.
+//Every tile is decoded relative to the center of its own header bounds, its *origin*, which has to be added back when drawing it.
+//The chunks of all tiles are decoded together on the thread pool into one shared vertex stream, in which every tile keeps a contiguous range
+class Point_Cloud_Mosaic {
+
+ public:
+
+	struct Tile {
+
+		std::filesystem::path path;
+
+		//range of the tile inside the shared vertex stream
+		uint64_t first_point;
+		uint64_t number_of_points;
+
+		//the positions of the tile are relative to this point of the shared frame, kept in double so far away tiles dont lose precision
+		double origin[3];
+
+		//openGL bounds of the tile inside the shared frame, from its header
+		vec3 minimum_bounds;
+		vec3 maximum_bounds;
+
+		//turns the positions of the tile back into geospatial coordinates
+		Point_Cloud::Geospatial_Frame frame;
+
+	};
+
+	std::vector<Tile> tiles;
+	uint64_t number_of_points;
+	vec3 minimum_bounds;
+	vec3 maximum_bounds;
+
+	//reads the headers of all tiles and prepares their decoders, no point is decoded yet
+	Point_Cloud_Mosaic(const std::vector<std::filesystem::path>& paths_to_LASer_files);
+
+	Point_Cloud_Mosaic(const Point_Cloud_Mosaic&) = delete;
+	Point_Cloud_Mosaic& operator=(const Point_Cloud_Mosaic&) = delete;
+
+	//applied to every tile by *decode*
+	Point_Cloud::Point_Filter point_filter;
+
+	//decodes every tile into its range of *positions* and *colors*, and of *point_attributes* unless it is null. With an active *point_filter* the ranges, *number_of_points* and the vectors shrink to the kept points
+	void decode(std::vector<vec3>& positions, std::vector<vec3>& colors, Point_Cloud::Point_Attributes* point_attributes = nullptr);
+
+ private:
+
+	//the decoder of a tile refers to its cloud and mapping, so every tile lives behind a pointer and never moves
+	struct Tile_Source {
+
+		Memory_Mapped_File file;
+		Point_Cloud cloud;
+		Point_Cloud::Points_Decoder decoder;
+
+		Tile_Source(const std::filesystem::path& path_to_LASer_file);
 
 	};
 
-	void extract_openGL_points_attributes(const std::filesystem::path& path_to_LASer_file, std::vector<vec3>& points_coordinates, std::vector<vec3>& points_colors);
+	std::vector<std::unique_ptr<Tile_Source>> sources;
 
 };
-	
 
+//decodes a LAS file in fixed size batches on a background thread, so the points can be uploaded to the GPU piece by piece whilst the rest of the file is still being read.
+//At most *N_STREAMING_BATCHES* decoded batches exist at any time and their size is derived from *host_memory_budget*, so the host memory in use doesnt grow with the file size
+class Point_Cloud_Stream {
+
+ public:
+
+	struct Batch {
+
+		uint64_t first_point;
+		size_t n_points;
+		std::vector<vec3> positions;
+		std::vector<vec3> colors;
+
+	};
+
+	//one batch being decoded, one waiting and one being uploaded
+	static constexpr size_t N_STREAMING_BATCHES = 3;
+
+	uint64_t number_of_points;
+	size_t points_per_batch;
+	vec3 minimum_bounds;
+	vec3 maximum_bounds;
+
+	//hands out the next decoded batch without blocking, returns false if none is ready yet. The batch has to be given back with *recycle_batch* once its data was consumed
+	bool pop_batch(Batch& batch);
+	void recycle_batch(Batch&& batch);
+
+	Point_Cloud_Stream(const std::filesystem::path& path_to_LASer_file, const size_t& host_memory_budget);
+
+	Point_Cloud_Stream(const Point_Cloud_Stream&) = delete;
+	Point_Cloud_Stream& operator=(const Point_Cloud_Stream&) = delete;
+
+	//destructor, stops the decoding thread
+	~Point_Cloud_Stream();
+
+ private:
+
+	Memory_Mapped_File file;
+	Point_Cloud cloud;
+	Point_Cloud::Points_Decoder decoder;
+
+	std::mutex mutex;
+	std::condition_variable batch_recycled;
+	std::deque<Batch> ready_batches;
+	std::vector<Batch> free_batches;
+	bool stop;
+
+	std::thread decoding_thread;
+
+	void decode_batches();
+
+};
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <memory>
+#include <filesystem>
+
+#include "computer_graphics/Math.h"
+#include "computer_graphics/File.h"
+#include "computer_graphics/Point_Cloud.h"
+
+//the decoded openGL positions and colors of a LAS file, together with its bounds and Extra Bytes columns, stored next to the file so reopening it is a single memory map instead of a full decode.
+//A cache is only used while the size, the modification time and a hash of the first and last bytes of its LAS file still match the ones it was written from
+class Point_Cloud_Cache {
+
+ public:
+
+	static constexpr const char* EXTENSION = ".pccache";
+
+	uint64_t number_of_points;
+	vec3 minimum_bounds;
+	vec3 maximum_bounds;
+
+	//both point into the mapping, the colors follow right after the positions so the two can be uploaded as one buffer
+	const vec3* positions;
+	const vec3* colors;
+
+	//point into the mapping as well, null when the cache was written without point attributes. *GPS_times* is also null when the file has no GPS time
+	const double* GPS_times;
+	const uint16_t* intensities;
+	const uint8_t* classifications;
+	const uint8_t* returns;
+
+	std::vector<Point_Cloud::Extra_Bytes_Column> extra_bytes_columns;
+
+	//the cache of *path_to_LASer_file*, which is the file name with *EXTENSION* appended
+	static std::filesystem::path get_cache_path(const std::filesystem::path& path_to_LASer_file);
+
+	//writes the cache of *path_to_LASer_file* through a temporary file, so a cache is either complete or absent. Failing to write only prints a warning since the points are already loaded
+	static void write(const std::filesystem::path& path_to_LASer_file, const std::vector<vec3>& positions, const std::vector<vec3>& colors, const vec3& minimum_bounds, const vec3& maximum_bounds, const std::vector<Point_Cloud::Extra_Bytes_Column>& extra_bytes_columns, const Point_Cloud::Point_Attributes& point_attributes);
+
+	//maps the cache of *path_to_LASer_file*, null if there is none or it is out of date
+	static std::unique_ptr<Point_Cloud_Cache> open(const std::filesystem::path& path_to_LASer_file);
+
+	//the positions and colors back to back
+	const char* get_vertex_data() const;
+	size_t get_vertex_data_size() const;
+
+	bool has_point_attributes() const { return this->intensities != nullptr; };
+
+	//copies the point attributes out of the mapping
+	Point_Cloud::Point_Attributes get_point_attributes() const;
+
+	//size, modification time and hash of a LAS file, as stored in *Cache_Header*. Octrees identify their LAS file the same way
+	static void identify_source(const std::filesystem::path& path_to_LASer_file, uint64_t& source_size, int64_t& source_modification_time, uint64_t& source_hash);
+
+	Point_Cloud_Cache(const Point_Cloud_Cache&) = delete;
+	Point_Cloud_Cache& operator=(const Point_Cloud_Cache&) = delete;
+
+ private:
+
+#pragma pack(push, 1)
+	struct Cache_Header {
+
+		char signature[8];
+		uint32_t version;
+		uint32_t number_of_extra_bytes_columns;
+
+		//the point attributes follow the colors when set, GPS times first so every column stays aligned to its type. Both are 32 bits to keep the positions 8 byte aligned
+		uint32_t has_point_attributes;
+		uint32_t has_GPS_times;
+		uint64_t source_size;
+		int64_t source_modification_time;
+		uint64_t source_hash;
+		uint64_t number_of_points;
+		float minimum_bounds[3];
+		float maximum_bounds[3];
+
+	};
+#pragma pack(pop)
+
+#pragma pack(push, 1)
+	//followed by the values of the column, *size* bytes per point
+	struct Cache_Extra_Bytes_Column {
+
+		char name[32];
+		char description[32];
+		uint8_t data_type;
+		uint8_t options;
+		uint8_t n_elements;
+		uint8_t element_size;
+		uint16_t offset_in_record;
+		uint16_t size;
+		double scale[3];
+		double offset[3];
+
+	};
+#pragma pack(pop)
+
+	static constexpr uint32_t VERSION = 3;
+
+	//bytes hashed at the start and at the end of the LAS file, enough to catch a rewritten header or point data without reading the whole file
+	static constexpr size_t HASHED_BYTES = 64 * 1024;
+
+	Memory_Mapped_File file;
+
+	Point_Cloud_Cache(Memory_Mapped_File&& file);
+
+};
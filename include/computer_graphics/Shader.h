@@ -63,6 +63,10 @@ public:
 
 	unsigned int program;
 	unsigned int positions_buffer, normals_buffer, colors_buffer, indices_buffer, texture_coordinates_buffer, tangents_buffer, bitangents_buffer, frame_buffer;
+	unsigned int intensities_buffer, classifications_buffer, returns_buffer, GPS_times_buffer;
+
+	//GL_UNSIGNED_SHORT when the mesh has few enough vertices for its indices to be uploaded in 16 bits, GL_UNSIGNED_INT otherwise
+	unsigned int indices_type = GL_UNSIGNED_INT;
 	unsigned int frame_buffer_colors_texture_ID, frame_buffer_positions_texture_ID, frame_buffer_depth_texture_ID;
 	
 	void create_uniform_bool(const bool& boolean, const char* uniform_name);
@@ -89,6 +93,26 @@ private:
 	void upload_vec3_uniforms();
 	void upload_mat4_uniforms();
 
+	//the GPU copy of one octree node
+	struct Octree_Node_Buffers {
+
+		//a quantized node has its *Quantized_Point* in *positions_buffer* and no colors buffer
+		unsigned int positions_buffer;
+		unsigned int colors_buffer;
+		uint32_t n_points;
+		uint64_t last_drawn_frame;
+		bool quantized;
+
+	};
+
+	//nodes stay on the GPU after they stop being drawn until the resident points exceed twice the point budget, then the ones drawn the longest time ago are released first
+	std::unordered_map<uint32_t, Octree_Node_Buffers> octree_node_buffers;
+	const Octree* buffered_octree = nullptr;
+	uint64_t n_resident_octree_points = 0;
+	uint64_t octree_frame = 0;
+
+	void delete_octree_node_buffers();
+
 public:
 
 	//opted to use a different function for each type instead of a templated function which checks for size and gets the correct map type, since i need speed. Having to check everytime for all possible types before getting a hit will take along time if we have alot of uniforms.
@@ -133,6 +157,29 @@ public:
 
 	};
 
+	//allocates *size_in_bytes* of uninitialized storage for a buffer that is filled piece by piece afterwards with *glBufferSubData*
+	static void allocate_array_buffer(const bool& generate_array_buffer, unsigned int* array_buffer, const size_t& size_in_bytes, const unsigned int& GL_DRAW_TYPE, const int& attribute_position, const int& attribute_size) {
+
+		if (generate_array_buffer) { glGenBuffers(1, array_buffer); };
+		glBindBuffer(GL_ARRAY_BUFFER, *array_buffer);
+		if (*array_buffer == 0) {
+
+			std::cerr << "ERORR: failed to generate buffer!\n";
+			exit(EXIT_FAILURE);
+
+		};
+
+		glBufferData(GL_ARRAY_BUFFER, size_in_bytes, NULL, GL_DRAW_TYPE);
+
+		if (generate_array_buffer) {
+
+			glVertexAttribPointer(attribute_position, attribute_size, GL_FLOAT, GL_FALSE, attribute_size * sizeof(float), (void*)0);
+			glEnableVertexAttribArray(attribute_position);
+
+		};
+
+	};
+
 	template<typename T>
 	static void bind_index_buffer(const bool& generate_index_buffer, unsigned int* index_buffer, const std::vector<T>& index_buffer_data, const unsigned int& GL_DRAW_TYPE) {
 
@@ -218,10 +265,38 @@ public:
 	void update_texture(unsigned int* texture_ID, const unsigned int& GL_TEXTUREindex, unsigned char* bytes, const int& texture_width, const int& texture_height, const int& n_color_channels);
 
 	static constexpr unsigned int DRAW_TO_FRAME_BUFFER = 1;
+
+	//bounds the octree nodes uploaded in a single frame, nodes that dont fit wait for the next frames while their parents are drawn in their place
+	static constexpr uint64_t MAX_OCTREE_POINTS_UPLOADED_PER_FRAME = 2000000;
+
+	//how finely octree meshes are drawn, see *Octree::select_nodes*. Set from the UI and only read on the CPU, they are never uploaded to the shaders
+	uint64_t octree_point_budget = 5000000;
+	float octree_max_screen_space_error = 1.5f;
+
 	void bind_mesh_buffers_and_textures(Mesh& mesh, const vec2& screen_size, const unsigned int& GL_DRAW_TYPE, const bool& gamma_correction);
+	void stream_mesh_buffers(Mesh& mesh);
+	void update_octree_buffers(Mesh& mesh);
 	void draw_mesh_elements(Mesh& mesh, const unsigned int& GL_PRIMITIVE_TYPE = GL_TRIANGLES);
 	void bind_and_draw_mesh_elements(Mesh& mesh, const vec2& screen_size, const unsigned int& GL_PRIMITIVE_TYPE = GL_TRIANGLES, const unsigned int& GL_DRAW_MODE = GL_STATIC_DRAW, const bool& gamma_correction = true);
 
+	//the same model view projection matrix the vertex shaders build out of the uniforms
+	mat4 compute_model_view_projection_matrix();
+
+	//uploads where the point *origin* of the model lands relative to the camera, worked out in double, together with the origin itself. Shaders that add their positions to this instead of
+	//subtracting the camera position from them only ever see small numbers, so points drawn far from the center of the frame keep their precision
+	void upload_camera_relative_origin(const double origin[3]);
+
+	//uploads the box the quantized positions of the next draw are relative to, float positions are drawn with the unit box at the origin
+	void upload_quantization_box(const vec3& box_minimum, const vec3& box_size);
+
+	//quantizes the points and uploads them into the bound array buffer, pointing attributes 0 and 5 at them
+	static void upload_quantized_points(const vec3* positions, const vec3* colors, const size_t& n_points, const vec3& box_minimum, const vec3& box_size, const unsigned int& GL_DRAW_TYPE);
+	static void set_quantized_points_attributes();
+
+	//uploads the point attributes of a LAS mesh as one buffer per column, pointing attributes 6 to 9 at them, and sets the uniforms the LAS shaders color the points with. Intensities arrive normalized,
+	//classifications and returns as integers and GPS times as floats relative to the earliest one, which keeps their precision. Null *intensities* disables the attributes
+	void upload_point_attributes(const bool& generate_buffers, const uint16_t* intensities, const uint8_t* classifications, const uint8_t* returns, const double* GPS_times, const size_t& n_points, const unsigned int& GL_DRAW_TYPE);
+
 	void delete_buffers();
 	void delete_program();
 	void delete_all();
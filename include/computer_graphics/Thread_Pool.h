@@ -0,0 +1,54 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+//a fixed set of worker threads that process index ranges in parallel. The calling thread takes part in the work as well, so *n_threads* includes it
+class Thread_Pool {
+
+ public:
+
+	unsigned int n_threads;
+
+	//splits [0, n_elements) into chunks of *chunk_size* and hands them out to the workers, blocks until every chunk has been processed.
+	//If the pool is already busy (e.g. when called from inside another job) the chunks are processed serially on the calling thread instead of deadlocking
+	void parallel_for(const size_t& n_elements, const size_t& chunk_size, const std::function<void(const size_t& first, const size_t& last)>& function);
+
+	//the pool shared by the whole program, sized to the number of hardware threads
+	static Thread_Pool& shared();
+
+	Thread_Pool(const unsigned int& n_threads);
+
+	Thread_Pool(const Thread_Pool&) = delete;
+	Thread_Pool& operator=(const Thread_Pool&) = delete;
+
+	//destructor
+	~Thread_Pool();
+
+ private:
+
+	std::vector<std::thread> workers;
+
+	std::mutex mutex;
+	std::mutex submit_mutex;
+	std::condition_variable job_available;
+	std::condition_variable job_finished;
+
+	const std::function<void(const size_t& first, const size_t& last)>* job;
+	size_t job_n_elements;
+	size_t job_chunk_size;
+	size_t job_n_chunks;
+	std::atomic<size_t> next_chunk;
+	size_t n_finished_workers;
+	uint64_t generation;
+	bool stop;
+
+	void run_chunks();
+	void worker_loop();
+
+};
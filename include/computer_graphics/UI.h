@@ -101,13 +101,30 @@ private:
 	std::vector<std::filesystem::path> texture_maps;
 	std::vector<std::filesystem::path> obj_files;
 	std::vector<std::filesystem::path> las_files;
+	//header summaries of *las_files*, read once when the list is built so every entry shows its size before anything is loaded
+	std::vector<Point_Cloud::Header_Summary> las_files_summaries;
 	std::filesystem::path shader_folder_path;
 	std::filesystem::path obj_file_path;
 	std::filesystem::path las_file_path;
+	//the LAS file the drawn mesh was built from, *las_file_path* is cleared once the scene is rebuilt
+	std::filesystem::path loaded_las_file_path;
+	std::vector<std::filesystem::path> las_mosaic_paths;
 	std::filesystem::path texture_map_path;
 	unsigned int gl_primitive_type;
 	bool from_OBJ_file;
 	bool from_LAS_file;
+	bool stream_LAS_file;
+	bool octree_LAS_file;
+	bool mosaic_LAS_file;
+	bool compact_LAS_points;
+	bool keep_LAS_point_attributes;
+	bool remove_LAS_outliers;
+	bool estimate_LAS_normals;
+	int LAS_point_budget;
+	int LAS_voxel_selection;
+	Point_Cloud::Point_Filter LAS_point_filter;
+	int LAS_returns;
+	int LAS_intensity_range[2];
 	bool from_Texture_map;
 
 	std::string rendering_information;
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#include "computer_graphics/Math.h"
+#include "computer_graphics/Thread_Pool.h"
+#include "computer_graphics/Hash_Binning.h"
+
+//finds the vertices of a mesh that share their position, normal and uv. Vertices are compared bit for bit, the way *vec3_hasher* hashes them, so 0 and -0 stay apart.
+//The table is a flat open addressing hash table: 8 byte slots holding a tag of the hash and where the key sits in a dense array of keys, probed linearly, so a lookup is
+//one cache line of slots and, only when the tags match, one compare of the 32 byte key. The sort based alternative takes every vertex at once and deduplicates them in parallel
+class Vertex_Deduplicator {
+
+ public:
+
+	//the position, normal and uv of a vertex as their bits, 32 bytes so comparing two keys is a couple of vector instructions
+	struct Key {
+
+		uint32_t bits[8];
+
+		Key() = default;
+		Key(const vec3& position, const vec3& normal, const vec2& uv);
+
+		//no early out, the compiler turns the loop into vector compares
+		bool operator==(const Key& other) const {
+
+			uint32_t difference = 0;
+			for (int i = 0; i < 8; i++) { difference |= this->bits[i] ^ other.bits[i]; };
+			return difference == 0;
+
+		};
+
+		uint64_t hash() const;
+
+	};
+
+	//sizes the table so *n_vertices* unique vertices fit without it growing, it still grows past them
+	void reserve(const size_t& n_vertices);
+
+	//the value inserted with the key equal to *key*, otherwise *key* is inserted with *value*, which is returned, and *inserted* is set
+	uint32_t find_or_insert(const Key& key, const uint32_t& value, bool& inserted);
+
+	size_t size() const { return this->keys.size(); };
+
+	//frees the memory of the table
+	void clear();
+
+	//deduplicates all of *keys* at once: the keys are binned by their hash with *Hash_Binning*, so equal keys sit next to each other.
+	//*unique_indices* receives for every key the index of its unique key, numbered in the order the unique keys first appear, which is the numbering the table gives them as well.
+	//*first_occurrences* receives for every unique key where it first appears in *keys*. Returns the number of unique keys
+	static size_t deduplicate_by_sorting(const std::vector<Key>& keys, std::vector<uint32_t>& unique_indices, std::vector<uint32_t>& first_occurrences);
+
+ private:
+
+	static constexpr uint32_t EMPTY = UINT32_MAX;
+
+	struct Slot {
+
+		//the high half of the hash, the low half picked the slot
+		uint32_t tag;
+		uint32_t entry;
+
+	};
+
+	//a power of two, at most half full
+	std::vector<Slot> slots;
+	std::vector<Key> keys;
+	std::vector<uint32_t> values;
+
+	void rehash(const size_t& n_slots);
+
+#pragma pack(push, 1)
+	struct Binned_Key {
+
+		uint64_t hash;
+		uint32_t index;
+
+		//sorting by the index as well puts the first of the keys sharing a hash first
+		bool operator<(const Binned_Key& other) const { return this->hash < other.hash || (this->hash == other.hash && this->index < other.index); };
+
+	};
+#pragma pack(pop)
+
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+
+#include "computer_graphics/Math.h"
+#include "computer_graphics/Thread_Pool.h"
+#include "computer_graphics/Hash_Binning.h"
+
+//decimates a point cloud to at most one point per cell of a regular grid of cubes. The points are binned by their cell keys with *Hash_Binning*,
+//so the points of a cell sit next to each other and the memory used is a fixed 12 bytes per point
+class Voxel_Downsampler {
+
+ public:
+
+	//which point stands for the points of a cell
+	static constexpr uint8_t FIRST_POINT = 0;
+	static constexpr uint8_t CENTROID = 1;
+	static constexpr uint8_t RANDOM_POINT = 2;
+
+	//replaces the points with one point per cell of size *voxel_size*. FIRST_POINT keeps the point that came first in the arrays, CENTROID averages the positions and colors of the cell
+	//and RANDOM_POINT keeps one of the points of the cell picked by hashing its cell with *seed*, so the same seed always picks the same points.
+	//Unless null, *representatives* receives the index of the point kept for every cell, the first point of the cell for CENTROID, so other per point data can follow the positions
+	static void downsample(std::vector<vec3>& positions, std::vector<vec3>& colors, const float& voxel_size, const uint8_t& SELECTION = FIRST_POINT, const uint64_t& seed = 0, std::vector<uint32_t>* representatives = nullptr);
+
+	//the number of cells of size *voxel_size* holding at least one point
+	static uint64_t count_occupied_voxels(const std::vector<vec3>& positions, const float& voxel_size);
+
+	//the smallest voxel size, among the few that are tried, that leaves at most *point_budget* points. The number of occupied cells is modelled as a power of the voxel size
+	//whose exponent, the dimension of the cloud, is estimated from the counts of the previous tries
+	static float compute_voxel_size(const std::vector<vec3>& positions, const uint64_t& point_budget);
+
+ private:
+
+	//cell coordinates use 21 bits per axis
+	static constexpr uint32_t MAX_CELLS_PER_AXIS = 1u << 21;
+
+#pragma pack(push, 1)
+	struct Binned_Point {
+
+		uint64_t key;
+		uint32_t index;
+
+		//sorting by the index as well keeps the points of every cell in their original order
+		bool operator<(const Binned_Point& other) const { return this->key < other.key || (this->key == other.key && this->index < other.index); };
+
+	};
+#pragma pack(pop)
+
+	//the binned points, bucket after bucket, with the points of every cell next to each other inside their bucket
+	struct Bins {
+
+		std::vector<Binned_Point> points;
+		std::vector<size_t> bucket_offsets;
+
+	};
+
+	static Bins bin_points(const std::vector<vec3>& positions, const float& voxel_size);
+
+};
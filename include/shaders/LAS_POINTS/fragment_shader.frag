@@ -2,14 +2,53 @@
 
 uniform bool height_coloring;
 
+//Phong lighting of the points, only when their normals were estimated and uploaded
+uniform bool point_lighting;
+uniform bool point_normals;
+
+uniform vec3 light_position;
+uniform vec3 light_color;
+uniform vec3 camera_position;
+
+uniform float ambient;
+uniform float diffuse;
+uniform float specular;
+uniform float shininess;
+
 uniform float min_height;
 uniform float max_height;
 
 in vec3 gPosition;
 in vec3 gColor;
+in vec3 gNormal;
+in vec3 gWorld_position;
 
 out vec4 FragColor;
 
+float calculate_light_intensity(float distance_from_light, float initial_light_intensity, float constant_attenuation_component, float linear_attenuation_coefficient, float quadratic_attenuation_coefficient) {
+
+    float attenuation = constant_attenuation_component + linear_attenuation_coefficient * distance_from_light + quadratic_attenuation_coefficient * pow(distance_from_light, 2);
+    return initial_light_intensity / attenuation;
+
+};
+
+vec3 calculate_phong_lighting(vec3 frag_position, vec3 normal, vec3 eye_vector, vec3 light_position, vec3 light_color, float light_intensity, vec3 frag_color, float ambient, float diffuse, float specular, float shininess) {
+
+    vec3 view_vector = normalize(eye_vector - frag_position);
+    vec3 light_vector = normalize(light_position - frag_position);
+    vec3 half_vector = normalize(view_vector + light_vector);
+
+    float cos_alpha = max(dot(normal, light_vector), 0.0);
+    float cos_theta_prime = max(dot(normal, half_vector), 0.0);
+    
+    vec3 Ca = ambient * frag_color;
+    vec3 Cd = diffuse * cos_alpha * frag_color * light_intensity;   
+    vec3 Cs = specular * pow(cos_theta_prime, shininess) * light_color * light_intensity;
+
+    return Ca + Cd + Cs;
+
+};
+
 vec3 interpolate(float interpolation_factor, vec3 min_value, vec3 max_value) {
 
   return min_value + (max_value - min_value) * interpolation_factor;
@@ -45,14 +84,25 @@ vec3 color_based_off_height(float current_height, float min_height, float max_he
 
 void main() {
    
+    vec3 Color = gColor;
     if (height_coloring) {
     
-       FragColor = vec4(color_based_off_height(gPosition.z, min_height, max_height), 1.0f);
-    
-    } else {
-    
-      FragColor = vec4(gColor, 1.0f);
+       Color = color_based_off_height(gPosition.z, min_height, max_height);
     
     };
 
+    if (point_lighting && point_normals) {
+
+        //a point is a splat seen from either side, so its normal is turned towards the camera
+        vec3 Normal = normalize(gNormal);
+        if (dot(Normal, camera_position - gWorld_position) < 0.0) { Normal = -Normal; };
+
+        float distance_from_light = length(light_position - gWorld_position);
+        float light_intensity = calculate_light_intensity(distance_from_light, 100.0, 0.0, 0.1, 0.1);
+        Color = calculate_phong_lighting(gWorld_position, Normal, camera_position, light_position, light_color, light_intensity, Color, ambient, diffuse, specular, shininess);
+
+    };
+
+    FragColor = vec4(Color, 1.0f);
+
 };
\ No newline at end of file
@@ -7,6 +7,12 @@ layout(location = 3) in vec2 aBitangent;
 layout(location = 4) in vec2 aTexture_coordinates;
 layout(location = 5) in vec3 aColor;
 
+//the point attributes of the LAS file, read only when *point_attributes* is set. *aReturn* holds the return number in its low 4 bits and the number of returns in its high 4 bits
+layout(location = 6) in float aIntensity;
+layout(location = 7) in uint aClassification;
+layout(location = 8) in uint aReturn;
+layout(location = 9) in float aGPS_time;
+
 uniform bool orthogonal_projection;
 
 uniform float orthogonal_size;
@@ -18,21 +24,93 @@ uniform vec3 up_vector;
 uniform vec3 camera_position;
 uniform vec3 camera_rotation_vector;
 
+//the origin the positions are relative to, and where it lands relative to the camera once the model transformation is applied. The latter is worked out on the CPU in double,
+//so the camera position is never subtracted from large coordinates in here
+uniform vec3 origin;
+uniform vec3 origin_relative_to_camera;
+
+//quantized positions arrive normalized to [0, 1] inside this box, float positions come with the unit box at the origin and pass through unchanged
+uniform vec3 quantization_box_minimum;
+uniform vec3 quantization_box_size;
+
 uniform vec3 model_translation_vector;
 uniform vec3 model_scaling_vector;
 uniform vec3 model_rotation_vector;
 
 uniform vec2 screen_size;
 
+//0 colors the points by their RGB, 1 by intensity, 2 by ASPRS classification, 3 by return and 4 by GPS time. Without point attributes every mode falls back to RGB
+uniform int color_mode;
+uniform bool point_attributes;
+uniform float intensity_scale;
+uniform float GPS_time_range;
+
 out vec3 vPosition;
 out vec3 vColor;
 
+//for lighting, the normal turned with the model and the position of the point in the frame of the camera position and the light
+out vec3 vNormal;
+out vec3 vWorld_position;
+
 float to_radians(float degree) {
 
 	return degree * 3.14159265359 / 180.0;
 
 };
 
+//blue to red through green and yellow
+vec3 ramp(float value) {
+
+	value = clamp(value, 0.0, 1.0);
+	return clamp(vec3(1.5 - abs(4.0 * value - 3.0), 1.5 - abs(4.0 * value - 2.0), 1.5 - abs(4.0 * value - 1.0)), 0.0, 1.0);
+
+};
+
+//the standard ASPRS classes of LAS 1.4, anything else is drawn grey
+vec3 classification_color(uint classification) {
+
+	switch (classification) {
+
+		case 1u: return vec3(0.6, 0.6, 0.6);//unclassified
+		case 2u: return vec3(0.6, 0.4, 0.2);//ground
+		case 3u: return vec3(0.6, 0.9, 0.4);//low vegetation
+		case 4u: return vec3(0.2, 0.8, 0.2);//medium vegetation
+		case 5u: return vec3(0.0, 0.5, 0.0);//high vegetation
+		case 6u: return vec3(0.9, 0.3, 0.2);//building
+		case 7u: return vec3(1.0, 0.0, 1.0);//low point
+		case 9u: return vec3(0.2, 0.4, 1.0);//water
+		case 10u: return vec3(0.8, 0.7, 0.3);//rail
+		case 11u: return vec3(0.3, 0.3, 0.3);//road surface
+		case 13u: return vec3(1.0, 1.0, 0.0);//wire guard
+		case 14u: return vec3(1.0, 0.8, 0.0);//wire conductor
+		case 15u: return vec3(1.0, 0.5, 0.0);//transmission tower
+		case 17u: return vec3(0.5, 0.2, 0.8);//bridge deck
+		case 18u: return vec3(1.0, 0.0, 0.0);//high noise
+		default: return vec3(0.8, 0.8, 0.8);
+
+	};
+
+};
+
+vec3 point_color() {
+
+	if (!point_attributes || color_mode == 0) { return aColor; };
+	if (color_mode == 1) { return vec3(clamp(aIntensity * intensity_scale, 0.0, 1.0)); };
+	if (color_mode == 2) { return classification_color(aClassification); };
+	if (color_mode == 3) {
+
+		uint return_number = aReturn & 15u;
+		uint number_of_returns = aReturn >> 4;
+		if (number_of_returns <= 1u) { return vec3(0.9, 0.9, 0.9); };//single
+		if (return_number == 1u) { return vec3(0.9, 0.2, 0.2); };//first
+		if (return_number >= number_of_returns) { return vec3(0.2, 0.4, 0.9); };//last
+		return vec3(0.2, 0.8, 0.2);//intermediate
+
+	};
+	return ramp(aGPS_time / GPS_time_range);
+
+};
+
 mat4 create_translation_matrix(vec3 translation_vector) {
 
 	mat4 matrix = mat4(
@@ -191,12 +269,12 @@ mat4 create_frustum_projection_matrix(float FOV, vec2 screen_size, float near, f
 
 void main() {
  
-    mat4 model_transformation_matrix = create_model_transformation_matrix(model_translation_vector, model_scaling_vector, model_rotation_vector);
+    //camera relative: the translations of the model and of the camera are both folded into *origin_relative_to_camera*, what is left is rotating and scaling the position around it
+    mat4 model_rotation_scale_matrix = create_rotation_matrix(model_rotation_vector) * create_scale_matrix(model_scaling_vector);
 
 	mat4 camera_rotation_matrix = create_rotation_matrix(camera_rotation_vector);
 	vec3 forward = (camera_rotation_matrix * vec4(forward_vector, 0.0)).xyz;
-	vec3 camera_target_position = camera_position + forward;
-	mat4 view_matrix = create_view_matrix(camera_position, camera_target_position, up_vector);
+	mat4 view_matrix = create_view_matrix(vec3(0.0, 0.0, 0.0), forward, up_vector);
 	
 	mat4 projection_matrix;
 	if (orthogonal_projection) {
@@ -210,13 +288,15 @@ void main() {
 
 	};
     
-    mat3 model_matrix = transpose(inverse(mat3(model_transformation_matrix)));
-
+    vec3 position = quantization_box_minimum + aPosition * quantization_box_size;
+    vec3 position_relative_to_camera = origin_relative_to_camera + (model_rotation_scale_matrix * vec4(position, 1.0)).xyz;
 
-    vPosition = aPosition;
-    vColor = aColor;
+    vPosition = origin + position;
+    vColor = point_color();
+    vNormal = normalize(transpose(inverse(mat3(model_rotation_scale_matrix))) * aNormal);
+    vWorld_position = camera_position + position_relative_to_camera;
 
     gl_PointSize = point_size;
-    gl_Position = projection_matrix * view_matrix * model_transformation_matrix * vec4(vPosition, 1.0);
+    gl_Position = projection_matrix * view_matrix * vec4(position_relative_to_camera, 1.0);
     
 };
@@ -0,0 +1,397 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <filesystem>
+#include <tuple>
+#include <unordered_map>
+
+#include "computer_graphics/Math.h"
+#include "computer_graphics/Thread_Pool.h"
+#include "computer_graphics/Point_Cloud.h"
+#include "computer_graphics/LAS_Writer.h"
+#include "computer_graphics/File.h"
+#include "computer_graphics/OBJ_Parser.h"
+#include "computer_graphics/Vertex_Deduplicator.h"
+
+//times the old and new paths of the loaders on the same input, so the numbers quoted for them can be reproduced and regressions caught. Every path is run *repeats* times and the best run is
+//reported, the first run also warms the page cache. Without an input file a fixture is generated into the temporary directory, the same one every time for the same size.
+//Usage: benchmark las [file.las | number of points] [repeats]
+//       benchmark obj [file.obj | number of faces] [repeats]
+//       benchmark dedup [file.obj | number of cells] [repeats]
+
+//the best of *repeats* runs of *function*, in milliseconds
+template<typename Function>
+static double time_best_of(const int& repeats, const Function& function) {
+
+	double best = std::numeric_limits<double>::max();
+	for (int run = 0; run < repeats; run++) {
+
+		auto start = std::chrono::steady_clock::now();
+		function();
+		std::chrono::duration<double, std::milli> elapsed_time = std::chrono::steady_clock::now() - start;
+		best = std::min(best, elapsed_time.count());
+
+	};
+	return best;
+
+};
+
+static void print_result(const std::string& path_name, const double& milliseconds, const double& megabytes, const double& baseline_milliseconds) {
+
+	std::cout << "  " << path_name << ": " << milliseconds << " ms, " << megabytes / (milliseconds / 1000.0) << " MB/s, " << baseline_milliseconds / milliseconds << "x\n";
+
+};
+
+static std::filesystem::path get_fixture_directory() {
+
+	std::filesystem::path fixture_directory = std::filesystem::temp_directory_path() / "computer_graphics_benchmark";
+	std::filesystem::create_directories(fixture_directory);
+	return fixture_directory;
+
+};
+
+//a rolling terrain of *n_points* points with colors, written as LAS 1.2 point format 2 with millimetre quantization
+static std::filesystem::path generate_LAS_fixture(const uint64_t& n_points) {
+
+	std::filesystem::path path_to_LASer_file = get_fixture_directory() / ("terrain_" + std::to_string(n_points) + ".las");
+	if (std::filesystem::is_regular_file(path_to_LASer_file)) { return path_to_LASer_file; };
+
+	const uint64_t side = std::max<uint64_t>(1, uint64_t(std::sqrt(double(n_points))));
+	std::vector<vec3> positions(n_points), colors(n_points);
+	for (uint64_t i = 0; i < n_points; i++) {
+
+		const float x = float(i % side), z = float(i / side);
+		positions[i] = vec3(x, 10.0f * std::sin(x * 0.05f) * std::cos(z * 0.05f), -z);
+		colors[i] = vec3(x / side, 0.5f, z / side);
+
+	};
+
+	LAS_Writer::Point_Range point_range = { positions.data(), colors.data(), n_points, {} };
+	point_range.frame.scale_factor = 1.0;
+	for (int axis = 0; axis < 3; axis++) { point_range.frame.quantization_scale[axis] = 0.001; };
+	if (!LAS_Writer::write(path_to_LASer_file, { point_range }, nullptr, nullptr, LAS_Writer::VERSION_1_2)) { exit(EXIT_FAILURE); };
+	return path_to_LASer_file;
+
+};
+
+//the per point std::ifstream reader against the serial and the multithreaded memory mapped readers
+static void benchmark_LAS_reading(const std::filesystem::path& path_to_LASer_file, const int& repeats) {
+
+	const double megabytes = std::filesystem::file_size(path_to_LASer_file) / (1024.0 * 1024.0);
+	std::cout << "LAS reading of " << path_to_LASer_file << " (" << megabytes << " MB), best of " << repeats << "\n";
+
+	auto read = [&](const uint8_t& READ_MODE) {
+
+		return time_best_of(repeats, [&]() {
+
+			Point_Cloud cloud;
+			std::vector<vec3> positions, colors;
+			cloud.extract_openGL_points_attributes(path_to_LASer_file, positions, colors, READ_MODE);
+
+		});
+
+	};
+	const double stream = read(Point_Cloud::READ_WITH_STREAM);
+	const double memory_map = read(Point_Cloud::READ_WITH_MEMORY_MAP);
+	const double memory_map_multithreaded = read(Point_Cloud::READ_WITH_MEMORY_MAP_MULTITHREADED);
+
+	std::cout << "LAS reading results:\n";
+	print_result("std::ifstream", stream, megabytes, stream);
+	print_result("memory map", memory_map, megabytes, stream);
+	print_result("memory map on " + std::to_string(Thread_Pool::shared().n_threads) + " threads", memory_map_multithreaded, megabytes, stream);
+
+};
+
+//a *side* by *side* grid of quads with positions, uvs and normals, written with the v/vt/vn face form
+static std::filesystem::path generate_OBJ_fixture(const uint64_t& n_faces) {
+
+	const uint64_t side = std::max<uint64_t>(1, uint64_t(std::sqrt(double(n_faces))));
+	std::filesystem::path path_to_OBJ_file = get_fixture_directory() / ("grid_" + std::to_string(side * side) + ".obj");
+	if (std::filesystem::is_regular_file(path_to_OBJ_file)) { return path_to_OBJ_file; };
+
+	std::ofstream file(path_to_OBJ_file, std::ios::trunc);
+	if (!file) { std::cerr << "ERROR: cant create the fixture " << path_to_OBJ_file << "!\n"; exit(EXIT_FAILURE); };
+
+	const uint64_t n_vertices_per_row = side + 1;
+	for (uint64_t z = 0; z < n_vertices_per_row; z++) {
+
+		for (uint64_t x = 0; x < n_vertices_per_row; x++) {
+
+			const float height = 10.0f * std::sin(x * 0.05f) * std::cos(z * 0.05f);
+			file << "v " << x * 0.5f << " " << height << " " << z * -0.5f << "\n";
+			file << "vt " << float(x) / side << " " << float(z) / side << "\n";
+			file << "vn 0 1 0\n";
+
+		};
+
+	};
+	for (uint64_t z = 0; z < side; z++) {
+
+		for (uint64_t x = 0; x < side; x++) {
+
+			const uint64_t A = z * n_vertices_per_row + x + 1, B = A + 1, C = A + n_vertices_per_row + 1, D = A + n_vertices_per_row;
+			file << "f " << A << "/" << A << "/" << A << " " << B << "/" << B << "/" << B << " " << C << "/" << C << "/" << C << " " << D << "/" << D << "/" << D << "\n";
+
+		};
+
+	};
+	return path_to_OBJ_file;
+
+};
+
+//the reader *Mesh::extract_from_OBJ_file* used before *OBJ_Parser*: the file is read into a vector of lines, faces are tokenised through std::istringstream and every number goes through
+//vsscanf. Kept here, parsing into the arrays *OBJ_Parser* fills, as the baseline
+static void parse_OBJ_by_line(const std::filesystem::path& path_to_OBJ_file, OBJ_Parser& parser) {
+
+	vec3 vec(0, 0, 0);
+	int v_index, vt_index, vn_index;
+	std::vector<OBJ_Parser::Corner> corners;
+	for (auto& line : read_file_by_line(path_to_OBJ_file)) {
+
+		std::string attribute_type = line.substr(0, 2);
+		if (attribute_type == "vn") {
+
+			safe_sscanf(line.c_str() + 3, "%f %f %f", 3, &vec.x, &vec.y, &vec.z);
+			parser.normals.emplace_back(vec.x, vec.y, vec.z);
+
+		}
+		else if (attribute_type == "vt") {
+
+			safe_sscanf(line.c_str() + 3, "%f %f", 2, &vec.x, &vec.y);
+			parser.texture_coordinates.emplace_back(vec.x, vec.y);
+
+		}
+		else if (attribute_type == "v ") {
+
+			safe_sscanf(line.c_str() + 2, "%f %f %f", 3, &vec.x, &vec.y, &vec.z);
+			parser.positions.emplace_back(vec.x, vec.y, vec.z);
+
+		}
+		else if (attribute_type == "f ") {
+
+			corners.clear();
+			for (auto& line_token : tokenise_data(line.substr(2), ' ')) {
+
+				if (line_token.find("//") != std::string::npos) {
+
+					safe_sscanf(line_token.c_str(), "%d//%d", 2, &v_index, &vn_index);
+					corners.push_back({ v_index - 1, -1, vn_index - 1 });
+
+				}
+				else {
+
+					safe_sscanf(line_token.c_str(), "%d/%d/%d", 3, &v_index, &vt_index, &vn_index);
+					corners.push_back({ v_index - 1, vt_index - 1, vn_index - 1 });
+
+				};
+
+			};
+			for (size_t i = 1; i + 1 < corners.size(); i++) {
+
+				parser.triangle_corners.push_back(corners[0]);
+				parser.triangle_corners.push_back(corners[i]);
+				parser.triangle_corners.push_back(corners[i + 1]);
+
+			};
+			parser.number_of_faces++;
+
+		};
+
+	};
+
+};
+
+//the line by line sscanf reader against *OBJ_Parser* over a memory map, serially and in parallel chunks. The three have to agree on what they parsed
+static void benchmark_OBJ_parsing(const std::filesystem::path& path_to_OBJ_file, const int& repeats) {
+
+	const double megabytes = std::filesystem::file_size(path_to_OBJ_file) / (1024.0 * 1024.0);
+	std::cout << "OBJ parsing of " << path_to_OBJ_file << " (" << megabytes << " MB), best of " << repeats << "\n";
+
+	OBJ_Parser by_line, serial, parallel;
+	const double line_time = time_best_of(repeats, [&]() { by_line = OBJ_Parser(); parse_OBJ_by_line(path_to_OBJ_file, by_line); });
+	const double serial_time = time_best_of(repeats, [&]() { serial = OBJ_Parser(); serial.parse(path_to_OBJ_file, OBJ_Parser::PARSE_SERIALLY); });
+	const double parallel_time = time_best_of(repeats, [&]() { parallel = OBJ_Parser(); parallel.parse(path_to_OBJ_file, OBJ_Parser::PARSE_IN_PARALLEL); });
+
+	for (const OBJ_Parser* parser : { &serial, &parallel }) {
+
+		if (parser->positions.size() != by_line.positions.size() || parser->triangle_corners.size() != by_line.triangle_corners.size() || parser->number_of_faces != by_line.number_of_faces) {
+
+			std::cerr << "ERROR: the OBJ parsers disagree on " << path_to_OBJ_file << "!\n";
+			exit(EXIT_FAILURE);
+
+		};
+
+	};
+
+	std::cout << "OBJ parsing results, " << by_line.number_of_faces << " faces:\n";
+	print_result("read_file_by_line + sscanf", line_time, megabytes, line_time);
+	print_result("OBJ_Parser serially", serial_time, megabytes, line_time);
+	print_result("OBJ_Parser on " + std::to_string(Thread_Pool::shared().n_threads) + " threads", parallel_time, megabytes, line_time);
+
+};
+
+//the corners of every triangle of a mesh, the vertices before they are deduplicated
+struct Corners {
+
+	std::vector<vec3> positions;
+	std::vector<vec3> normals;
+	std::vector<vec2> texture_coordinates;
+
+	void push_back(const vec3& position, const vec3& normal, const vec2& uv) { this->positions.push_back(position); this->normals.push_back(normal); this->texture_coordinates.push_back(uv); };
+
+};
+
+//the corners *Mesh::generate_terrain* adds for a *side* by *side* grid: two triangles, abc and bdc, per cell, on the plane z = -100 with the uvs spanning the grid
+static Corners generate_terrain_corners(const uint64_t& n_cells) {
+
+	const uint64_t side = std::max<uint64_t>(1, uint64_t(std::sqrt(double(n_cells))));
+	const vec3 normal(0.0f, 0.0f, 1.0f);
+	Corners corners;
+	auto add = [&](const float& x, const float& y) { corners.push_back(vec3(x - side * 0.5f, y - side * 0.5f, -100.0f), normal, vec2(x / side, y / side)); };
+	for (uint64_t y = 0; y < side; y++) {
+
+		for (uint64_t x = 0; x < side; x++) {
+
+			add(x, y + 1); add(x, y); add(x + 1, y + 1);
+			add(x, y); add(x + 1, y); add(x + 1, y + 1);
+
+		};
+
+	};
+	return corners;
+
+};
+
+//the corners *Mesh::extract_from_OBJ_file* adds for the triangles of an OBJ file
+static Corners read_OBJ_corners(const std::filesystem::path& path_to_OBJ_file) {
+
+	OBJ_Parser parser;
+	parser.parse(path_to_OBJ_file);
+	Corners corners;
+	for (const OBJ_Parser::Corner& corner : parser.triangle_corners) {
+
+		corners.push_back(parser.positions[corner.position], corner.normal >= 0 ? parser.normals[corner.normal] : vec3(0.0f, 0.0f, 0.0f), corner.texture_coordinates >= 0 ? parser.texture_coordinates[corner.texture_coordinates] : vec2(0.0f, 0.0f));
+
+	};
+	return corners;
+
+};
+
+//the hasher of the std::unordered_map *Mesh* deduplicated its vertices with before *Vertex_Deduplicator*
+struct vec3_vec3_vec2_hasher {
+
+	std::size_t operator()(const std::tuple<vec3, vec3, vec2>& tuple) const {
+
+		std::size_t seed = vec3_hasher()(std::get<0>(tuple));
+		seed = hash_combine(seed, vec3_hasher()(std::get<1>(tuple)));
+		seed = hash_combine(seed, vec2_hasher()(std::get<2>(tuple)));
+		return seed;
+
+	};
+
+};
+
+//the old std::unordered_map against the flat table and the parallel sorting of *Vertex_Deduplicator*, each numbering the unique vertices in the order they first appear.
+//The map stores 32 bit values here instead of the unsigned short it used to, so its count isnt wrapped and the three can be checked against each other
+static void benchmark_vertex_deduplication(const std::string& input_name, const Corners& corners, const int& repeats) {
+
+	const size_t n_corners = corners.positions.size();
+	const double megabytes = n_corners * sizeof(Vertex_Deduplicator::Key) / (1024.0 * 1024.0);
+	std::cout << "vertex deduplication of " << input_name << " (" << n_corners << " corners), best of " << repeats << "\n";
+
+	size_t map_unique = 0, table_unique = 0, sorting_unique = 0;
+	const double map_time = time_best_of(repeats, [&]() {
+
+		std::unordered_map<std::tuple<vec3, vec3, vec2>, uint32_t, vec3_vec3_vec2_hasher> vertices_map;
+		for (size_t i = 0; i < n_corners; i++) {
+
+			auto key = std::make_tuple(corners.positions[i], corners.normals[i], corners.texture_coordinates[i]);
+			if (vertices_map.find(key) == vertices_map.end()) { vertices_map[key] = uint32_t(vertices_map.size()); };
+
+		};
+		map_unique = vertices_map.size();
+
+	});
+	const double table_time = time_best_of(repeats, [&]() {
+
+		Vertex_Deduplicator vertices_table;
+		vertices_table.reserve(n_corners);
+		bool inserted = false;
+		for (size_t i = 0; i < n_corners; i++) {
+
+			vertices_table.find_or_insert(Vertex_Deduplicator::Key(corners.positions[i], corners.normals[i], corners.texture_coordinates[i]), uint32_t(vertices_table.size()), inserted);
+
+		};
+		table_unique = vertices_table.size();
+
+	});
+	const double sorting_time = time_best_of(repeats, [&]() {
+
+		std::vector<Vertex_Deduplicator::Key> keys(n_corners);
+		for (size_t i = 0; i < n_corners; i++) { keys[i] = Vertex_Deduplicator::Key(corners.positions[i], corners.normals[i], corners.texture_coordinates[i]); };
+		std::vector<uint32_t> unique_indices, first_occurrences;
+		sorting_unique = Vertex_Deduplicator::deduplicate_by_sorting(keys, unique_indices, first_occurrences);
+
+	});
+
+	if (map_unique != table_unique || map_unique != sorting_unique) {
+
+		std::cerr << "ERROR: the deduplications disagree on " << input_name << ": " << map_unique << ", " << table_unique << " and " << sorting_unique << " unique vertices!\n";
+		exit(EXIT_FAILURE);
+
+	};
+
+	std::cout << "vertex deduplication results, " << map_unique << " unique vertices:\n";
+	print_result("std::unordered_map", map_time, megabytes, map_time);
+	print_result("flat table", table_time, megabytes, map_time);
+	print_result("sorting on " + std::to_string(Thread_Pool::shared().n_threads) + " threads", sorting_time, megabytes, map_time);
+
+};
+
+int main(int argc, char** argv) {
+
+	const std::string benchmark = argc > 1 ? argv[1] : "";
+	const std::string input = argc > 2 ? argv[2] : "";
+	const int repeats = argc > 3 ? std::max(1, std::atoi(argv[3])) : 3;
+
+	//an input made only of digits is the size of the fixture to generate
+	const bool input_is_size = !input.empty() && std::all_of(input.begin(), input.end(), [](const char& character) { return character >= '0' && character <= '9'; });
+
+	if (benchmark == "las") {
+
+		benchmark_LAS_reading(input.empty() || input_is_size ? generate_LAS_fixture(input_is_size ? std::stoull(input) : 2000000) : std::filesystem::path(input), repeats);
+
+	}
+	else if (benchmark == "obj") {
+
+		benchmark_OBJ_parsing(input.empty() || input_is_size ? generate_OBJ_fixture(input_is_size ? std::stoull(input) : 250000) : std::filesystem::path(input), repeats);
+
+	}
+	else if (benchmark == "dedup") {
+
+		//without a file both the terrain and the OBJ grid of the same number of cells are deduplicated
+		if (!input.empty() && !input_is_size) { benchmark_vertex_deduplication(input, read_OBJ_corners(input), repeats); }
+		else {
+
+			const uint64_t n_cells = input_is_size ? std::stoull(input) : 360000;
+			benchmark_vertex_deduplication("terrain", generate_terrain_corners(n_cells), repeats);
+			const std::filesystem::path path_to_OBJ_file = generate_OBJ_fixture(n_cells);
+			benchmark_vertex_deduplication(path_to_OBJ_file.string(), read_OBJ_corners(path_to_OBJ_file), repeats);
+
+		};
+
+	}
+	else {
+
+		std::cerr << "ERROR: usage: " << argv[0] << " las|obj|dedup [input file | size of the generated fixture] [repeats]\n";
+		return EXIT_FAILURE;
+
+	};
+	return EXIT_SUCCESS;
+
+};
@@ -0,0 +1,156 @@
+#include "computer_graphics/COPC.h"
+
+COPC_Reader::COPC_Reader(const std::filesystem::path& path_to_COPC_file) : file(path_to_COPC_file) {
+
+	if (this->file.size < sizeof(this->header) || std::string(this->file.data, 4) != "LASF") { std::cerr << "ERROR: " << path_to_COPC_file << " is not a valid LAS file!\n"; exit(EXIT_FAILURE); };
+	if (this->file.data[24] != 1 || this->file.data[25] != 4) { std::cerr << "ERROR: COPC files have to be LAS 1.4!\n"; exit(EXIT_FAILURE); };
+
+	this->header = this->cloud.read_header_from_memory<Point_Cloud::Public_Header_Block_Version_1_4>(this->file);
+	if (this->header.point_data_record_format < 6 || this->header.point_data_record_format > 8) { std::cerr << "ERROR: COPC files have to use point data record format 6, 7 or 8, not " << static_cast<int>(this->header.point_data_record_format) << "!\n"; exit(EXIT_FAILURE); };
+	this->cloud.extract_members_data(this->header);
+	this->cloud.read_variable_length_records(this->header, this->file);
+	this->number_of_point_records = this->header.number_of_point_records;
+
+	const std::vector<Point_Cloud::Variable_Length_Record>& records = this->cloud.variable_length_records;
+	if (records.empty() || records[0].user_ID != "copc" || records[0].record_ID != 1 || records[0].record_length < sizeof(COPC_Info)) { std::cerr << "ERROR: " << path_to_COPC_file << " has no COPC info VLR, it isnt a COPC file!\n"; exit(EXIT_FAILURE); };
+	std::memcpy(&this->info, this->file.data + records[0].offset_to_data, sizeof(COPC_Info));
+
+	//every node is a chunk of its own, so only the item layout of the LASzip VLR is needed and its chunk table is never read
+	auto laszip_record = std::find_if(records.begin(), records.end(), [](const Point_Cloud::Variable_Length_Record& record) { return record.user_ID == "laszip encoded" && record.record_ID == 22204; });
+	if (laszip_record == records.end()) { std::cerr << "ERROR: COPC file has no LASzip VLR!\n"; exit(EXIT_FAILURE); };
+	this->LAZ_decoder = std::make_unique<LAZ_Decoder>(this->file.data + laszip_record->offset_to_data, laszip_record->record_length, this->header.point_data_record_length);
+
+	this->load_hierarchy_page(this->info.root_hierarchy_offset, this->info.root_hierarchy_size);
+
+};
+
+void COPC_Reader::load_hierarchy_page(const uint64_t& offset, const uint64_t& byte_size) {
+
+	if (offset > this->file.size || byte_size > this->file.size - offset) { std::cerr << "WARNING: COPC hierarchy page at " << offset << " exceeds the file size, ignoring it!\n"; return; };
+	if (byte_size % sizeof(Hierarchy_Entry) != 0) { std::cerr << "WARNING: COPC hierarchy page size " << byte_size << " isnt a multiple of " << sizeof(Hierarchy_Entry) << "!\n"; };
+
+	const uint64_t n_entries = byte_size / sizeof(Hierarchy_Entry);
+	for (uint64_t i = 0; i < n_entries; i++) {
+
+		Hierarchy_Entry entry;
+		std::memcpy(&entry, this->file.data + offset + i * sizeof(Hierarchy_Entry), sizeof(Hierarchy_Entry));
+		this->hierarchy[entry.key] = entry;
+
+	};
+
+};
+
+const COPC_Reader::Hierarchy_Entry* COPC_Reader::get_hierarchy_entry(const Voxel_Key& key) {
+
+	auto entry = this->hierarchy.find(key);
+	if (entry == this->hierarchy.end()) { return nullptr; };
+	if (entry->second.point_count != CHILD_HIERARCHY_PAGE) { return &entry->second; };
+
+	//the child page holds the real entry of the key, which replaces the reference to the page
+	const Hierarchy_Entry page = entry->second;
+	this->hierarchy.erase(entry);
+	this->load_hierarchy_page(page.offset, static_cast<uint64_t>(page.byte_size));
+
+	entry = this->hierarchy.find(key);
+	if (entry == this->hierarchy.end() || entry->second.point_count == CHILD_HIERARCHY_PAGE) { std::cerr << "WARNING: COPC hierarchy page at " << page.offset << " doesnt hold the node " << key.level << "-" << key.x << "-" << key.y << "-" << key.z << "!\n"; return nullptr; };
+	return &entry->second;
+
+};
+
+std::pair<vec3, vec3> COPC_Reader::get_openGL_bounds(const Voxel_Key& key) const {
+
+	//the cube of the node in geospatial space, then both corners moved into openGL space where the Y to Z flip swaps which corner holds the minimum
+	const double size = 2.0 * this->info.halfsize / static_cast<double>(uint64_t(1) << key.level);
+	const double minimum_x = this->info.center_x - this->info.halfsize + key.x * size;
+	const double minimum_y = this->info.center_y - this->info.halfsize + key.y * size;
+	const double minimum_z = this->info.center_z - this->info.halfsize + key.z * size;
+
+	vec3 A = this->cloud.compute_openGL_coordinates(minimum_x, minimum_y, minimum_z);
+	vec3 B = this->cloud.compute_openGL_coordinates(minimum_x + size, minimum_y + size, minimum_z + size);
+	return { vec3(std::min(A.x, B.x), std::min(A.y, B.y), std::min(A.z, B.z)), vec3(std::max(A.x, B.x), std::max(A.y, B.y), std::max(A.z, B.z)) };
+
+};
+
+std::pair<vec3, vec3> COPC_Reader::get_openGL_bounds() const {
+
+	return this->get_openGL_bounds(Voxel_Key{ 0, 0, 0, 0 });
+
+};
+
+std::vector<COPC_Reader::Node> COPC_Reader::query(const int32_t& max_depth, const std::function<bool(const vec3& minimum, const vec3& maximum)>& intersects) {
+
+	std::vector<Node> nodes;
+	std::vector<Voxel_Key> stack = { Voxel_Key{ 0, 0, 0, 0 } };
+	while (!stack.empty()) {
+
+		Voxel_Key key = stack.back();
+		stack.pop_back();
+
+		//keys without an entry have no points in their whole subtree
+		const Hierarchy_Entry* entry = this->get_hierarchy_entry(key);
+		if (entry == nullptr) { continue; };
+
+		std::pair<vec3, vec3> bounds = this->get_openGL_bounds(key);
+		if (!intersects(bounds.first, bounds.second)) { continue; };
+
+		//nodes without points can still have children
+		if (entry->point_count > 0) { nodes.push_back({ *entry, bounds.first, bounds.second }); };
+		if (key.level < max_depth) {
+
+			for (int i = 7; i >= 0; i--) { stack.push_back(key.get_child(i)); };
+
+		};
+
+	};
+
+	return nodes;
+
+};
+
+std::vector<COPC_Reader::Node> COPC_Reader::query_box(const vec3& minimum, const vec3& maximum, const int32_t& max_depth) {
+
+	return this->query(max_depth, [&](const vec3& node_minimum, const vec3& node_maximum) {
+
+		return node_minimum.x <= maximum.x && node_maximum.x >= minimum.x && node_minimum.y <= maximum.y && node_maximum.y >= minimum.y && node_minimum.z <= maximum.z && node_maximum.z >= minimum.z;
+
+	});
+
+};
+
+std::vector<COPC_Reader::Node> COPC_Reader::query_frustum(const mat4& view_projection, const int32_t& max_depth) {
+
+	Frustum frustum(view_projection);
+	return this->query(max_depth, [&](const vec3& node_minimum, const vec3& node_maximum) { return frustum.intersects_box(node_minimum, node_maximum); });
+
+};
+
+void COPC_Reader::decode_nodes(const std::vector<Node>& nodes, std::vector<vec3>& positions, std::vector<vec3>& colors) {
+
+	//where the points of every node start in the outputs
+	std::vector<uint64_t> first_points(nodes.size() + 1, 0);
+	for (size_t i = 0; i < nodes.size(); i++) {
+
+		const Hierarchy_Entry& entry = nodes[i].entry;
+		if (entry.offset > this->file.size || static_cast<uint64_t>(entry.byte_size) > this->file.size - entry.offset) { std::cerr << "ERROR: COPC node " << entry.key.level << "-" << entry.key.x << "-" << entry.key.y << "-" << entry.key.z << " exceeds the file size!\n"; exit(EXIT_FAILURE); };
+		first_points[i + 1] = first_points[i] + static_cast<uint64_t>(entry.point_count);
+
+	};
+	positions.resize(first_points.back());
+	colors.resize(first_points.back());
+
+	Thread_Pool::shared().parallel_for(nodes.size(), 1, [&](const size_t& first, const size_t& last) {
+
+		std::vector<char> records;
+		for (size_t i = first; i < last; i++) {
+
+			const Hierarchy_Entry& entry = nodes[i].entry;
+			const uint64_t n_points = static_cast<uint64_t>(entry.point_count);
+			records.resize(n_points * this->header.point_data_record_length);
+			this->LAZ_decoder->decompress_chunk(this->file.data + entry.offset, static_cast<uint64_t>(entry.byte_size), n_points, 0, n_points, records.data());
+			this->cloud.decode_points_and_extract_openGL_attributes(this->header, records.data(), 0, n_points, positions.data() + first_points[i], colors.data() + first_points[i]);
+
+		};
+
+	});
+
+};
@@ -1 +1,120 @@
-#include "computer_graphics/File.h"
\ No newline at end of file
+#include "computer_graphics/File.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+Memory_Mapped_File::Memory_Mapped_File(const std::filesystem::path& file_path) : data(nullptr), size(0), file_handle(nullptr), mapping_handle(nullptr) {
+
+	exit_if_file_doesnt_exist(file_path);
+	if (check_if_directory(file_path)) { std::cerr << "ERROR: path " << file_path << " is a directory and cant be memory mapped!\n"; exit(EXIT_FAILURE); };
+
+	this->size = std::filesystem::file_size(file_path);
+	if (this->size == 0) { return; };//nothing to map, *data* stays null
+
+#ifdef _WIN32
+	HANDLE file = CreateFileW(file_path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (file == INVALID_HANDLE_VALUE) { std::cerr << "ERROR: failed to open file " << file_path << " for memory mapping!\n"; exit(EXIT_FAILURE); };
+
+	HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping == NULL) { CloseHandle(file); std::cerr << "ERROR: failed to create file mapping for " << file_path << "!\n"; exit(EXIT_FAILURE); };
+
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (view == NULL) { CloseHandle(mapping); CloseHandle(file); std::cerr << "ERROR: failed to map view of file " << file_path << "!\n"; exit(EXIT_FAILURE); };
+
+	this->file_handle = file;
+	this->mapping_handle = mapping;
+	this->data = static_cast<const char*>(view);
+#else
+	int file = open(file_path.c_str(), O_RDONLY);
+	if (file == -1) { std::cerr << "ERROR: failed to open file " << file_path << " for memory mapping!\n"; exit(EXIT_FAILURE); };
+
+	void* view = mmap(nullptr, this->size, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);//the mapping keeps its own reference to the file, so the descriptor isnt needed anymore
+	if (view == MAP_FAILED) { std::cerr << "ERROR: failed to memory map file " << file_path << "!\n"; exit(EXIT_FAILURE); };
+
+	//records are decoded front to back, so we let the kernel read ahead aggressively
+	madvise(view, this->size, MADV_SEQUENTIAL);
+	this->data = static_cast<const char*>(view);
+#endif
+
+};
+
+void Memory_Mapped_File::discard(const size_t& offset, const size_t& n_bytes) const {
+
+	if (this->data == nullptr || offset >= this->size) { return; };
+
+#ifndef _WIN32
+	//only whole pages inside the range can be released
+	static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+	size_t first_page = (offset + page_size - 1) / page_size * page_size;
+	size_t end = std::min(offset + n_bytes, this->size) / page_size * page_size;
+	if (end > first_page) { madvise(const_cast<char*>(this->data) + first_page, end - first_page, MADV_DONTNEED); };
+#endif
+	//windows trims the working set of file backed views on its own, there is no cheap equivalent to call here
+
+};
+
+Memory_Mapped_File::Memory_Mapped_File(Memory_Mapped_File&& other) noexcept : data(other.data), size(other.size), file_handle(other.file_handle), mapping_handle(other.mapping_handle) {
+
+	//nullify the moved-from object so it doesnt unmap our view
+	other.data = nullptr;
+	other.size = 0;
+	other.file_handle = nullptr;
+	other.mapping_handle = nullptr;
+
+};
+
+Memory_Mapped_File& Memory_Mapped_File::operator=(Memory_Mapped_File&& other) noexcept {
+
+	if (this != &other) {
+
+		this->unmap();
+
+		this->data = other.data;
+		this->size = other.size;
+		this->file_handle = other.file_handle;
+		this->mapping_handle = other.mapping_handle;
+
+		other.data = nullptr;
+		other.size = 0;
+		other.file_handle = nullptr;
+		other.mapping_handle = nullptr;
+
+	};
+
+	return *this;
+
+};
+
+Memory_Mapped_File::~Memory_Mapped_File() {
+
+	this->unmap();
+
+};
+
+void Memory_Mapped_File::unmap() {
+
+	if (this->data == nullptr) { return; };
+
+#ifdef _WIN32
+	UnmapViewOfFile(this->data);
+	CloseHandle(static_cast<HANDLE>(this->mapping_handle));
+	CloseHandle(static_cast<HANDLE>(this->file_handle));
+#else
+	munmap(const_cast<char*>(this->data), this->size);
+#endif
+
+	this->data = nullptr;
+	this->size = 0;
+	this->file_handle = nullptr;
+	this->mapping_handle = nullptr;
+
+};
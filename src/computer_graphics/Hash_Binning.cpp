@@ -0,0 +1,11 @@
+#include "computer_graphics/Hash_Binning.h"
+
+uint64_t Hash_Binning::mix(uint64_t value) {
+
+	//splitmix64 finalizer
+	value += 0x9e3779b97f4a7c15ull;
+	value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+	value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+	return value ^ (value >> 31);
+
+};
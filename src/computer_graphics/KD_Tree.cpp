@@ -0,0 +1,360 @@
+#include "computer_graphics/KD_Tree.h"
+
+void KD_Tree::build() {
+
+	auto start = std::chrono::steady_clock::now();
+
+	//the shape of the tree: enough levels that no leaf holds more than *MAX_POINTS_PER_LEAF* points
+	this->n_levels = 0;
+	while (((this->number_of_points + (uint64_t(1) << this->n_levels) - 1) >> this->n_levels) > MAX_POINTS_PER_LEAF) {
+
+		++this->n_levels;
+
+	};
+	this->nodes.resize((size_t(1) << this->n_levels) - 1);
+
+	//one level at a time, the nodes of a level own disjoint ranges of the points so they are split in parallel
+	struct Cell {
+
+		size_t first;
+		size_t last;
+		vec3 minimum;
+		vec3 maximum;
+
+	};
+	std::vector<Cell> level = { { 0, this->points.size(), this->minimum_bounds, this->maximum_bounds } };
+	std::vector<Cell> next_level;
+	for (uint32_t depth = 0; depth < this->n_levels; ++depth) {
+
+		const size_t first_node = (size_t(1) << depth) - 1;
+		next_level.resize(2 * level.size());
+		Thread_Pool::shared().parallel_for(level.size(), 1, [&](const size_t& first, const size_t& last) {
+
+			for (size_t i = first; i < last; ++i) {
+
+				const Cell& cell = level[i];
+				const vec3 extent = cell.maximum - cell.minimum;
+				const uint8_t axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : extent.y >= extent.z ? 1 : 2;
+
+				const size_t middle = get_middle(cell.first, cell.last);
+
+				//one comparison per axis, so the axis isnt branched on for every comparison
+				std::vector<Indexed_Point>::iterator begin = this->points.begin() + cell.first, nth = this->points.begin() + middle, end = this->points.begin() + cell.last;
+				if (axis == 0) { std::nth_element(begin, nth, end, [](const Indexed_Point& a, const Indexed_Point& b) { return a.position.x < b.position.x; }); }
+				else if (axis == 1) { std::nth_element(begin, nth, end, [](const Indexed_Point& a, const Indexed_Point& b) { return a.position.y < b.position.y; }); }
+				else { std::nth_element(begin, nth, end, [](const Indexed_Point& a, const Indexed_Point& b) { return a.position.z < b.position.z; }); };
+				const float split = get_coordinate(this->points[middle].position, axis);
+				this->nodes[first_node + i] = { split, axis };
+
+				//the points left of the middle are at most *split* and the ones right of it at least *split*
+				Cell left = { cell.first, middle, cell.minimum, cell.maximum };
+				Cell right = { middle, cell.last, cell.minimum, cell.maximum };
+				set_coordinate(left.maximum, axis, split);
+				set_coordinate(right.minimum, axis, split);
+				next_level[2 * i] = left;
+				next_level[2 * i + 1] = right;
+
+			};
+
+		});
+		std::swap(level, next_level);
+
+	};
+
+	std::chrono::duration<double> elapsed_time = std::chrono::steady_clock::now() - start;
+	std::cout << "built a k-d tree of " << this->n_levels << " levels over " << this->number_of_points << " points in " << elapsed_time.count() * 1000.0 << " ms\n";
+
+};
+
+std::vector<uint32_t> KD_Tree::radius_search(const vec3& center, const float& radius) const {
+
+	std::vector<uint32_t> indices;
+	if (this->points.empty() || radius < 0.0f) { return indices; };
+
+	this->radius_search(0, 0, this->points.size(), center, radius * radius, indices);
+	return indices;
+
+};
+
+void KD_Tree::radius_search(const uint32_t& node, const size_t& first, const size_t& last, const vec3& center, const float& squared_radius, std::vector<uint32_t>& indices) const {
+
+	if (node >= this->nodes.size()) {
+
+		for (size_t i = first; i < last; ++i) {
+
+			const vec3 offset = this->points[i].position - center;
+			if (offset.dot(offset) <= squared_radius) { indices.push_back(this->points[i].index); };
+
+		};
+		return;
+
+	};
+
+	const Node& split_node = this->nodes[node];
+	const size_t middle = get_middle(first, last);
+	const float distance_to_split = get_coordinate(center, split_node.axis) - split_node.split;
+	if (distance_to_split <= 0.0f) {
+
+		this->radius_search(2 * node + 1, first, middle, center, squared_radius, indices);
+		if (distance_to_split * distance_to_split <= squared_radius) { this->radius_search(2 * node + 2, middle, last, center, squared_radius, indices); };
+
+	}
+	else {
+
+		this->radius_search(2 * node + 2, middle, last, center, squared_radius, indices);
+		if (distance_to_split * distance_to_split <= squared_radius) { this->radius_search(2 * node + 1, first, middle, center, squared_radius, indices); };
+
+	};
+
+};
+
+std::vector<uint32_t> KD_Tree::k_nearest(const vec3& point, const size_t& k, std::vector<float>* squared_distances) const {
+
+	std::vector<std::pair<float, uint32_t>> nearest;
+	if (k > 0 && !this->points.empty()) {
+
+		nearest.reserve(std::min<uint64_t>(k, this->number_of_points));
+		this->k_nearest(0, 0, this->points.size(), point, k, nearest);
+
+	};
+
+	std::vector<uint32_t> indices(nearest.size());
+	if (squared_distances) { squared_distances->resize(nearest.size()); };
+	for (size_t i = 0; i < nearest.size(); ++i) {
+
+		indices[i] = this->points[nearest[i].second].index;
+		if (squared_distances) { (*squared_distances)[i] = nearest[i].first; };
+
+	};
+	return indices;
+
+};
+
+void KD_Tree::k_nearest(const uint32_t& node, const size_t& first, const size_t& last, const vec3& point, const size_t& k, std::vector<std::pair<float, uint32_t>>& nearest) const {
+
+	if (node >= this->nodes.size()) {
+
+		for (size_t i = first; i < last; ++i) {
+
+			const vec3 offset = this->points[i].position - point;
+			const float squared_distance = offset.dot(offset);
+			if (nearest.size() == k && squared_distance >= nearest.back().first) { continue; };
+
+			//insertion into the sorted list, which beats a heap for the few neighbours these queries ask for
+			if (nearest.size() < k) { nearest.emplace_back(squared_distance, uint32_t(i)); }
+			else { nearest.back() = { squared_distance, uint32_t(i) }; };
+			for (size_t j = nearest.size() - 1; j > 0 && nearest[j - 1].first > nearest[j].first; --j) {
+
+				std::swap(nearest[j - 1], nearest[j]);
+
+			};
+
+		};
+		return;
+
+	};
+
+	const Node& split_node = this->nodes[node];
+	const size_t middle = get_middle(first, last);
+	const float distance_to_split = get_coordinate(point, split_node.axis) - split_node.split;
+	const uint32_t near_child = distance_to_split <= 0.0f ? 2 * node + 1 : 2 * node + 2;
+	const uint32_t far_child = distance_to_split <= 0.0f ? 2 * node + 2 : 2 * node + 1;
+
+	this->k_nearest(near_child, near_child == 2 * node + 1 ? first : middle, near_child == 2 * node + 1 ? middle : last, point, k, nearest);
+
+	//the far side can only hold closer points while the heap isnt full or the split plane is closer than the farthest point kept
+	if (nearest.size() < k || distance_to_split * distance_to_split < nearest.back().first) {
+
+		this->k_nearest(far_child, far_child == 2 * node + 1 ? first : middle, far_child == 2 * node + 1 ? middle : last, point, k, nearest);
+
+	};
+
+};
+
+void KD_Tree::for_each_neighbourhood(const size_t& k, const std::function<void(const uint32_t& index, const std::vector<vec3>& neighbours)>& visit) const {
+
+	if (k == 0 || this->points.size() < 2) { return; };
+
+	//the point itself is always the first of its k + 1 nearest points
+	const size_t n_neighbours = std::min<size_t>(k, this->points.size() - 1);
+	Thread_Pool::shared().parallel_for(this->points.size(), POINTS_PER_TASK, [&](const size_t& first, const size_t& last) {
+
+		std::vector<std::pair<float, uint32_t>> nearest;
+		std::vector<vec3> neighbours;
+		nearest.reserve(n_neighbours + 1);
+		neighbours.reserve(n_neighbours);
+		for (size_t i = first; i < last; ++i) {
+
+			nearest.clear();
+			neighbours.clear();
+			this->k_nearest(0, 0, this->points.size(), this->points[i].position, n_neighbours + 1, nearest);
+			for (size_t j = 1; j < nearest.size(); ++j) {
+
+				neighbours.push_back(this->points[nearest[j].second].position - this->points[i].position);
+
+			};
+			visit(this->points[i].index, neighbours);
+
+		};
+
+	});
+
+};
+
+std::vector<float> KD_Tree::compute_mean_neighbour_distances(const size_t& k) const {
+
+	std::vector<float> mean_distances(this->points.size(), 0.0f);
+	this->for_each_neighbourhood(k, [&](const uint32_t& index, const std::vector<vec3>& neighbours) {
+
+		float sum = 0.0f;
+		for (const vec3& neighbour : neighbours) {
+
+			sum += std::sqrt(neighbour.dot(neighbour));
+
+		};
+		mean_distances[index] = sum / float(neighbours.size());
+
+	});
+	return mean_distances;
+
+};
+
+bool KD_Tree::ray_nearest(const vec3& origin, const vec3& direction, const float& radius, uint32_t& index, float* distance) const {
+
+	const float length = std::sqrt(direction.dot(direction));
+	if (this->points.empty() || length == 0.0f || radius < 0.0f) { return false; };
+
+	const vec3 unit_direction = direction / length;
+	const vec3 inverse_direction(1.0f / unit_direction.x, 1.0f / unit_direction.y, 1.0f / unit_direction.z);
+	float best_distance = std::numeric_limits<float>::infinity();
+	uint32_t best_index = 0;
+	this->ray_nearest(0, 0, this->points.size(), this->minimum_bounds, this->maximum_bounds, origin, unit_direction, inverse_direction, radius, best_distance, best_index);
+	if (best_distance == std::numeric_limits<float>::infinity()) { return false; };
+
+	index = best_index;
+	if (distance) { *distance = best_distance; };
+	return true;
+
+};
+
+void KD_Tree::ray_nearest(const uint32_t& node, const size_t& first, const size_t& last, vec3 cell_minimum, vec3 cell_maximum, const vec3& origin, const vec3& direction, const vec3& inverse_direction, const float& radius, float& best_distance, uint32_t& best_index) const {
+
+	//every point within *radius* of the ray has its foot on the ray inside the cell grown by *radius*, so the slab test of the grown cell bounds the distances the node can offer
+	float entry = 0.0f;
+	float exit = best_distance;
+	for (uint8_t axis = 0; axis < 3; ++axis) {
+
+		const float minimum = get_coordinate(cell_minimum, axis) - radius;
+		const float maximum = get_coordinate(cell_maximum, axis) + radius;
+		const float origin_coordinate = get_coordinate(origin, axis);
+		if (get_coordinate(direction, axis) == 0.0f) {
+
+			if (origin_coordinate < minimum || origin_coordinate > maximum) { return; };
+			continue;
+
+		};
+
+		float near_distance = (minimum - origin_coordinate) * get_coordinate(inverse_direction, axis);
+		float far_distance = (maximum - origin_coordinate) * get_coordinate(inverse_direction, axis);
+		if (near_distance > far_distance) { std::swap(near_distance, far_distance); };
+		entry = std::max(entry, near_distance);
+		exit = std::min(exit, far_distance);
+		if (entry > exit) { return; };
+
+	};
+
+	if (node >= this->nodes.size()) {
+
+		const float squared_radius = radius * radius;
+		for (size_t i = first; i < last; ++i) {
+
+			const vec3 offset = this->points[i].position - origin;
+			const float distance_along_ray = offset.dot(direction);
+			if (distance_along_ray < 0.0f || distance_along_ray >= best_distance) { continue; };
+			if (offset.dot(offset) - distance_along_ray * distance_along_ray <= squared_radius) {
+
+				best_distance = distance_along_ray;
+				best_index = this->points[i].index;
+
+			};
+
+		};
+		return;
+
+	};
+
+	const Node& split_node = this->nodes[node];
+	const size_t middle = get_middle(first, last);
+	vec3 left_maximum = cell_maximum;
+	vec3 right_minimum = cell_minimum;
+	set_coordinate(left_maximum, split_node.axis, split_node.split);
+	set_coordinate(right_minimum, split_node.axis, split_node.split);
+
+	//the child the ray enters first usually holds the answer, which then prunes the other one
+	if (get_coordinate(direction, split_node.axis) >= 0.0f) {
+
+		this->ray_nearest(2 * node + 1, first, middle, cell_minimum, left_maximum, origin, direction, inverse_direction, radius, best_distance, best_index);
+		this->ray_nearest(2 * node + 2, middle, last, right_minimum, cell_maximum, origin, direction, inverse_direction, radius, best_distance, best_index);
+
+	}
+	else {
+
+		this->ray_nearest(2 * node + 2, middle, last, right_minimum, cell_maximum, origin, direction, inverse_direction, radius, best_distance, best_index);
+		this->ray_nearest(2 * node + 1, first, middle, cell_minimum, left_maximum, origin, direction, inverse_direction, radius, best_distance, best_index);
+
+	};
+
+};
+
+KD_Tree::KD_Tree(const vec3* positions, const size_t& n_points) : number_of_points(n_points), n_levels(0) {
+
+	if (n_points > UINT32_MAX) {
+
+		std::cerr << "ERROR: cannot build a k-d tree over " << n_points << " points, at most " << UINT32_MAX << " are supported\n";
+		exit(EXIT_FAILURE);
+
+	};
+
+	this->minimum_bounds = vec3(0.0f, 0.0f, 0.0f);
+	this->maximum_bounds = vec3(0.0f, 0.0f, 0.0f);
+	if (n_points == 0) { return; };
+
+	//copies the points and finds their bounds chunk by chunk
+	const size_t n_chunks = (n_points + POINTS_PER_TASK - 1) / POINTS_PER_TASK;
+	std::vector<std::pair<vec3, vec3>> chunk_bounds(n_chunks);
+	this->points.resize(n_points);
+	Thread_Pool::shared().parallel_for(n_chunks, 1, [&](const size_t& first, const size_t& last) {
+
+		for (size_t chunk = first; chunk < last; ++chunk) {
+
+			const size_t end = std::min(n_points, (chunk + 1) * POINTS_PER_TASK);
+			vec3 minimum = positions[chunk * POINTS_PER_TASK];
+			vec3 maximum = minimum;
+			for (size_t i = chunk * POINTS_PER_TASK; i < end; ++i) {
+
+				const vec3& position = positions[i];
+				minimum = vec3(std::min(minimum.x, position.x), std::min(minimum.y, position.y), std::min(minimum.z, position.z));
+				maximum = vec3(std::max(maximum.x, position.x), std::max(maximum.y, position.y), std::max(maximum.z, position.z));
+				this->points[i] = { position, uint32_t(i) };
+
+			};
+			chunk_bounds[chunk] = { minimum, maximum };
+
+		};
+
+	});
+
+	this->minimum_bounds = chunk_bounds[0].first;
+	this->maximum_bounds = chunk_bounds[0].second;
+	for (const std::pair<vec3, vec3>& bounds : chunk_bounds) {
+
+		this->minimum_bounds = vec3(std::min(this->minimum_bounds.x, bounds.first.x), std::min(this->minimum_bounds.y, bounds.first.y), std::min(this->minimum_bounds.z, bounds.first.z));
+		this->maximum_bounds = vec3(std::max(this->maximum_bounds.x, bounds.second.x), std::max(this->maximum_bounds.y, bounds.second.y), std::max(this->maximum_bounds.z, bounds.second.z));
+
+	};
+
+	this->build();
+
+};
+
+KD_Tree::KD_Tree(const std::vector<vec3>& positions) : KD_Tree(positions.data(), positions.size()) {};
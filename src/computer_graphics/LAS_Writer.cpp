@@ -0,0 +1,231 @@
+#include "computer_graphics/LAS_Writer.h"
+
+template<typename Public_Header_Block_Version_X_X, typename Point_Data_Record_Format_X>
+bool LAS_Writer::write_points(std::ofstream& file, const std::vector<Point_Range>& point_ranges, const std::vector<uint64_t>& range_starts, const Point_Cloud::Point_Attributes* point_attributes, const std::vector<uint64_t>* selection,
+	const uint64_t& n_points, const uint8_t& version_minor, const uint8_t& point_data_record_format, const double scale[3], const double offset[3],
+	const std::vector<const Point_Cloud::Coordinate_Reference_System_Record*>& coordinate_reference_system, const bool& WKT) {
+
+	Public_Header_Block_Version_X_X header = create_header<Public_Header_Block_Version_X_X>(version_minor, point_data_record_format, scale, offset);
+	header.number_of_variable_length_records = static_cast<uint32_t>(coordinate_reference_system.size());
+	for (const Point_Cloud::Coordinate_Reference_System_Record* record : coordinate_reference_system) { header.offset_to_point_data += static_cast<uint32_t>(sizeof(Point_Cloud::Variable_Length_Record_Header) + record->data.size()); };
+	if (WKT) { header.global_encoding |= 0x10; };
+
+	//the header goes in last, once the counts and bounds are known
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	for (const Point_Cloud::Coordinate_Reference_System_Record* record : coordinate_reference_system) {
+
+		Point_Cloud::Variable_Length_Record_Header record_header = {};
+		std::memcpy(record_header.user_ID, "LASF_Projection", 15);
+		record_header.record_ID = record->record_ID;
+		record_header.record_length_after_header = static_cast<uint16_t>(record->data.size());
+		std::memcpy(record_header.description, record->description.data(), std::min<size_t>(record->description.size(), 32));
+		file.write(reinterpret_cast<const char*>(&record_header), sizeof(record_header));
+		file.write(record->data.data(), record->data.size());
+
+	};
+
+	const size_t n_tasks = (n_points + POINTS_PER_TASK - 1) / POINTS_PER_TASK;
+	std::vector<Chunk_Statistics> statistics(n_tasks);
+
+	//two batches take turns: one is encoded by the pool whilst the other is being written
+	std::vector<char> batches[2];
+	std::future<void> pending_write;
+	for (uint64_t batch_first = 0, batch = 0; batch_first < n_points; batch_first += POINTS_PER_BATCH, batch++) {
+
+		const uint64_t batch_last = std::min<uint64_t>(n_points, batch_first + POINTS_PER_BATCH);
+		std::vector<char>& records = batches[batch % 2];
+		records.resize((batch_last - batch_first) * sizeof(Point_Data_Record_Format_X));
+
+		const size_t first_task = batch_first / POINTS_PER_TASK;
+		const size_t n_batch_tasks = (batch_last - batch_first + POINTS_PER_TASK - 1) / POINTS_PER_TASK;
+		Thread_Pool::shared().parallel_for(n_batch_tasks, 1, [&](const size_t& first, const size_t& last) {
+
+			for (size_t task = first; task < last; ++task) {
+
+				const uint64_t first_point = batch_first + task * POINTS_PER_TASK;
+				const uint64_t last_point = std::min<uint64_t>(batch_last, first_point + POINTS_PER_TASK);
+				encode_records<Point_Data_Record_Format_X>(point_ranges, range_starts, point_attributes, selection, scale, offset, first_point, last_point, records.data() + (first_point - batch_first) * sizeof(Point_Data_Record_Format_X), statistics[first_task + task]);
+
+			};
+
+		});
+
+		if (pending_write.valid()) { pending_write.get(); };
+		pending_write = std::async(std::launch::async, [&file, &records]() { file.write(records.data(), records.size()); });
+
+	};
+	if (pending_write.valid()) { pending_write.get(); };
+
+	int32_t minimum[3] = { 0, 0, 0 };
+	int32_t maximum[3] = { 0, 0, 0 };
+	uint64_t number_of_points_by_return[15] = {};
+	for (size_t task = 0; task < n_tasks; ++task) {
+
+		for (int axis = 0; axis < 3; axis++) {
+
+			minimum[axis] = task == 0 ? statistics[task].minimum[axis] : std::min(minimum[axis], statistics[task].minimum[axis]);
+			maximum[axis] = task == 0 ? statistics[task].maximum[axis] : std::max(maximum[axis], statistics[task].maximum[axis]);
+
+		};
+		for (int i = 0; i < 15; i++) { number_of_points_by_return[i] += statistics[task].number_of_points_by_return[i]; };
+
+	};
+
+	//the bounds of the quantized records, so they hold every point exactly
+	header.min_X = minimum[0] * scale[0] + offset[0]; header.max_X = maximum[0] * scale[0] + offset[0];
+	header.min_Y = minimum[1] * scale[1] + offset[1]; header.max_Y = maximum[1] * scale[1] + offset[1];
+	header.min_Z = minimum[2] * scale[2] + offset[2]; header.max_Z = maximum[2] * scale[2] + offset[2];
+	if constexpr (requires { header.legacy_number_of_point_records; }) {
+
+		//point formats 6 to 10 leave the legacy counts at 0
+		header.number_of_point_records = n_points;
+		for (int i = 0; i < 15; i++) { header.number_of_points_by_return[i] = number_of_points_by_return[i]; };
+
+	}
+	else {
+
+		header.number_of_point_records = static_cast<uint32_t>(n_points);
+		for (int i = 0; i < 5; i++) { header.number_of_points_by_return[i] = static_cast<uint32_t>(number_of_points_by_return[i]); };
+
+	};
+
+	file.seekp(0);
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	return static_cast<bool>(file);
+
+};
+
+bool LAS_Writer::write(const std::filesystem::path& path_to_LASer_file, const std::vector<Point_Range>& point_ranges, const Point_Cloud::Point_Attributes* point_attributes, const std::vector<uint64_t>* selection, const uint8_t& version_minor) {
+
+	if (version_minor != VERSION_1_2 && version_minor != VERSION_1_4) {
+
+		std::cerr << "ERROR: LAS 1." << int(version_minor) << " files cant be written, only LAS 1.2 and 1.4\n";
+		exit(EXIT_FAILURE);
+
+	};
+	if (point_ranges.empty()) { std::cerr << "WARNING: no points to write into " << path_to_LASer_file << "\n"; return false; };
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<uint64_t> range_starts(point_ranges.size());
+	uint64_t n_range_points = 0;
+	for (size_t range = 0; range < point_ranges.size(); range++) {
+
+		range_starts[range] = n_range_points;
+		n_range_points += point_ranges[range].n_points;
+
+	};
+	const uint64_t n_points = selection ? selection->size() : n_range_points;
+	if (selection && !selection->empty() && selection->back() >= n_range_points) { std::cerr << "ERROR: selected point " << selection->back() << " doesnt exist, there are " << n_range_points << " points\n"; exit(EXIT_FAILURE); };
+	if (version_minor == VERSION_1_2 && n_points > UINT32_MAX) { std::cerr << "WARNING: cant write " << n_points << " points into a LAS 1.2 file, write LAS 1.4 instead\n"; return false; };
+
+	if (point_attributes && point_attributes->size() != n_range_points) {
+
+		std::cerr << "WARNING: there are " << point_attributes->size() << " point attributes for " << n_range_points << " points, " << path_to_LASer_file << " is written without them\n";
+		point_attributes = nullptr;
+
+	};
+	const bool has_GPS_times = point_attributes && !point_attributes->GPS_times.empty();
+
+	//the quantization of the first source, unless its offset leaves points of the other ones out of reach of 32 bit integers. Then the offset moves to the center of all points.
+	//The frames are affine per axis, so the corners of the openGL bounds of a range are the corners of its geospatial bounds
+	double scale[3], offset[3];
+	double minimum[3] = { DBL_MAX, DBL_MAX, DBL_MAX };
+	double maximum[3] = { -DBL_MAX, -DBL_MAX, -DBL_MAX };
+	for (const Point_Range& point_range : point_ranges) {
+
+		if (point_range.n_points == 0) { continue; };
+		const size_t n_tasks = (point_range.n_points + POINTS_PER_TASK - 1) / POINTS_PER_TASK;
+		std::vector<vec3> task_minimums(n_tasks, point_range.positions[0]);
+		std::vector<vec3> task_maximums(n_tasks, point_range.positions[0]);
+		Thread_Pool::shared().parallel_for(n_tasks, 1, [&](const size_t& first, const size_t& last) {
+
+			for (size_t task = first; task < last; ++task) {
+
+				for (uint64_t i = task * POINTS_PER_TASK; i < std::min<uint64_t>(point_range.n_points, (task + 1) * POINTS_PER_TASK); i++) {
+
+					const vec3& position = point_range.positions[i];
+					task_minimums[task] = vec3(std::min(task_minimums[task].x, position.x), std::min(task_minimums[task].y, position.y), std::min(task_minimums[task].z, position.z));
+					task_maximums[task] = vec3(std::max(task_maximums[task].x, position.x), std::max(task_maximums[task].y, position.y), std::max(task_maximums[task].z, position.z));
+
+				};
+
+			};
+
+		});
+
+		for (size_t task = 0; task < n_tasks; ++task) {
+
+			double corners[2][3];
+			point_range.frame.compute_geospatial_coordinates(task_minimums[task], corners[0]);
+			point_range.frame.compute_geospatial_coordinates(task_maximums[task], corners[1]);
+			for (int axis = 0; axis < 3; axis++) {
+
+				minimum[axis] = std::min({ minimum[axis], corners[0][axis], corners[1][axis] });
+				maximum[axis] = std::max({ maximum[axis], corners[0][axis], corners[1][axis] });
+
+			};
+
+		};
+
+	};
+	for (int axis = 0; axis < 3; axis++) {
+
+		scale[axis] = point_ranges.front().frame.quantization_scale[axis];
+		offset[axis] = point_ranges.front().frame.quantization_offset[axis];
+		if (minimum[axis] > maximum[axis]) { continue; };
+		if ((minimum[axis] - offset[axis]) / scale[axis] < INT32_MIN || (maximum[axis] - offset[axis]) / scale[axis] > INT32_MAX) {
+
+			offset[axis] = std::round((minimum[axis] + maximum[axis]) * 0.5 / scale[axis]) * scale[axis];
+			if ((maximum[axis] - minimum[axis]) / scale[axis] > UINT32_MAX) { std::cerr << "WARNING: the points span too much for a scale of " << scale[axis] << ", " << path_to_LASer_file << " cant hold them\n"; return false; };
+
+		};
+
+	};
+
+	//the coordinate reference system of the first source. Point formats 6 to 10 have to describe it in WKT, so LAS 1.4 files keep its WKT records and set the WKT bit, and only fall back to its GeoTIFF
+	//keys with the bit clear when it has no WKT. LAS 1.2 files cant hold WKT and keep only the GeoTIFF keys
+	std::vector<const Point_Cloud::Coordinate_Reference_System_Record*> WKT_records, GeoTIFF_records;
+	if (point_ranges.front().coordinate_reference_system) {
+
+		for (const Point_Cloud::Coordinate_Reference_System_Record& record : *point_ranges.front().coordinate_reference_system) {
+
+			if (record.data.size() > UINT16_MAX) { std::cerr << "WARNING: the coordinate reference system record " << record.record_ID << " is too long for a VLR, " << path_to_LASer_file << " is written without it\n"; continue; };
+			if (record.record_ID == Point_Cloud::WKT_MATH_TRANSFORM_RECORD_ID || record.record_ID == Point_Cloud::WKT_COORDINATE_SYSTEM_RECORD_ID) { WKT_records.push_back(&record); }
+			else { GeoTIFF_records.push_back(&record); };
+
+		};
+
+	};
+	bool WKT = version_minor == VERSION_1_4;
+	std::vector<const Point_Cloud::Coordinate_Reference_System_Record*>& coordinate_reference_system = WKT && !WKT_records.empty() ? WKT_records : GeoTIFF_records;
+	if (WKT && WKT_records.empty() && !GeoTIFF_records.empty()) {
+
+		std::cerr << "WARNING: the coordinate reference system of " << path_to_LASer_file << " has no WKT, its GeoTIFF keys are written instead\n";
+		WKT = false;
+
+	};
+	if (!WKT && GeoTIFF_records.empty() && !WKT_records.empty()) { std::cerr << "WARNING: LAS 1.2 files cant hold a WKT coordinate reference system, " << path_to_LASer_file << " is written without it\n"; };
+
+	std::ofstream file(path_to_LASer_file, std::ios::binary | std::ios::trunc);
+	if (!file) { std::cerr << "WARNING: cant create " << path_to_LASer_file << "\n"; return false; };
+
+	bool written;
+	if (version_minor == VERSION_1_4) { written = write_points<Point_Cloud::Public_Header_Block_Version_1_4, Point_Cloud::Point_Data_Record_Format_7>(file, point_ranges, range_starts, point_attributes, selection, n_points, version_minor, 7, scale, offset, coordinate_reference_system, WKT); }
+	else if (has_GPS_times) { written = write_points<Point_Cloud::Public_Header_Block_Version_1_2, Point_Cloud::Point_Data_Record_Format_3>(file, point_ranges, range_starts, point_attributes, selection, n_points, version_minor, 3, scale, offset, coordinate_reference_system, WKT); }
+	else { written = write_points<Point_Cloud::Public_Header_Block_Version_1_2, Point_Cloud::Point_Data_Record_Format_2>(file, point_ranges, range_starts, point_attributes, selection, n_points, version_minor, 2, scale, offset, coordinate_reference_system, WKT); };
+	file.close();
+
+	if (!written || !file) {
+
+		std::cerr << "WARNING: failed to write " << path_to_LASer_file << "\n";
+		std::error_code error;
+		std::filesystem::remove(path_to_LASer_file, error);
+		return false;
+
+	};
+
+	std::chrono::duration<double> elapsed_time = std::chrono::steady_clock::now() - start;
+	std::cout << "wrote " << n_points << " points into " << path_to_LASer_file << " in " << elapsed_time.count() * 1000.0 << " ms\n";
+	return true;
+
+};
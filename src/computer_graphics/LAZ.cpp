@@ -0,0 +1,1687 @@
+#include "computer_graphics/LAZ.h"
+
+/////////ARITHMETIC CODING
+
+//LASzip is built on the adaptive range coder of Amir Said, these constants and the model updates have to match it exactly or the decoded symbols drift apart
+static constexpr uint32_t AC_MIN_LENGTH = 0x01000000U;
+static constexpr uint32_t AC_MAX_LENGTH = 0xFFFFFFFFU;
+static constexpr uint32_t BM_LENGTH_SHIFT = 13;
+static constexpr uint32_t BM_MAX_COUNT = 1 << BM_LENGTH_SHIFT;
+static constexpr uint32_t DM_LENGTH_SHIFT = 15;
+static constexpr uint32_t DM_MAX_COUNT = 1 << DM_LENGTH_SHIFT;
+
+//adaptive probability of a single bit
+struct Arithmetic_Bit_Model {
+
+	uint32_t bit_0_count;
+	uint32_t bit_count;
+	uint32_t bit_0_prob;
+	uint32_t bits_until_update;
+	uint32_t update_cycle;
+
+	void update() {
+
+		//halve the counts when a threshold is reached
+		if ((this->bit_count += this->update_cycle) > BM_MAX_COUNT) {
+
+			this->bit_count = (this->bit_count + 1) >> 1;
+			this->bit_0_count = (this->bit_0_count + 1) >> 1;
+			if (this->bit_0_count == this->bit_count) { ++this->bit_count; };
+
+		};
+
+		uint32_t scale = 0x80000000U / this->bit_count;
+		this->bit_0_prob = (this->bit_0_count * scale) >> (31 - BM_LENGTH_SHIFT);
+
+		this->update_cycle = std::min<uint32_t>((5 * this->update_cycle) >> 2, 64);
+		this->bits_until_update = this->update_cycle;
+
+	};
+
+	//starts equiprobable and with frequent updates
+	Arithmetic_Bit_Model() : bit_0_count(1), bit_count(2), bit_0_prob(1U << (BM_LENGTH_SHIFT - 1)), bits_until_update(4), update_cycle(4) {};
+
+};
+
+//adaptive distribution of *n_symbols* symbols, models with more than 16 symbols keep a table that narrows down the search for the decoded symbol
+struct Arithmetic_Model {
+
+	uint32_t n_symbols;
+	uint32_t last_symbol;
+	uint32_t table_size;
+	uint32_t table_shift;
+	uint32_t total_count;
+	uint32_t update_cycle;
+	uint32_t symbols_until_update;
+	std::vector<uint32_t> distribution;
+	std::vector<uint32_t> symbol_count;
+	std::vector<uint32_t> decoder_table;
+
+	void update() {
+
+		//halve the counts when a threshold is reached
+		if ((this->total_count += this->update_cycle) > DM_MAX_COUNT) {
+
+			this->total_count = 0;
+			for (uint32_t n = 0; n < this->n_symbols; n++) { this->total_count += (this->symbol_count[n] = (this->symbol_count[n] + 1) >> 1); };
+
+		};
+
+		uint32_t sum = 0, s = 0;
+		uint32_t scale = 0x80000000U / this->total_count;
+		for (uint32_t k = 0; k < this->n_symbols; k++) {
+
+			this->distribution[k] = (scale * sum) >> (31 - DM_LENGTH_SHIFT);
+			sum += this->symbol_count[k];
+			if (this->table_size) {
+
+				uint32_t w = this->distribution[k] >> this->table_shift;
+				while (s < w) { this->decoder_table[++s] = k - 1; };
+
+			};
+
+		};
+		if (this->table_size) {
+
+			this->decoder_table[0] = 0;
+			while (s <= this->table_size) { this->decoder_table[++s] = this->n_symbols - 1; };
+
+		};
+
+		this->update_cycle = std::min<uint32_t>((5 * this->update_cycle) >> 2, (this->n_symbols + 6) << 3);
+		this->symbols_until_update = this->update_cycle;
+
+	};
+
+	Arithmetic_Model(const uint32_t& n_symbols) : n_symbols(n_symbols), last_symbol(n_symbols - 1), table_size(0), table_shift(0), total_count(0), update_cycle(n_symbols), distribution(n_symbols), symbol_count(n_symbols, 1) {
+
+		if (n_symbols > 16) {
+
+			uint32_t table_bits = 3;
+			while (n_symbols > (1U << (table_bits + 2))) { ++table_bits; };
+			this->table_size = 1 << table_bits;
+			this->table_shift = DM_LENGTH_SHIFT - table_bits;
+			this->decoder_table.resize(this->table_size + 2);
+
+		};
+
+		this->update();
+		this->symbols_until_update = this->update_cycle = (n_symbols + 6) >> 1;
+
+	};
+
+};
+
+class Arithmetic_Decoder {
+
+ public:
+
+	void init(const uint8_t* data, const uint64_t& n_bytes) {
+
+		this->data = data;
+		this->end = data + n_bytes;
+		this->length = AC_MAX_LENGTH;
+		this->value = (this->get_byte() << 24);
+		this->value |= (this->get_byte() << 16);
+		this->value |= (this->get_byte() << 8);
+		this->value |= this->get_byte();
+
+	};
+
+	uint32_t decode_bit(Arithmetic_Bit_Model& model) {
+
+		uint32_t x = model.bit_0_prob * (this->length >> BM_LENGTH_SHIFT);
+		uint32_t symbol = (this->value >= x);
+		if (symbol == 0) {
+
+			this->length = x;
+			++model.bit_0_count;
+
+		}
+		else {
+
+			this->value -= x;
+			this->length -= x;
+
+		};
+
+		if (this->length < AC_MIN_LENGTH) { this->renormalize(); };
+		if (--model.bits_until_update == 0) { model.update(); };
+		return symbol;
+
+	};
+
+	uint32_t decode_symbol(Arithmetic_Model& model) {
+
+		uint32_t n, symbol, x, y = this->length;
+		if (model.table_size) {
+
+			//the table gives the range of symbols the value can fall into, a short bisection finds the exact one
+			uint32_t dv = this->value / (this->length >>= DM_LENGTH_SHIFT);
+			uint32_t t = std::min(dv >> model.table_shift, model.table_size);
+			symbol = model.decoder_table[t];
+			n = model.decoder_table[t + 1] + 1;
+			while (n > symbol + 1) {
+
+				uint32_t k = (symbol + n) >> 1;
+				if (model.distribution[k] > dv) { n = k; }
+				else { symbol = k; };
+
+			};
+
+			x = model.distribution[symbol] * this->length;
+			if (symbol != model.last_symbol) { y = model.distribution[symbol + 1] * this->length; };
+
+		}
+		else {
+
+			x = symbol = 0;
+			this->length >>= DM_LENGTH_SHIFT;
+			uint32_t k = (n = model.n_symbols) >> 1;
+			do {
+
+				uint32_t z = this->length * model.distribution[k];
+				if (z > this->value) {
+
+					n = k;
+					y = z;
+
+				}
+				else {
+
+					symbol = k;
+					x = z;
+
+				};
+
+			} while ((k = (symbol + n) >> 1) != symbol);
+
+		};
+
+		this->value -= x;
+		this->length = y - x;
+		if (this->length < AC_MIN_LENGTH) { this->renormalize(); };
+
+		++model.symbol_count[symbol];
+		if (--model.symbols_until_update == 0) { model.update(); };
+		return symbol;
+
+	};
+
+	//*bits* raw bits that were written without a model
+	uint32_t read_bits(uint32_t bits) {
+
+		if (bits > 19) {
+
+			uint32_t low = this->read_bits(16);
+			uint32_t high = this->read_bits(bits - 16);
+			return (high << 16) | low;
+
+		};
+
+		uint32_t symbol = this->value / (this->length >>= bits);
+		this->value -= this->length * symbol;
+		if (this->length < AC_MIN_LENGTH) { this->renormalize(); };
+		return symbol;
+
+	};
+
+	uint32_t read_int() {
+
+		uint32_t low = this->read_bits(16);
+		uint32_t high = this->read_bits(16);
+		return (high << 16) | low;
+
+	};
+
+ private:
+
+	const uint8_t* data;
+	const uint8_t* end;
+	uint32_t value;
+	uint32_t length;
+
+	//the encoder flushes enough bytes that valid data never reads past its end, zeros keep truncated data from reading out of bounds
+	uint32_t get_byte() {
+
+		return this->data < this->end ? *this->data++ : 0;
+
+	};
+
+	void renormalize() {
+
+		do {
+
+			this->value = (this->value << 8) | this->get_byte();
+
+		} while ((this->length <<= 8) < AC_MIN_LENGTH);
+
+	};
+
+};
+
+//decodes integers as a correction of a prediction. The corrector is coded as the number of bits *k* it needs, with one model per context, followed by its exact value within that range
+class Integer_Decompressor {
+
+ public:
+
+	//bit count of the last corrector, used by the items as context for the next coordinate
+	uint32_t k;
+
+	Integer_Decompressor(Arithmetic_Decoder& decoder, const uint32_t& bits = 16, const uint32_t& contexts = 1, const uint32_t& bits_high = 8) : k(0), decoder(decoder), bits_high(bits_high) {
+
+		if (bits && bits < 32) {
+
+			this->corr_bits = bits;
+			this->corr_range = 1u << bits;
+			this->corr_min = -static_cast<int32_t>(this->corr_range / 2);
+
+		}
+		else {
+
+			this->corr_bits = 32;
+			this->corr_range = 0;
+			this->corr_min = INT32_MIN;
+
+		};
+
+		this->m_bits.reserve(contexts);
+		for (uint32_t i = 0; i < contexts; i++) { this->m_bits.emplace_back(this->corr_bits + 1); };
+		this->m_corrector.reserve(this->corr_bits);
+		for (uint32_t i = 1; i <= this->corr_bits; i++) { this->m_corrector.emplace_back(i <= bits_high ? 1u << i : 1u << bits_high); };
+
+	};
+
+	int32_t decompress(const int32_t& prediction, const uint32_t& context = 0) {
+
+		//the sum wraps around like the 32 bit arithmetic of the encoder
+		int32_t real = static_cast<int32_t>(static_cast<uint32_t>(prediction) + static_cast<uint32_t>(this->read_corrector(this->m_bits[context])));
+		if (real < 0) { real += static_cast<int32_t>(this->corr_range); }
+		else if (static_cast<uint32_t>(real) >= this->corr_range) { real -= static_cast<int32_t>(this->corr_range); };
+		return real;
+
+	};
+
+ private:
+
+	Arithmetic_Decoder& decoder;
+	uint32_t bits_high;
+	uint32_t corr_bits;
+	uint32_t corr_range;
+	int32_t corr_min;
+
+	std::vector<Arithmetic_Model> m_bits;
+	Arithmetic_Bit_Model m_corrector_0;
+	std::vector<Arithmetic_Model> m_corrector;
+
+	int32_t read_corrector(Arithmetic_Model& m_bits) {
+
+		int32_t c;
+		this->k = this->decoder.decode_symbol(m_bits);
+		if (this->k) {
+
+			if (this->k < 32) {
+
+				if (this->k <= this->bits_high) {
+
+					c = static_cast<int32_t>(this->decoder.decode_symbol(this->m_corrector[this->k - 1]));
+
+				}
+				else {
+
+					//the high bits use a model, the low ones are raw
+					uint32_t k1 = this->k - this->bits_high;
+					c = static_cast<int32_t>(this->decoder.decode_symbol(this->m_corrector[this->k - 1]));
+					uint32_t c1 = this->decoder.read_bits(k1);
+					c = static_cast<int32_t>((static_cast<uint32_t>(c) << k1) | c1);
+
+				};
+
+				//map c from [0, 2^k - 1] back to [-(2^k - 1), -2^(k-1)] or [2^(k-1) + 1, 2^k]
+				if (c >= static_cast<int32_t>(1u << (this->k - 1))) { c += 1; }
+				else { c -= static_cast<int32_t>((1u << this->k) - 1); };
+
+			}
+			else {
+
+				c = this->corr_min;
+
+			};
+
+		}
+		else {
+
+			c = static_cast<int32_t>(this->decoder.decode_bit(this->m_corrector_0));
+
+		};
+
+		return c;
+
+	};
+
+};
+
+/////////SHARED ITEM STATE
+
+static inline uint8_t fold_byte(const int32_t& n) {
+
+	return static_cast<uint8_t>(n < 0 ? n + 256 : (n > 255 ? n - 256 : n));
+
+};
+
+static inline uint8_t clamp_byte(const int32_t& n) {
+
+	return static_cast<uint8_t>(n <= 0 ? 0 : (n >= 255 ? 255 : n));
+
+};
+
+//median of the last five values, kept sorted with a single insertion per value
+struct Streaming_Median5 {
+
+	int32_t values[5] = { 0, 0, 0, 0, 0 };
+	bool high = true;
+
+	void add(const int32_t& v) {
+
+		if (this->high) {
+
+			if (v < this->values[2]) {
+
+				this->values[4] = this->values[3];
+				this->values[3] = this->values[2];
+				if (v < this->values[0]) {
+
+					this->values[2] = this->values[1];
+					this->values[1] = this->values[0];
+					this->values[0] = v;
+
+				}
+				else if (v < this->values[1]) {
+
+					this->values[2] = this->values[1];
+					this->values[1] = v;
+
+				}
+				else {
+
+					this->values[2] = v;
+
+				};
+
+			}
+			else {
+
+				if (v < this->values[3]) {
+
+					this->values[4] = this->values[3];
+					this->values[3] = v;
+
+				}
+				else {
+
+					this->values[4] = v;
+
+				};
+				this->high = false;
+
+			};
+
+		}
+		else {
+
+			if (this->values[2] < v) {
+
+				this->values[0] = this->values[1];
+				this->values[1] = this->values[2];
+				if (this->values[4] < v) {
+
+					this->values[2] = this->values[3];
+					this->values[3] = this->values[4];
+					this->values[4] = v;
+
+				}
+				else if (this->values[3] < v) {
+
+					this->values[2] = this->values[3];
+					this->values[3] = v;
+
+				}
+				else {
+
+					this->values[2] = v;
+
+				};
+
+			}
+			else {
+
+				if (this->values[1] < v) {
+
+					this->values[0] = this->values[1];
+					this->values[1] = v;
+
+				}
+				else {
+
+					this->values[0] = v;
+
+				};
+				this->high = true;
+
+			};
+
+		};
+
+	};
+
+	int32_t get() const { return this->values[2]; };
+
+};
+
+//maps return number r (column) and number of returns n (row) of the legacy formats to one of 16 contexts and to one of 8 levels
+static constexpr uint8_t NUMBER_RETURN_MAP[8][8] = {
+
+	{ 15, 14, 13, 12, 11, 10,  9,  8 },
+	{ 14,  0,  1,  3,  6, 10, 10,  9 },
+	{ 13,  1,  2,  4,  7, 11, 11, 10 },
+	{ 12,  3,  4,  5,  8, 12, 12, 11 },
+	{ 11,  6,  7,  8,  9, 13, 13, 12 },
+	{ 10, 10, 11, 12, 13, 14, 14, 13 },
+	{  9, 10, 11, 12, 13, 14, 15, 14 },
+	{  8,  9, 10, 11, 12, 13, 14, 15 }
+
+};
+
+static constexpr uint8_t NUMBER_RETURN_LEVEL[8][8] = {
+
+	{  0,  1,  2,  3,  4,  5,  6,  7 },
+	{  1,  0,  1,  2,  3,  4,  5,  6 },
+	{  2,  1,  0,  1,  2,  3,  4,  5 },
+	{  3,  2,  1,  0,  1,  2,  3,  4 },
+	{  4,  3,  2,  1,  0,  1,  2,  3 },
+	{  5,  4,  3,  2,  1,  0,  1,  2 },
+	{  6,  5,  4,  3,  2,  1,  0,  1 },
+	{  7,  6,  5,  4,  3,  2,  1,  0 }
+
+};
+
+//the same for the 16 returns of the LAS 1.4 formats, reduced to 6 contexts and 8 levels
+static constexpr uint8_t NUMBER_RETURN_MAP_6_CONTEXTS[16][16] = {
+
+	{  0,  1,  2,  3,  4,  5,  3,  4,  4,  5,  5,  5,  5,  5,  5,  5 },
+	{  1,  0,  1,  3,  4,  5,  3,  4,  4,  5,  5,  5,  5,  5,  5,  5 },
+	{  2,  1,  2,  4,  4,  5,  4,  4,  4,  5,  5,  5,  5,  5,  5,  5 },
+	{  3,  3,  4,  5,  4,  5,  4,  4,  4,  5,  5,  5,  5,  5,  5,  5 },
+	{  4,  4,  4,  4,  5,  5,  4,  4,  4,  5,  5,  5,  5,  5,  5,  5 },
+	{  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5 },
+	{  3,  3,  4,  4,  4,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5 },
+	{  4,  4,  4,  4,  4,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5 },
+	{  4,  4,  4,  4,  4,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5 },
+	{  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5 },
+	{  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5 },
+	{  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5 },
+	{  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5 },
+	{  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5 },
+	{  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5 },
+	{  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5 }
+
+};
+
+static constexpr uint8_t NUMBER_RETURN_LEVEL_8_CONTEXTS[16][16] = {
+
+	{  0,  1,  2,  3,  4,  5,  6,  7,  7,  7,  7,  7,  7,  7,  7,  7 },
+	{  1,  0,  1,  2,  3,  4,  5,  6,  7,  7,  7,  7,  7,  7,  7,  7 },
+	{  2,  1,  0,  1,  2,  3,  4,  5,  6,  7,  7,  7,  7,  7,  7,  7 },
+	{  3,  2,  1,  0,  1,  2,  3,  4,  5,  6,  7,  7,  7,  7,  7,  7 },
+	{  4,  3,  2,  1,  0,  1,  2,  3,  4,  5,  6,  7,  7,  7,  7,  7 },
+	{  5,  4,  3,  2,  1,  0,  1,  2,  3,  4,  5,  6,  7,  7,  7,  7 },
+	{  6,  5,  4,  3,  2,  1,  0,  1,  2,  3,  4,  5,  6,  7,  7,  7 },
+	{  7,  6,  5,  4,  3,  2,  1,  0,  1,  2,  3,  4,  5,  6,  7,  7 },
+	{  7,  7,  6,  5,  4,  3,  2,  1,  0,  1,  2,  3,  4,  5,  6,  7 },
+	{  7,  7,  7,  6,  5,  4,  3,  2,  1,  0,  1,  2,  3,  4,  5,  6 },
+	{  7,  7,  7,  7,  6,  5,  4,  3,  2,  1,  0,  1,  2,  3,  4,  5 },
+	{  7,  7,  7,  7,  7,  6,  5,  4,  3,  2,  1,  0,  1,  2,  3,  4 },
+	{  7,  7,  7,  7,  7,  7,  6,  5,  4,  3,  2,  1,  0,  1,  2,  3 },
+	{  7,  7,  7,  7,  7,  7,  7,  6,  5,  4,  3,  2,  1,  0,  1,  2 },
+	{  7,  7,  7,  7,  7,  7,  7,  7,  6,  5,  4,  3,  2,  1,  0,  1 },
+	{  7,  7,  7,  7,  7,  7,  7,  7,  7,  6,  5,  4,  3,  2,  1,  0 }
+
+};
+
+//GPS times are predicted from up to four interleaved sequences, each one with its own last time and last integer difference
+static constexpr int32_t GPSTIME_MULTI = 500;
+static constexpr int32_t GPSTIME_MULTI_MINUS = -10;
+
+struct GPS_Time_Sequences {
+
+	uint32_t last = 0;
+	uint32_t next = 0;
+	int64_t last_gpstime[4] = { 0, 0, 0, 0 };
+	int32_t last_gpstime_diff[4] = { 0, 0, 0, 0 };
+	int32_t multi_extreme_counter[4] = { 0, 0, 0, 0 };
+
+};
+
+static inline int32_t wrapping_multiply(const int32_t& a, const int32_t& b) {
+
+	return static_cast<int32_t>(static_cast<uint32_t>(a) * static_cast<uint32_t>(b));
+
+};
+
+//applies a difference coded as *multi* times the last difference of the current sequence, *multi* being 0 or in [2, 510]
+static void decode_gps_time_difference(GPS_Time_Sequences& sequences, Integer_Decompressor& ic_gpstime, int32_t multi) {
+
+	const uint32_t last = sequences.last;
+	int32_t gpstime_diff;
+	bool extreme = false;
+	if (multi == 0) {
+
+		gpstime_diff = ic_gpstime.decompress(0, 7);
+		extreme = true;
+
+	}
+	else if (multi < GPSTIME_MULTI) {
+
+		gpstime_diff = ic_gpstime.decompress(wrapping_multiply(multi, sequences.last_gpstime_diff[last]), multi < 10 ? 2 : 3);
+
+	}
+	else if (multi == GPSTIME_MULTI) {
+
+		gpstime_diff = ic_gpstime.decompress(wrapping_multiply(GPSTIME_MULTI, sequences.last_gpstime_diff[last]), 4);
+		extreme = true;
+
+	}
+	else {
+
+		multi = GPSTIME_MULTI - multi;
+		if (multi > GPSTIME_MULTI_MINUS) {
+
+			gpstime_diff = ic_gpstime.decompress(wrapping_multiply(multi, sequences.last_gpstime_diff[last]), 5);
+
+		}
+		else {
+
+			gpstime_diff = ic_gpstime.decompress(wrapping_multiply(GPSTIME_MULTI_MINUS, sequences.last_gpstime_diff[last]), 6);
+			extreme = true;
+
+		};
+
+	};
+
+	//a difference that keeps being far off the prediction becomes the new prediction
+	if (extreme && ++sequences.multi_extreme_counter[last] > 3) {
+
+		sequences.last_gpstime_diff[last] = gpstime_diff;
+		sequences.multi_extreme_counter[last] = 0;
+
+	};
+	sequences.last_gpstime[last] += gpstime_diff;
+
+};
+
+//starts a new sequence from a time that couldnt be predicted, its high 32 bits are coded against the current sequence and its low 32 bits are raw
+static void decode_full_gps_time(GPS_Time_Sequences& sequences, Integer_Decompressor& ic_gpstime, Arithmetic_Decoder& decoder) {
+
+	sequences.next = (sequences.next + 1) & 3;
+	uint64_t high = static_cast<uint32_t>(ic_gpstime.decompress(static_cast<int32_t>(static_cast<uint64_t>(sequences.last_gpstime[sequences.last]) >> 32), 8));
+	sequences.last_gpstime[sequences.next] = static_cast<int64_t>((high << 32) | decoder.read_int());
+	sequences.last = sequences.next;
+	sequences.last_gpstime_diff[sequences.last] = 0;
+	sequences.multi_extreme_counter[sequences.last] = 0;
+
+};
+
+struct RGB_Models {
+
+	Arithmetic_Model m_byte_used = Arithmetic_Model(128);
+	Arithmetic_Model m_rgb_diff_0 = Arithmetic_Model(256);
+	Arithmetic_Model m_rgb_diff_1 = Arithmetic_Model(256);
+	Arithmetic_Model m_rgb_diff_2 = Arithmetic_Model(256);
+	Arithmetic_Model m_rgb_diff_3 = Arithmetic_Model(256);
+	Arithmetic_Model m_rgb_diff_4 = Arithmetic_Model(256);
+	Arithmetic_Model m_rgb_diff_5 = Arithmetic_Model(256);
+
+};
+
+//the low and high byte of red are coded against the last red, green and blue against the last green and blue plus the change of red (and green for blue). A flag skips green and blue when they equal red
+static void decode_rgb(Arithmetic_Decoder& decoder, RGB_Models& models, uint16_t* last, uint16_t* rgb) {
+
+	uint32_t symbol = decoder.decode_symbol(models.m_byte_used);
+	int32_t diff;
+
+	if (symbol & (1 << 0)) { rgb[0] = fold_byte(decoder.decode_symbol(models.m_rgb_diff_0) + (last[0] & 255)); }
+	else { rgb[0] = last[0] & 0xFF; };
+	if (symbol & (1 << 1)) { rgb[0] |= static_cast<uint16_t>(fold_byte(decoder.decode_symbol(models.m_rgb_diff_1) + (last[0] >> 8))) << 8; }
+	else { rgb[0] |= last[0] & 0xFF00; };
+
+	if (symbol & (1 << 6)) {
+
+		diff = (rgb[0] & 0x00FF) - (last[0] & 0x00FF);
+		if (symbol & (1 << 2)) { rgb[1] = fold_byte(decoder.decode_symbol(models.m_rgb_diff_2) + clamp_byte(diff + (last[1] & 255))); }
+		else { rgb[1] = last[1] & 0xFF; };
+		if (symbol & (1 << 4)) {
+
+			diff = (diff + ((rgb[1] & 0x00FF) - (last[1] & 0x00FF))) / 2;
+			rgb[2] = fold_byte(decoder.decode_symbol(models.m_rgb_diff_4) + clamp_byte(diff + (last[2] & 255)));
+
+		}
+		else { rgb[2] = last[2] & 0xFF; };
+
+		diff = (rgb[0] >> 8) - (last[0] >> 8);
+		if (symbol & (1 << 3)) { rgb[1] |= static_cast<uint16_t>(fold_byte(decoder.decode_symbol(models.m_rgb_diff_3) + clamp_byte(diff + (last[1] >> 8)))) << 8; }
+		else { rgb[1] |= last[1] & 0xFF00; };
+		if (symbol & (1 << 5)) {
+
+			diff = (diff + ((rgb[1] >> 8) - (last[1] >> 8))) / 2;
+			rgb[2] |= static_cast<uint16_t>(fold_byte(decoder.decode_symbol(models.m_rgb_diff_5) + clamp_byte(diff + (last[2] >> 8)))) << 8;
+
+		}
+		else { rgb[2] |= last[2] & 0xFF00; };
+
+	}
+	else {
+
+		rgb[1] = rgb[0];
+		rgb[2] = rgb[0];
+
+	};
+
+	std::memcpy(last, rgb, 3 * sizeof(uint16_t));
+
+};
+
+/////////ITEMS
+
+//the compressed bytes of a chunk, read front to back
+struct Chunk_Cursor {
+
+	const uint8_t* data;
+	const uint8_t* end;
+
+	uint32_t read_uint32() {
+
+		uint32_t value = 0;
+		if (this->end - this->data >= 4) { std::memcpy(&value, this->data, 4); };
+		this->data = std::min(this->data + 4, this->end);
+		return value;
+
+	};
+
+	//hands out the next *n_bytes* bytes, or as many as are left
+	const uint8_t* take(uint64_t& n_bytes) {
+
+		const uint8_t* bytes = this->data;
+		n_bytes = std::min<uint64_t>(n_bytes, this->end - this->data);
+		this->data += n_bytes;
+		return bytes;
+
+	};
+
+};
+
+//decompresses one item of every record. *init* receives the raw first record of the chunk, *read* then writes the item of every following record.
+//*context* is the scanner channel the layered POINT14 item switches to, the items after it follow the same channel
+struct Item_Decoder {
+
+	virtual ~Item_Decoder() = default;
+
+	//only the layered items store the compressed size of each of their layers ahead of the layers themselves
+	virtual void read_layer_sizes(Chunk_Cursor&) {};
+	virtual void init(const uint8_t* item, uint32_t& context, Chunk_Cursor& chunk) = 0;
+	virtual void read(uint8_t* item, uint32_t& context) = 0;
+
+};
+
+//X, Y, Z, intensity, returns, flags, classification, scan angle rank, user data and point source ID of formats 0 to 5
+struct Point10_v2_Decoder : Item_Decoder {
+
+	Arithmetic_Decoder& decoder;
+	uint8_t last_item[20];
+	uint16_t last_intensity[16];
+	Streaming_Median5 last_x_diff_median5[16];
+	Streaming_Median5 last_y_diff_median5[16];
+	int32_t last_height[8];
+
+	Arithmetic_Model m_changed_values = Arithmetic_Model(64);
+	Integer_Decompressor ic_intensity;
+	Arithmetic_Model m_scan_angle_rank[2] = { Arithmetic_Model(256), Arithmetic_Model(256) };
+	Integer_Decompressor ic_point_source_ID;
+	std::unique_ptr<Arithmetic_Model> m_bit_byte[256];
+	std::unique_ptr<Arithmetic_Model> m_classification[256];
+	std::unique_ptr<Arithmetic_Model> m_user_data[256];
+	Integer_Decompressor ic_dx;
+	Integer_Decompressor ic_dy;
+	Integer_Decompressor ic_z;
+
+	Point10_v2_Decoder(Arithmetic_Decoder& decoder) : decoder(decoder), ic_intensity(decoder, 16, 4), ic_point_source_ID(decoder, 16), ic_dx(decoder, 32, 2), ic_dy(decoder, 32, 22), ic_z(decoder, 32, 20) {};
+
+	void init(const uint8_t* item, uint32_t&, Chunk_Cursor&) override {
+
+		for (int i = 0; i < 16; i++) {
+
+			this->last_intensity[i] = 0;
+			this->last_height[i / 2] = 0;
+
+		};
+		std::memcpy(this->last_item, item, 20);
+		//the intensity is always coded against the per return level history, which starts at zero
+		this->last_item[12] = 0;
+		this->last_item[13] = 0;
+
+	};
+
+	Arithmetic_Model& get_model(std::unique_ptr<Arithmetic_Model>& model) {
+
+		if (!model) { model = std::make_unique<Arithmetic_Model>(256); };
+		return *model;
+
+	};
+
+	void read(uint8_t* item, uint32_t&) override {
+
+		uint32_t changed_values = this->decoder.decode_symbol(this->m_changed_values);
+		uint32_t r, n, m, l;
+		if (changed_values) {
+
+			if (changed_values & 32) { this->last_item[14] = static_cast<uint8_t>(this->decoder.decode_symbol(this->get_model(this->m_bit_byte[this->last_item[14]]))); };
+
+			r = this->last_item[14] & 7;
+			n = (this->last_item[14] >> 3) & 7;
+			m = NUMBER_RETURN_MAP[n][r];
+			l = NUMBER_RETURN_LEVEL[n][r];
+
+			uint16_t intensity;
+			if (changed_values & 16) {
+
+				intensity = static_cast<uint16_t>(this->ic_intensity.decompress(this->last_intensity[m], m < 3 ? m : 3));
+				this->last_intensity[m] = intensity;
+
+			}
+			else {
+
+				intensity = this->last_intensity[m];
+
+			};
+			std::memcpy(this->last_item + 12, &intensity, 2);
+
+			if (changed_values & 8) { this->last_item[15] = static_cast<uint8_t>(this->decoder.decode_symbol(this->get_model(this->m_classification[this->last_item[15]]))); };
+			if (changed_values & 4) {
+
+				int32_t value = this->decoder.decode_symbol(this->m_scan_angle_rank[(this->last_item[14] >> 6) & 1]);
+				this->last_item[16] = fold_byte(value + this->last_item[16]);
+
+			};
+			if (changed_values & 2) { this->last_item[17] = static_cast<uint8_t>(this->decoder.decode_symbol(this->get_model(this->m_user_data[this->last_item[17]]))); };
+			if (changed_values & 1) {
+
+				uint16_t point_source_ID;
+				std::memcpy(&point_source_ID, this->last_item + 18, 2);
+				point_source_ID = static_cast<uint16_t>(this->ic_point_source_ID.decompress(point_source_ID));
+				std::memcpy(this->last_item + 18, &point_source_ID, 2);
+
+			};
+
+		}
+		else {
+
+			r = this->last_item[14] & 7;
+			n = (this->last_item[14] >> 3) & 7;
+			m = NUMBER_RETURN_MAP[n][r];
+			l = NUMBER_RETURN_LEVEL[n][r];
+
+		};
+
+		int32_t x, y, z;
+		std::memcpy(&x, this->last_item, 4);
+		std::memcpy(&y, this->last_item + 4, 4);
+
+		//X and Y are differences to the last point predicted by the median of the last differences, Z is predicted by the last Z of the same return level.
+		//How many bits the X and Y corrections took says how noisy the neighbourhood is, so it picks the context of the next coordinate
+		int32_t diff = this->ic_dx.decompress(this->last_x_diff_median5[m].get(), n == 1);
+		x = static_cast<int32_t>(static_cast<uint32_t>(x) + static_cast<uint32_t>(diff));
+		this->last_x_diff_median5[m].add(diff);
+
+		uint32_t k_bits = this->ic_dx.k;
+		diff = this->ic_dy.decompress(this->last_y_diff_median5[m].get(), (n == 1) + (k_bits < 20 ? (k_bits & ~1u) : 20));
+		y = static_cast<int32_t>(static_cast<uint32_t>(y) + static_cast<uint32_t>(diff));
+		this->last_y_diff_median5[m].add(diff);
+
+		k_bits = (this->ic_dx.k + this->ic_dy.k) / 2;
+		z = this->ic_z.decompress(this->last_height[l], (n == 1) + (k_bits < 18 ? (k_bits & ~1u) : 18));
+		this->last_height[l] = z;
+
+		std::memcpy(this->last_item, &x, 4);
+		std::memcpy(this->last_item + 4, &y, 4);
+		std::memcpy(this->last_item + 8, &z, 4);
+		std::memcpy(item, this->last_item, 20);
+
+	};
+
+};
+
+struct GPS_Time11_v2_Decoder : Item_Decoder {
+
+	static constexpr int32_t GPSTIME_MULTI_UNCHANGED = GPSTIME_MULTI - GPSTIME_MULTI_MINUS + 1;
+	static constexpr int32_t GPSTIME_MULTI_CODE_FULL = GPSTIME_MULTI - GPSTIME_MULTI_MINUS + 2;
+	static constexpr int32_t GPSTIME_MULTI_TOTAL = GPSTIME_MULTI - GPSTIME_MULTI_MINUS + 6;
+
+	Arithmetic_Decoder& decoder;
+	GPS_Time_Sequences sequences;
+	Arithmetic_Model m_gpstime_multi = Arithmetic_Model(GPSTIME_MULTI_TOTAL);
+	Arithmetic_Model m_gpstime_0diff = Arithmetic_Model(6);
+	Integer_Decompressor ic_gpstime;
+
+	GPS_Time11_v2_Decoder(Arithmetic_Decoder& decoder) : decoder(decoder), ic_gpstime(decoder, 32, 9) {};
+
+	void init(const uint8_t* item, uint32_t&, Chunk_Cursor&) override {
+
+		std::memcpy(&this->sequences.last_gpstime[0], item, 8);
+
+	};
+
+	void read(uint8_t* item, uint32_t&) override {
+
+		//a switch to another sequence is followed by the code of the time within that sequence
+		while (true) {
+
+			const uint32_t last = this->sequences.last;
+			if (this->sequences.last_gpstime_diff[last] == 0) {
+
+				int32_t multi = this->decoder.decode_symbol(this->m_gpstime_0diff);
+				if (multi == 1) {
+
+					this->sequences.last_gpstime_diff[last] = this->ic_gpstime.decompress(0, 0);
+					this->sequences.last_gpstime[last] += this->sequences.last_gpstime_diff[last];
+					this->sequences.multi_extreme_counter[last] = 0;
+
+				}
+				else if (multi == 2) { decode_full_gps_time(this->sequences, this->ic_gpstime, this->decoder); }
+				else if (multi > 2) { this->sequences.last = (last + multi - 2) & 3; continue; };
+
+			}
+			else {
+
+				int32_t multi = this->decoder.decode_symbol(this->m_gpstime_multi);
+				if (multi == 1) {
+
+					this->sequences.last_gpstime[last] += this->ic_gpstime.decompress(this->sequences.last_gpstime_diff[last], 1);
+					this->sequences.multi_extreme_counter[last] = 0;
+
+				}
+				else if (multi < GPSTIME_MULTI_UNCHANGED) { decode_gps_time_difference(this->sequences, this->ic_gpstime, multi); }
+				else if (multi == GPSTIME_MULTI_CODE_FULL) { decode_full_gps_time(this->sequences, this->ic_gpstime, this->decoder); }
+				else if (multi > GPSTIME_MULTI_CODE_FULL) { this->sequences.last = (last + multi - GPSTIME_MULTI_CODE_FULL) & 3; continue; };
+
+			};
+			break;
+
+		};
+
+		std::memcpy(item, &this->sequences.last_gpstime[this->sequences.last], 8);
+
+	};
+
+};
+
+struct RGB12_v2_Decoder : Item_Decoder {
+
+	Arithmetic_Decoder& decoder;
+	RGB_Models models;
+	uint16_t last_item[3];
+
+	RGB12_v2_Decoder(Arithmetic_Decoder& decoder) : decoder(decoder) {};
+
+	void init(const uint8_t* item, uint32_t&, Chunk_Cursor&) override {
+
+		std::memcpy(this->last_item, item, 6);
+
+	};
+
+	void read(uint8_t* item, uint32_t&) override {
+
+		uint16_t rgb[3];
+		decode_rgb(this->decoder, this->models, this->last_item, rgb);
+		std::memcpy(item, rgb, 6);
+
+	};
+
+};
+
+//extra bytes, each one coded as the difference to its last value
+struct Byte_v2_Decoder : Item_Decoder {
+
+	Arithmetic_Decoder& decoder;
+	std::vector<Arithmetic_Model> m_byte;
+	std::vector<uint8_t> last_item;
+
+	Byte_v2_Decoder(Arithmetic_Decoder& decoder, const uint16_t& n_bytes) : decoder(decoder), m_byte(n_bytes, Arithmetic_Model(256)), last_item(n_bytes) {};
+
+	void init(const uint8_t* item, uint32_t&, Chunk_Cursor&) override {
+
+		std::memcpy(this->last_item.data(), item, this->last_item.size());
+
+	};
+
+	void read(uint8_t* item, uint32_t&) override {
+
+		for (size_t i = 0; i < this->last_item.size(); i++) {
+
+			item[i] = fold_byte(this->last_item[i] + this->decoder.decode_symbol(this->m_byte[i]));
+			this->last_item[i] = item[i];
+
+		};
+
+	};
+
+};
+
+//hands the compressed bytes of one layer to its own decoder, layers without bytes didnt change within the chunk
+struct Layer {
+
+	Arithmetic_Decoder decoder;
+	uint64_t n_bytes = 0;
+	bool changed = false;
+
+	void init(Chunk_Cursor& chunk) {
+
+		const uint8_t* bytes = chunk.take(this->n_bytes);
+		this->changed = this->n_bytes > 0;
+		if (this->changed) { this->decoder.init(bytes, this->n_bytes); };
+
+	};
+
+};
+
+//the fields of a format 6 to 10 record as the layered POINT14 item tracks them
+struct Point14 {
+
+	int32_t X;
+	int32_t Y;
+	int32_t Z;
+	uint16_t intensity;
+	uint8_t return_number;
+	uint8_t number_of_returns;
+	uint8_t classification_flags;
+	uint8_t scanner_channel;
+	uint8_t scan_direction_flag;
+	uint8_t edge_of_flight_line;
+	uint8_t classification;
+	uint8_t user_data;
+	int16_t scan_angle;
+	uint16_t point_source_ID;
+	int64_t gps_time;
+	bool gps_time_change;
+
+	void from_record(const uint8_t* record) {
+
+		std::memcpy(&this->X, record, 4);
+		std::memcpy(&this->Y, record + 4, 4);
+		std::memcpy(&this->Z, record + 8, 4);
+		std::memcpy(&this->intensity, record + 12, 2);
+		this->return_number = record[14] & 0x0F;
+		this->number_of_returns = record[14] >> 4;
+		this->classification_flags = record[15] & 0x0F;
+		this->scanner_channel = (record[15] >> 4) & 0x03;
+		this->scan_direction_flag = (record[15] >> 6) & 0x01;
+		this->edge_of_flight_line = record[15] >> 7;
+		this->classification = record[16];
+		this->user_data = record[17];
+		std::memcpy(&this->scan_angle, record + 18, 2);
+		std::memcpy(&this->point_source_ID, record + 20, 2);
+		std::memcpy(&this->gps_time, record + 22, 8);
+		this->gps_time_change = false;
+
+	};
+
+	void to_record(uint8_t* record) const {
+
+		std::memcpy(record, &this->X, 4);
+		std::memcpy(record + 4, &this->Y, 4);
+		std::memcpy(record + 8, &this->Z, 4);
+		std::memcpy(record + 12, &this->intensity, 2);
+		record[14] = static_cast<uint8_t>(this->return_number | (this->number_of_returns << 4));
+		record[15] = static_cast<uint8_t>(this->classification_flags | (this->scanner_channel << 4) | (this->scan_direction_flag << 6) | (this->edge_of_flight_line << 7));
+		record[16] = this->classification;
+		record[17] = this->user_data;
+		std::memcpy(record + 18, &this->scan_angle, 2);
+		std::memcpy(record + 20, &this->point_source_ID, 2);
+		std::memcpy(record + 22, &this->gps_time, 8);
+
+	};
+
+};
+
+//the 30 byte core of formats 6 to 10, split into 9 layers that each have their own decoder. Every scanner channel keeps its own context of models and last values
+struct Point14_v3_Decoder : Item_Decoder {
+
+	static constexpr int32_t GPSTIME_MULTI_CODE_FULL = GPSTIME_MULTI - GPSTIME_MULTI_MINUS + 1;
+	static constexpr int32_t GPSTIME_MULTI_TOTAL = GPSTIME_MULTI - GPSTIME_MULTI_MINUS + 5;
+
+	enum { CHANNEL_RETURNS_XY, Z, CLASSIFICATION, FLAGS, INTENSITY, SCAN_ANGLE, USER_DATA, POINT_SOURCE, GPS_TIME, N_LAYERS };
+	Layer layers[N_LAYERS];
+
+	struct Context {
+
+		bool unused = true;
+		Point14 last_item;
+		uint16_t last_intensity[8];
+		Streaming_Median5 last_X_diff_median5[12];
+		Streaming_Median5 last_Y_diff_median5[12];
+		int32_t last_Z[8];
+
+		std::unique_ptr<Arithmetic_Model> m_changed_values[8];
+		std::unique_ptr<Arithmetic_Model> m_scanner_channel;
+		std::unique_ptr<Arithmetic_Model> m_number_of_returns[16];
+		std::unique_ptr<Arithmetic_Model> m_return_number_gps_same;
+		std::unique_ptr<Arithmetic_Model> m_return_number[16];
+		std::unique_ptr<Integer_Decompressor> ic_dX;
+		std::unique_ptr<Integer_Decompressor> ic_dY;
+		std::unique_ptr<Integer_Decompressor> ic_Z;
+
+		std::unique_ptr<Arithmetic_Model> m_classification[64];
+		std::unique_ptr<Arithmetic_Model> m_flags[64];
+		std::unique_ptr<Arithmetic_Model> m_user_data[64];
+
+		std::unique_ptr<Integer_Decompressor> ic_intensity;
+		std::unique_ptr<Integer_Decompressor> ic_scan_angle;
+		std::unique_ptr<Integer_Decompressor> ic_point_source_ID;
+
+		GPS_Time_Sequences sequences;
+		std::unique_ptr<Arithmetic_Model> m_gpstime_multi;
+		std::unique_ptr<Arithmetic_Model> m_gpstime_0diff;
+		std::unique_ptr<Integer_Decompressor> ic_gpstime;
+
+	};
+	Context contexts[4];
+	uint32_t current_context;
+
+	static Arithmetic_Model& get_model(std::unique_ptr<Arithmetic_Model>& model, const uint32_t& n_symbols) {
+
+		if (!model) { model = std::make_unique<Arithmetic_Model>(n_symbols); };
+		return *model;
+
+	};
+
+	void create_context(const uint32_t& c, const Point14& item) {
+
+		Context& context = this->contexts[c];
+		for (int i = 0; i < 8; i++) { context.m_changed_values[i] = std::make_unique<Arithmetic_Model>(128); };
+		context.m_scanner_channel = std::make_unique<Arithmetic_Model>(3);
+		context.m_return_number_gps_same = std::make_unique<Arithmetic_Model>(13);
+		context.ic_dX = std::make_unique<Integer_Decompressor>(this->layers[CHANNEL_RETURNS_XY].decoder, 32, 2);
+		context.ic_dY = std::make_unique<Integer_Decompressor>(this->layers[CHANNEL_RETURNS_XY].decoder, 32, 22);
+		context.ic_Z = std::make_unique<Integer_Decompressor>(this->layers[Z].decoder, 32, 20);
+		context.ic_intensity = std::make_unique<Integer_Decompressor>(this->layers[INTENSITY].decoder, 16, 4);
+		context.ic_scan_angle = std::make_unique<Integer_Decompressor>(this->layers[SCAN_ANGLE].decoder, 16, 2);
+		context.ic_point_source_ID = std::make_unique<Integer_Decompressor>(this->layers[POINT_SOURCE].decoder, 16);
+		context.m_gpstime_multi = std::make_unique<Arithmetic_Model>(GPSTIME_MULTI_TOTAL);
+		context.m_gpstime_0diff = std::make_unique<Arithmetic_Model>(5);
+		context.ic_gpstime = std::make_unique<Integer_Decompressor>(this->layers[GPS_TIME].decoder, 32, 9);
+
+		for (int i = 0; i < 8; i++) {
+
+			context.last_Z[i] = item.Z;
+			context.last_intensity[i] = item.intensity;
+
+		};
+		context.sequences = GPS_Time_Sequences();
+		context.sequences.last_gpstime[0] = item.gps_time;
+
+		context.last_item = item;
+		context.last_item.gps_time_change = false;
+		context.unused = false;
+
+	};
+
+	void read_layer_sizes(Chunk_Cursor& chunk) override {
+
+		for (Layer& layer : this->layers) { layer.n_bytes = chunk.read_uint32(); };
+
+	};
+
+	void init(const uint8_t* item, uint32_t& context, Chunk_Cursor& chunk) override {
+
+		for (Layer& layer : this->layers) { layer.init(chunk); };
+
+		Point14 point;
+		point.from_record(item);
+		this->current_context = point.scanner_channel;
+		context = this->current_context;
+		this->create_context(this->current_context, point);
+
+	};
+
+	void read_gps_time(Context& context) {
+
+		GPS_Time_Sequences& sequences = context.sequences;
+		Arithmetic_Decoder& decoder = this->layers[GPS_TIME].decoder;
+		while (true) {
+
+			const uint32_t last = sequences.last;
+			if (sequences.last_gpstime_diff[last] == 0) {
+
+				int32_t multi = decoder.decode_symbol(*context.m_gpstime_0diff);
+				if (multi == 0) {
+
+					sequences.last_gpstime_diff[last] = context.ic_gpstime->decompress(0, 0);
+					sequences.last_gpstime[last] += sequences.last_gpstime_diff[last];
+					sequences.multi_extreme_counter[last] = 0;
+
+				}
+				else if (multi == 1) { decode_full_gps_time(sequences, *context.ic_gpstime, decoder); }
+				else { sequences.last = (last + multi - 1) & 3; continue; };
+
+			}
+			else {
+
+				int32_t multi = decoder.decode_symbol(*context.m_gpstime_multi);
+				if (multi == 1) {
+
+					sequences.last_gpstime[last] += context.ic_gpstime->decompress(sequences.last_gpstime_diff[last], 1);
+					sequences.multi_extreme_counter[last] = 0;
+
+				}
+				else if (multi < GPSTIME_MULTI_CODE_FULL) { decode_gps_time_difference(sequences, *context.ic_gpstime, multi); }
+				else if (multi == GPSTIME_MULTI_CODE_FULL) { decode_full_gps_time(sequences, *context.ic_gpstime, decoder); }
+				else { sequences.last = (last + multi - GPSTIME_MULTI_CODE_FULL) & 3; continue; };
+
+			};
+			break;
+
+		};
+
+	};
+
+	void read(uint8_t* item, uint32_t& context) override {
+
+		Arithmetic_Decoder& XY = this->layers[CHANNEL_RETURNS_XY].decoder;
+		Context* current = &this->contexts[this->current_context];
+		Point14* last = &current->last_item;
+
+		//whether the last point was a first and/or last return and whether its GPS time changed pick the model of which fields changed
+		int32_t lpr = (last->return_number == 1 ? 1 : 0);
+		lpr += (last->return_number >= last->number_of_returns ? 2 : 0);
+		lpr += (last->gps_time_change ? 4 : 0);
+		uint32_t changed_values = XY.decode_symbol(*current->m_changed_values[lpr]);
+
+		if (changed_values & (1 << 6)) {
+
+			uint32_t scanner_channel = (this->current_context + XY.decode_symbol(*current->m_scanner_channel) + 1) % 4;
+			if (this->contexts[scanner_channel].unused) { this->create_context(scanner_channel, current->last_item); };
+			this->current_context = scanner_channel;
+			context = scanner_channel;
+			current = &this->contexts[scanner_channel];
+			last = &current->last_item;
+			last->scanner_channel = static_cast<uint8_t>(scanner_channel);
+
+		};
+
+		bool point_source_change = changed_values & (1 << 5);
+		bool gps_time_change = changed_values & (1 << 4);
+		bool scan_angle_change = changed_values & (1 << 3);
+
+		uint32_t last_n = last->number_of_returns;
+		uint32_t last_r = last->return_number;
+
+		uint32_t n = last_n;
+		if (changed_values & (1 << 2)) {
+
+			n = XY.decode_symbol(get_model(current->m_number_of_returns[last_n], 16));
+			last->number_of_returns = static_cast<uint8_t>(n);
+
+		};
+
+		uint32_t r;
+		switch (changed_values & 3) {
+
+			case 0: { r = last_r; break; };
+			case 1: { r = (last_r + 1) % 16; break; };
+			case 2: { r = (last_r + 15) % 16; break; };
+			default: {
+
+				if (gps_time_change) { r = XY.decode_symbol(get_model(current->m_return_number[last_r], 16)); }
+				else { r = (last_r + XY.decode_symbol(*current->m_return_number_gps_same) + 2) % 16; };
+				break;
+
+			};
+
+		};
+		last->return_number = static_cast<uint8_t>(r);
+
+		uint32_t m = NUMBER_RETURN_MAP_6_CONTEXTS[n][r];
+		uint32_t l = NUMBER_RETURN_LEVEL_8_CONTEXTS[n][r];
+
+		//single (3), first (2), last (1) or intermediate (0) return
+		int32_t cpr = (r == 1 ? 2 : 0) + (r >= n ? 1 : 0);
+
+		uint32_t median_index = (m << 1) | (gps_time_change ? 1 : 0);
+		int32_t diff = current->ic_dX->decompress(current->last_X_diff_median5[median_index].get(), n == 1);
+		last->X = static_cast<int32_t>(static_cast<uint32_t>(last->X) + static_cast<uint32_t>(diff));
+		current->last_X_diff_median5[median_index].add(diff);
+
+		uint32_t k_bits = current->ic_dX->k;
+		diff = current->ic_dY->decompress(current->last_Y_diff_median5[median_index].get(), (n == 1) + (k_bits < 20 ? (k_bits & ~1u) : 20));
+		last->Y = static_cast<int32_t>(static_cast<uint32_t>(last->Y) + static_cast<uint32_t>(diff));
+		current->last_Y_diff_median5[median_index].add(diff);
+
+		if (this->layers[Z].changed) {
+
+			k_bits = (current->ic_dX->k + current->ic_dY->k) / 2;
+			last->Z = current->ic_Z->decompress(current->last_Z[l], (n == 1) + (k_bits < 18 ? (k_bits & ~1u) : 18));
+			current->last_Z[l] = last->Z;
+
+		};
+
+		if (this->layers[CLASSIFICATION].changed) {
+
+			uint32_t ccc = ((last->classification & 0x1F) << 1) + (cpr == 3 ? 1 : 0);
+			last->classification = static_cast<uint8_t>(this->layers[CLASSIFICATION].decoder.decode_symbol(get_model(current->m_classification[ccc], 256)));
+
+		};
+
+		if (this->layers[FLAGS].changed) {
+
+			uint32_t last_flags = (last->edge_of_flight_line << 5) | (last->scan_direction_flag << 4) | last->classification_flags;
+			uint32_t flags = this->layers[FLAGS].decoder.decode_symbol(get_model(current->m_flags[last_flags], 64));
+			last->edge_of_flight_line = (flags >> 5) & 1;
+			last->scan_direction_flag = (flags >> 4) & 1;
+			last->classification_flags = flags & 0x0F;
+
+		};
+
+		if (this->layers[INTENSITY].changed) {
+
+			uint32_t index = (cpr << 1) | (gps_time_change ? 1 : 0);
+			last->intensity = static_cast<uint16_t>(current->ic_intensity->decompress(current->last_intensity[index], cpr));
+			current->last_intensity[index] = last->intensity;
+
+		};
+
+		if (this->layers[SCAN_ANGLE].changed && scan_angle_change) { last->scan_angle = static_cast<int16_t>(current->ic_scan_angle->decompress(last->scan_angle, gps_time_change)); };
+
+		if (this->layers[USER_DATA].changed) { last->user_data = static_cast<uint8_t>(this->layers[USER_DATA].decoder.decode_symbol(get_model(current->m_user_data[last->user_data / 4], 256))); };
+
+		if (this->layers[POINT_SOURCE].changed && point_source_change) { last->point_source_ID = static_cast<uint16_t>(current->ic_point_source_ID->decompress(last->point_source_ID)); };
+
+		if (this->layers[GPS_TIME].changed && gps_time_change) {
+
+			this->read_gps_time(*current);
+			last->gps_time = current->sequences.last_gpstime[current->sequences.last];
+
+		};
+
+		last->to_record(item);
+		last->gps_time_change = gps_time_change;
+
+	};
+
+};
+
+//RGB of formats 7 and 8 plus the near infrared of format 8, in one layer each. Follows the scanner channel of the POINT14 item
+struct RGBNIR14_v3_Decoder : Item_Decoder {
+
+	struct NIR_Models {
+
+		Arithmetic_Model m_nir_bytes_used = Arithmetic_Model(4);
+		Arithmetic_Model m_nir_diff_0 = Arithmetic_Model(256);
+		Arithmetic_Model m_nir_diff_1 = Arithmetic_Model(256);
+
+	};
+
+	struct Context {
+
+		bool unused = true;
+		std::unique_ptr<RGB_Models> rgb_models;
+		std::unique_ptr<NIR_Models> nir_models;
+		uint16_t last_item[4];
+
+	};
+
+	bool has_NIR;
+	Layer RGB_layer;
+	Layer NIR_layer;
+	Context contexts[4];
+	uint32_t current_context;
+
+	RGBNIR14_v3_Decoder(const bool& has_NIR) : has_NIR(has_NIR) {};
+
+	void create_context(const uint32_t& c, const uint16_t* item) {
+
+		Context& context = this->contexts[c];
+		context.rgb_models = std::make_unique<RGB_Models>();
+		if (this->has_NIR) { context.nir_models = std::make_unique<NIR_Models>(); };
+		std::memcpy(context.last_item, item, sizeof(context.last_item));
+		context.unused = false;
+
+	};
+
+	void read_layer_sizes(Chunk_Cursor& chunk) override {
+
+		this->RGB_layer.n_bytes = chunk.read_uint32();
+		if (this->has_NIR) { this->NIR_layer.n_bytes = chunk.read_uint32(); };
+
+	};
+
+	void init(const uint8_t* item, uint32_t& context, Chunk_Cursor& chunk) override {
+
+		this->RGB_layer.init(chunk);
+		if (this->has_NIR) { this->NIR_layer.init(chunk); };
+
+		uint16_t first[4] = { 0, 0, 0, 0 };
+		std::memcpy(first, item, this->has_NIR ? 8 : 6);
+		for (Context& c : this->contexts) { c.unused = true; };
+		this->current_context = context;
+		this->create_context(this->current_context, first);
+
+	};
+
+	void read(uint8_t* item, uint32_t& context) override {
+
+		uint16_t* last = this->contexts[this->current_context].last_item;
+		if (this->current_context != context) {
+
+			this->current_context = context;
+			if (this->contexts[context].unused) { this->create_context(context, last); };
+			last = this->contexts[context].last_item;
+
+		};
+		Context& current = this->contexts[this->current_context];
+
+		uint16_t rgbnir[4];
+		if (this->RGB_layer.changed) { decode_rgb(this->RGB_layer.decoder, *current.rgb_models, last, rgbnir); }
+		else { std::memcpy(rgbnir, last, 6); };
+
+		if (this->has_NIR) {
+
+			if (this->NIR_layer.changed) {
+
+				Arithmetic_Decoder& decoder = this->NIR_layer.decoder;
+				uint32_t symbol = decoder.decode_symbol(current.nir_models->m_nir_bytes_used);
+				if (symbol & 1) { rgbnir[3] = fold_byte(decoder.decode_symbol(current.nir_models->m_nir_diff_0) + (last[3] & 255)); }
+				else { rgbnir[3] = last[3] & 0xFF; };
+				if (symbol & 2) { rgbnir[3] |= static_cast<uint16_t>(fold_byte(decoder.decode_symbol(current.nir_models->m_nir_diff_1) + (last[3] >> 8))) << 8; }
+				else { rgbnir[3] |= last[3] & 0xFF00; };
+				last[3] = rgbnir[3];
+
+			}
+			else {
+
+				rgbnir[3] = last[3];
+
+			};
+
+		};
+
+		std::memcpy(item, rgbnir, this->has_NIR ? 8 : 6);
+
+	};
+
+};
+
+//extra bytes of formats 6 to 10, one layer per byte
+struct Byte14_v3_Decoder : Item_Decoder {
+
+	struct Context {
+
+		bool unused = true;
+		std::vector<Arithmetic_Model> m_bytes;
+		std::vector<uint8_t> last_item;
+
+	};
+
+	std::vector<Layer> layers;
+	Context contexts[4];
+	uint32_t current_context;
+
+	Byte14_v3_Decoder(const uint16_t& n_bytes) : layers(n_bytes) {};
+
+	void create_context(const uint32_t& c, const uint8_t* item) {
+
+		Context& context = this->contexts[c];
+		context.m_bytes.assign(this->layers.size(), Arithmetic_Model(256));
+		context.last_item.assign(item, item + this->layers.size());
+		context.unused = false;
+
+	};
+
+	void read_layer_sizes(Chunk_Cursor& chunk) override {
+
+		for (Layer& layer : this->layers) { layer.n_bytes = chunk.read_uint32(); };
+
+	};
+
+	void init(const uint8_t* item, uint32_t& context, Chunk_Cursor& chunk) override {
+
+		for (Layer& layer : this->layers) { layer.init(chunk); };
+		for (Context& c : this->contexts) { c.unused = true; };
+		this->current_context = context;
+		this->create_context(this->current_context, item);
+
+	};
+
+	void read(uint8_t* item, uint32_t& context) override {
+
+		if (this->current_context != context) {
+
+			const uint8_t* last = this->contexts[this->current_context].last_item.data();
+			this->current_context = context;
+			if (this->contexts[context].unused) { this->create_context(context, last); };
+
+		};
+		Context& current = this->contexts[this->current_context];
+
+		for (size_t i = 0; i < this->layers.size(); i++) {
+
+			if (this->layers[i].changed) { current.last_item[i] = fold_byte(current.last_item[i] + this->layers[i].decoder.decode_symbol(current.m_bytes[i])); };
+			item[i] = current.last_item[i];
+
+		};
+
+	};
+
+};
+
+//the item decoders of one chunk, the pointwise ones all share *decoder*
+static std::vector<std::unique_ptr<Item_Decoder>> create_item_decoders(const std::vector<LAZ_Decoder::Item>& items, Arithmetic_Decoder& decoder) {
+
+	std::vector<std::unique_ptr<Item_Decoder>> item_decoders;
+	for (const LAZ_Decoder::Item& item : items) {
+
+		switch (item.type) {
+
+			case LAZ_Decoder::ITEM_POINT10: { item_decoders.emplace_back(std::make_unique<Point10_v2_Decoder>(decoder)); break; };
+			case LAZ_Decoder::ITEM_GPSTIME11: { item_decoders.emplace_back(std::make_unique<GPS_Time11_v2_Decoder>(decoder)); break; };
+			case LAZ_Decoder::ITEM_RGB12: { item_decoders.emplace_back(std::make_unique<RGB12_v2_Decoder>(decoder)); break; };
+			case LAZ_Decoder::ITEM_BYTE: { item_decoders.emplace_back(std::make_unique<Byte_v2_Decoder>(decoder, item.size)); break; };
+			case LAZ_Decoder::ITEM_POINT14: { item_decoders.emplace_back(std::make_unique<Point14_v3_Decoder>()); break; };
+			case LAZ_Decoder::ITEM_RGB14: { item_decoders.emplace_back(std::make_unique<RGBNIR14_v3_Decoder>(false)); break; };
+			case LAZ_Decoder::ITEM_RGBNIR14: { item_decoders.emplace_back(std::make_unique<RGBNIR14_v3_Decoder>(true)); break; };
+			case LAZ_Decoder::ITEM_BYTE14: { item_decoders.emplace_back(std::make_unique<Byte14_v3_Decoder>(item.size)); break; };
+
+		};
+
+	};
+
+	return item_decoders;
+
+};
+
+/////////LAZ DECODER
+
+LAZ_Decoder::LAZ_Decoder(const char* laszip_record, const uint64_t& laszip_record_length, const uint16_t& point_data_record_length) :
+
+	point_data_record_length(point_data_record_length),
+	number_of_point_records(0),
+	file_data(nullptr),
+	file_size(0) {
+
+	LASzip_Record_Header header;
+	if (laszip_record_length < sizeof(header)) { std::cerr << "ERROR: LASzip VLR is too short!\n"; exit(EXIT_FAILURE); };
+	std::memcpy(&header, laszip_record, sizeof(header));
+	if (laszip_record_length < sizeof(header) + header.number_of_items * sizeof(Item)) { std::cerr << "ERROR: LASzip VLR is too short for its " << header.number_of_items << " items!\n"; exit(EXIT_FAILURE); };
+
+	this->compressor = header.compressor;
+	this->chunk_size = header.chunk_size;
+	this->items.resize(header.number_of_items);
+	std::memcpy(this->items.data(), laszip_record + sizeof(header), header.number_of_items * sizeof(Item));
+
+	if (header.coder != 0) { std::cerr << "ERROR: unsupported LASzip coder " << header.coder << "!\n"; exit(EXIT_FAILURE); };
+	if (this->compressor != COMPRESSOR_POINTWISE_CHUNKED && this->compressor != COMPRESSOR_LAYERED_CHUNKED) { std::cerr << "ERROR: unsupported LASzip compressor " << this->compressor << ", only chunked LAZ files can be read!\n"; exit(EXIT_FAILURE); };
+	if (this->chunk_size == 0) { std::cerr << "ERROR: LASzip chunk size is zero!\n"; exit(EXIT_FAILURE); };
+
+	//the pointwise compressor of LASzip 2 and the layered one of LASzip 3 each only come with their own item versions
+	uint64_t items_size = 0;
+	for (const Item& item : this->items) {
+
+		bool supported;
+		switch (item.type) {
+
+			case ITEM_POINT10: { supported = this->compressor == COMPRESSOR_POINTWISE_CHUNKED && item.version == 2 && item.size == 20; break; };
+			case ITEM_GPSTIME11: { supported = this->compressor == COMPRESSOR_POINTWISE_CHUNKED && item.version == 2 && item.size == 8; break; };
+			case ITEM_RGB12: { supported = this->compressor == COMPRESSOR_POINTWISE_CHUNKED && item.version == 2 && item.size == 6; break; };
+			case ITEM_BYTE: { supported = this->compressor == COMPRESSOR_POINTWISE_CHUNKED && item.version == 2 && item.size > 0; break; };
+			case ITEM_POINT14: { supported = this->compressor == COMPRESSOR_LAYERED_CHUNKED && (item.version == 3 || item.version == 4) && item.size == 30; break; };
+			case ITEM_RGB14: { supported = this->compressor == COMPRESSOR_LAYERED_CHUNKED && (item.version == 3 || item.version == 4) && item.size == 6; break; };
+			case ITEM_RGBNIR14: { supported = this->compressor == COMPRESSOR_LAYERED_CHUNKED && (item.version == 3 || item.version == 4) && item.size == 8; break; };
+			case ITEM_BYTE14: { supported = this->compressor == COMPRESSOR_LAYERED_CHUNKED && (item.version == 3 || item.version == 4) && item.size > 0; break; };
+			default: { supported = false; break; };
+
+		};
+		if (!supported) { std::cerr << "ERROR: unsupported LASzip item type " << item.type << " version " << item.version << " size " << item.size << ", waveform LAZ files cant be read!\n"; exit(EXIT_FAILURE); };
+		items_size += item.size;
+
+	};
+	if (this->items.empty() || (this->items[0].type != ITEM_POINT10 && this->items[0].type != ITEM_POINT14)) { std::cerr << "ERROR: LASzip items dont start with a point!\n"; exit(EXIT_FAILURE); };
+	if (items_size != point_data_record_length) { std::cerr << "ERROR: LASzip items cover " << items_size << " bytes but the point data record length is " << point_data_record_length << "!\n"; exit(EXIT_FAILURE); };
+
+};
+
+LAZ_Decoder::LAZ_Decoder(const char* file_data, const size_t& file_size, const char* laszip_record, const uint64_t& laszip_record_length, const uint64_t& offset_to_point_data, const uint64_t& number_of_point_records, const uint16_t& point_data_record_length) :
+
+	LAZ_Decoder(laszip_record, laszip_record_length, point_data_record_length) {
+
+	this->file_data = file_data;
+	this->file_size = file_size;
+	this->number_of_point_records = number_of_point_records;
+	this->read_chunk_table(offset_to_point_data);
+
+};
+
+void LAZ_Decoder::read_chunk_table(const uint64_t& offset_to_point_data) {
+
+	//the point data block starts with the offset of the chunk table, the chunks follow right after it
+	if (offset_to_point_data > this->file_size || this->file_size - offset_to_point_data < 8) { std::cerr << "ERROR: LAZ file is truncated, no chunk table offset!\n"; exit(EXIT_FAILURE); };
+	int64_t chunk_table_offset;
+	std::memcpy(&chunk_table_offset, this->file_data + offset_to_point_data, 8);
+	const uint64_t chunks_start = offset_to_point_data + 8;
+
+	//writers that couldnt seek back store the offset in the last 8 bytes of the file instead
+	if (chunk_table_offset == -1) { std::memcpy(&chunk_table_offset, this->file_data + this->file_size - 8, 8); };
+	if (chunk_table_offset < static_cast<int64_t>(chunks_start) || static_cast<uint64_t>(chunk_table_offset) > this->file_size - 8) { std::cerr << "ERROR: LAZ chunk table offset " << chunk_table_offset << " is invalid, the file may not have been fully written!\n"; exit(EXIT_FAILURE); };
+
+	uint32_t version, number_of_chunks;
+	std::memcpy(&version, this->file_data + chunk_table_offset, 4);
+	std::memcpy(&number_of_chunks, this->file_data + chunk_table_offset + 4, 4);
+	if (version != 0) { std::cerr << "ERROR: unsupported LAZ chunk table version " << version << "!\n"; exit(EXIT_FAILURE); };
+
+	//the point counts (only for variable chunks) and byte sizes of the chunks are compressed, each predicted by the one of the previous chunk
+	Arithmetic_Decoder decoder;
+	decoder.init(reinterpret_cast<const uint8_t*>(this->file_data) + chunk_table_offset + 8, this->file_size - chunk_table_offset - 8);
+	Integer_Decompressor ic(decoder, 32, 2);
+
+	this->chunk_offsets.assign(1, chunks_start);
+	this->chunk_first_points.assign(1, 0);
+	uint32_t last_count = 0, last_size = 0;
+	for (uint32_t i = 0; i < number_of_chunks; i++) {
+
+		uint64_t count = this->chunk_size;
+		if (this->chunk_size == VARIABLE_CHUNK_SIZE) { count = last_count = static_cast<uint32_t>(ic.decompress(last_count, 0)); };
+		last_size = static_cast<uint32_t>(ic.decompress(last_size, 1));
+
+		this->chunk_offsets.push_back(this->chunk_offsets.back() + last_size);
+		this->chunk_first_points.push_back(std::min(this->chunk_first_points.back() + count, this->number_of_point_records));
+		if (this->chunk_offsets.back() > static_cast<uint64_t>(chunk_table_offset)) { std::cerr << "ERROR: LAZ chunk " << i << " runs past the chunk table!\n"; exit(EXIT_FAILURE); };
+
+	};
+
+	if (this->chunk_first_points.back() < this->number_of_point_records) { std::cerr << "ERROR: LAZ chunk table only covers " << this->chunk_first_points.back() << " of " << this->number_of_point_records << " points!\n"; exit(EXIT_FAILURE); };
+
+};
+
+size_t LAZ_Decoder::get_chunk_of_point(const uint64_t& point) const {
+
+	return std::upper_bound(this->chunk_first_points.begin(), this->chunk_first_points.end(), point) - this->chunk_first_points.begin() - 1;
+
+};
+
+void LAZ_Decoder::decompress(uint64_t first_point, const uint64_t& last_point, char* records) const {
+
+	for (size_t chunk = this->get_chunk_of_point(first_point); first_point < last_point; chunk++) {
+
+		const uint64_t chunk_first_point = this->chunk_first_points[chunk];
+		const uint64_t chunk_last_point = std::min(last_point, this->chunk_first_points[chunk + 1]);
+		this->decompress_chunk(this->file_data + this->chunk_offsets[chunk], this->chunk_offsets[chunk + 1] - this->chunk_offsets[chunk], this->chunk_first_points[chunk + 1] - chunk_first_point,
+			first_point - chunk_first_point, chunk_last_point - chunk_first_point, records);
+
+		records += (chunk_last_point - first_point) * this->point_data_record_length;
+		first_point = chunk_last_point;
+
+	};
+
+};
+
+void LAZ_Decoder::decompress_chunk(const char* chunk_data, const uint64_t& chunk_n_bytes, const uint64_t& n_points_in_chunk, const uint64_t& first_in_chunk, const uint64_t& last_in_chunk, char* records) const {
+
+	if (last_in_chunk > n_points_in_chunk || first_in_chunk >= last_in_chunk) { return; };
+
+	const uint64_t record_length = this->point_data_record_length;
+	Chunk_Cursor chunk = { reinterpret_cast<const uint8_t*>(chunk_data), reinterpret_cast<const uint8_t*>(chunk_data) + chunk_n_bytes };
+	if (chunk_n_bytes < record_length) { std::cerr << "ERROR: LAZ chunk of " << chunk_n_bytes << " bytes cant even hold its first point!\n"; exit(EXIT_FAILURE); };
+
+	//the first point of a chunk is stored raw and starts the history of every item
+	std::vector<uint8_t> record(chunk.data, chunk.data + record_length);
+	chunk.data += record_length;
+
+	Arithmetic_Decoder decoder;
+	std::vector<std::unique_ptr<Item_Decoder>> item_decoders = create_item_decoders(this->items, decoder);
+	uint32_t context = 0;
+	if (this->compressor == COMPRESSOR_LAYERED_CHUNKED) {
+
+		//layered chunks store their point count and the size of every layer before the layers
+		chunk.read_uint32();
+		for (std::unique_ptr<Item_Decoder>& item_decoder : item_decoders) { item_decoder->read_layer_sizes(chunk); };
+
+	};
+	uint8_t* item = record.data();
+	for (size_t i = 0; i < item_decoders.size(); i++) {
+
+		item_decoders[i]->init(item, context, chunk);
+		item += this->items[i].size;
+
+	};
+	if (this->compressor == COMPRESSOR_POINTWISE_CHUNKED) { decoder.init(chunk.data, chunk.end - chunk.data); };
+
+	for (uint64_t point = 0; point < last_in_chunk; point++) {
+
+		if (point > 0) {
+
+			item = record.data();
+			for (size_t i = 0; i < item_decoders.size(); i++) {
+
+				item_decoders[i]->read(item, context);
+				item += this->items[i].size;
+
+			};
+
+		};
+
+		if (point >= first_in_chunk) {
+
+			std::memcpy(records, record.data(), record_length);
+			records += record_length;
+
+		};
+
+	};
+
+};
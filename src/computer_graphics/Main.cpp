@@ -42,6 +42,8 @@ int main() {
 		shader.create_uniform_float(mesh.maximum_bounds.z, "max_height");
 		//mouse.update(shader, window, screen_size, plot);
 
+		shader.stream_mesh_buffers(mesh);
+		shader.update_octree_buffers(mesh);
 		shader.draw_mesh_elements(mesh, GL_PRIMITIVE_TYPE);
 		user_interface.render();
 			
@@ -238,6 +238,31 @@ Texture::~Texture() {
 
 };
 
+//quantizes the positions inside the box and the colors to 8 bits per channel
+void Quantized_Point::quantize(const vec3* positions, const vec3* colors, const size_t& n_points, const vec3& box_minimum, const vec3& box_size, Quantized_Point* quantized_points) {
+
+	//flat boxes put all their points on the minimum of the flat axis
+	const vec3 position_scale(box_size.x > 0.0f ? 65535.0f / box_size.x : 0.0f, box_size.y > 0.0f ? 65535.0f / box_size.y : 0.0f, box_size.z > 0.0f ? 65535.0f / box_size.z : 0.0f);
+	Thread_Pool::shared().parallel_for(n_points, 65536, [&](const size_t& first, const size_t& last) {
+
+		for (size_t i = first; i < last; i++) {
+
+			Quantized_Point& point = quantized_points[i];
+			point.x = static_cast<uint16_t>(std::clamp((positions[i].x - box_minimum.x) * position_scale.x, 0.0f, 65535.0f) + 0.5f);
+			point.y = static_cast<uint16_t>(std::clamp((positions[i].y - box_minimum.y) * position_scale.y, 0.0f, 65535.0f) + 0.5f);
+			point.z = static_cast<uint16_t>(std::clamp((positions[i].z - box_minimum.z) * position_scale.z, 0.0f, 65535.0f) + 0.5f);
+			point.padding = 0;
+			point.red = static_cast<uint8_t>(std::clamp(colors[i].x, 0.0f, 1.0f) * 255.0f + 0.5f);
+			point.green = static_cast<uint8_t>(std::clamp(colors[i].y, 0.0f, 1.0f) * 255.0f + 0.5f);
+			point.blue = static_cast<uint8_t>(std::clamp(colors[i].z, 0.0f, 1.0f) * 255.0f + 0.5f);
+			point.alpha = 255;
+
+		};
+
+	});
+
+};
+
 //sets the 4 inputed vertices as 1 single face on the mesh that represents a whole image, used in tiled meshes. VIP: HAS TO BE USED BEFORE THE INPUTED VERTICES ARE USED TO CONSTRUCT TRIANGLES.
 void Mesh::set_as_single_face(Vertex& top_left, Vertex& bottom_left, Vertex& top_right, Vertex& bottom_right) {
 
@@ -249,7 +274,7 @@ void Mesh::set_as_single_face(Vertex& top_left, Vertex& bottom_left, Vertex& top
 };
 
 //adds the vertex without checking if it has a duplicate in the buffer
-void Mesh::add_without_check(Vertex& vertex, int& index_counter) {
+void Mesh::add_without_check(Vertex& vertex, uint32_t& index_counter) {
 
 	vertex.index = index_counter;
 	this->indices.emplace_back(index_counter);
@@ -265,7 +290,7 @@ void Mesh::add_without_check(Vertex& vertex, int& index_counter) {
 
 };
 //override
-void Mesh::add_without_check(Triangle& triangle, int& index_counter) {
+void Mesh::add_without_check(Triangle& triangle, uint32_t& index_counter) {
 
 	add_without_check(triangle.A, index_counter);
 	add_without_check(triangle.B, index_counter);
@@ -274,24 +299,23 @@ void Mesh::add_without_check(Triangle& triangle, int& index_counter) {
 };
 
 //checks if the inputed vertex exists with the same position and uv coords. If yes then the same index of the original vertex will be emplaced again into the *indices* vector and its TBN will be accumalated.
-//If not then it will be inserted into the map and all its data will be emplaced into the respective data vectors
-void Mesh::check_accumalate_add(Vertex& vertex, int& index_counter) {
+//If not then it will be inserted into the table and all its data will be emplaced into the respective data vectors
+void Mesh::check_accumalate_add(Vertex& vertex, uint32_t& index_counter) {
 
-	auto key = std::make_tuple(vertex.position, vertex.normal, vertex.uv);
-	auto iterator = this->vertices_map.find(key);
-	if (iterator != this->vertices_map.end()) {
+	bool inserted = false;
+	const uint32_t index = this->vertices_table.find_or_insert(Vertex_Deduplicator::Key(vertex.position, vertex.normal, vertex.uv), index_counter, inserted);
+	if (!inserted) {
 
-		this->indices.emplace_back(iterator->second);
+		this->indices.emplace_back(index);
 
-		this->normals[iterator->second] += vertex.normal;
-		this->tangents[iterator->second] += vertex.tangent;
-		this->bitangents[iterator->second] += vertex.bitangent;
+		this->normals[index] += vertex.normal;
+		this->tangents[index] += vertex.tangent;
+		this->bitangents[index] += vertex.bitangent;
 
 	}
 	else {
 
 		vertex.index = index_counter;
-		this->vertices_map[key] = index_counter;
 		this->indices.emplace_back(index_counter);
 
 		this->positions.emplace_back(vertex.position);
@@ -307,7 +331,7 @@ void Mesh::check_accumalate_add(Vertex& vertex, int& index_counter) {
 	
 };
 //override
-void Mesh::check_accumalate_add(Triangle& triangle, int& index_counter) {
+void Mesh::check_accumalate_add(Triangle& triangle, uint32_t& index_counter) {
 
 	check_accumalate_add(triangle.A, index_counter);
 	check_accumalate_add(triangle.B, index_counter);
@@ -315,6 +339,85 @@ void Mesh::check_accumalate_add(Triangle& triangle, int& index_counter) {
 
 };
 
+void Mesh::deduplicate_vertices() {
+
+	std::vector<Vertex_Deduplicator::Key> keys(this->positions.size());
+	Thread_Pool::shared().parallel_for(keys.size(), 1 << 16, [&](const size_t& first, const size_t& last) {
+
+		for (size_t i = first; i < last; i++) { keys[i] = Vertex_Deduplicator::Key(this->positions[i], this->normals[i], this->texture_coordinates[i]); };
+
+	});
+
+	std::vector<uint32_t> unique_indices, first_occurrences;
+	const size_t n_unique = Vertex_Deduplicator::deduplicate_by_sorting(keys, unique_indices, first_occurrences);
+	keys = std::vector<Vertex_Deduplicator::Key>();
+
+	std::vector<vec3> positions(n_unique), normals(n_unique), tangents(n_unique), bitangents(n_unique), colors(n_unique);
+	std::vector<vec2> texture_coordinates(n_unique);
+	Thread_Pool::shared().parallel_for(n_unique, 1 << 16, [&](const size_t& first, const size_t& last) {
+
+		for (size_t i = first; i < last; i++) {
+
+			const uint32_t& occurrence = first_occurrences[i];
+			positions[i] = this->positions[occurrence];
+			normals[i] = this->normals[occurrence];
+			tangents[i] = this->tangents[occurrence];
+			bitangents[i] = this->bitangents[occurrence];
+			texture_coordinates[i] = this->texture_coordinates[occurrence];
+			colors[i] = this->colors[occurrence];
+
+		};
+
+	});
+
+	//the duplicates are accumalated in the order they were added, which is the order *check_accumalate_add* meets them in, so both end up with the same sums
+	for (size_t i = 0; i < unique_indices.size(); i++) {
+
+		const uint32_t& index = unique_indices[i];
+		if (first_occurrences[index] == i) { continue; };
+		normals[index] += this->normals[i];
+		tangents[index] += this->tangents[i];
+		bitangents[index] += this->bitangents[i];
+
+	};
+
+	for (unsigned int& index : this->indices) { index = unique_indices[index]; };
+
+	this->positions = std::move(positions);
+	this->normals = std::move(normals);
+	this->tangents = std::move(tangents);
+	this->bitangents = std::move(bitangents);
+	this->texture_coordinates = std::move(texture_coordinates);
+	this->colors = std::move(colors);
+
+};
+
+void Mesh::optimize_vertex_order(const uint32_t& cache_size) {
+
+	if (!this->draw_as_elements || this->indices.empty() || this->indices.size() % 3 != 0) { return; };
+
+	auto start = std::chrono::steady_clock::now();
+	const Mesh_Optimizer::Statistics before = Mesh_Optimizer::analyze_vertex_cache(this->indices, this->positions.size(), cache_size);
+
+	std::vector<uint32_t> clusters;
+	Mesh_Optimizer::optimize_vertex_cache(this->indices, this->positions.size(), cache_size, &clusters);
+	Mesh_Optimizer::optimize_overdraw(this->indices, this->positions, clusters, cache_size);
+
+	const std::vector<uint32_t> remap = Mesh_Optimizer::optimize_vertex_fetch(this->indices, this->positions.size());
+	Mesh_Optimizer::remap_vertices(this->positions, remap);
+	Mesh_Optimizer::remap_vertices(this->normals, remap);
+	Mesh_Optimizer::remap_vertices(this->tangents, remap);
+	Mesh_Optimizer::remap_vertices(this->bitangents, remap);
+	Mesh_Optimizer::remap_vertices(this->texture_coordinates, remap);
+	Mesh_Optimizer::remap_vertices(this->colors, remap);
+	Mesh_Optimizer::remap_vertices(this->curvatures, remap);
+
+	const Mesh_Optimizer::Statistics after = Mesh_Optimizer::analyze_vertex_cache(this->indices, this->positions.size(), cache_size);
+	std::chrono::duration<double> elapsed_time = std::chrono::steady_clock::now() - start;
+	std::cout << "optimized the vertex order of " << this->indices.size() / 3 << " triangles in " << elapsed_time.count() * 1000.0 << " ms, ACMR " << before.ACMR << " -> " << after.ACMR << ", ATVR " << before.ATVR << " -> " << after.ATVR << " for a cache of " << cache_size << " vertices\n";
+
+};
+
 void Mesh::generate_terrain(const uint8_t& ADD_VERTICES) {
 
 	/*the grid takes the width and height of our texture and fills it up as cells and not as points, hence the n_rows and n_columns is subtracted by 1 inorder to not go out of bounds when reaching the last point on a row or column.
@@ -326,8 +429,18 @@ void Mesh::generate_terrain(const uint8_t& ADD_VERTICES) {
 	vec3 half_size(this->mesh_dimensions / 2.0f, 0.0f);
 	vec3 color(0, 255, 0);
 	
+	//two triangles per cell, sizing the table by them leaves it at most half full since neighbouring cells share their corners
+	const size_t n_triangles = size_t(this->mesh_dimensions.x) * size_t(this->mesh_dimensions.y) * 2;
+	if (n_triangles * 3 > UINT32_MAX) {
+
+		std::cerr << "ERROR: a terrain of " << n_triangles << " triangles has more vertices than 32 bit indices can address\n";
+		exit(EXIT_FAILURE);
+
+	};
+	if (ADD_VERTICES == ADD_ONLY_UNIQUE_VERTICES) { this->vertices_table.reserve(n_triangles); };
+
 	//we traverse the grid by going to every row where we work on every column on said row.
-	int index_counter = 0;
+	uint32_t index_counter = 0;
 	for (int y = 0; y < this->mesh_dimensions.y; ++y) {
 
 		for (int x = 0; x < this->mesh_dimensions.x; ++x) {
@@ -372,7 +485,8 @@ void Mesh::generate_terrain(const uint8_t& ADD_VERTICES) {
 
 				};
 
-				case ADD_ALL_VERTICES: {
+				case ADD_ALL_VERTICES:
+				case ADD_ONLY_UNIQUE_VERTICES_BY_SORTING: {
 
 					add_without_check(A, index_counter);
 					add_without_check(B, index_counter);
@@ -393,8 +507,10 @@ void Mesh::generate_terrain(const uint8_t& ADD_VERTICES) {
 
 	};
 
+	if (ADD_VERTICES == ADD_ONLY_UNIQUE_VERTICES_BY_SORTING) { deduplicate_vertices(); };
+
 	//normalizing the TBN of each vertex after it was accumalated
-	if (ADD_VERTICES == ADD_ONLY_UNIQUE_VERTICES) {
+	if (ADD_VERTICES != ADD_ALL_VERTICES) {
 
 		for (int i = 0; i < this->positions.size(); i++) {
 
@@ -409,152 +525,169 @@ void Mesh::generate_terrain(const uint8_t& ADD_VERTICES) {
 	std::pair<vec3, vec3> bounds = get_min_max(this->positions);
 	this->minimum_bounds = bounds.first;
 	this->maximum_bounds = bounds.second;
+	if (ADD_VERTICES != ADD_ALL_VERTICES) { this->optimize_vertex_order(); };
 
 };
 
 //VIPNOTE: since alot of .obj files use quads instead of triangles whilst am using triangles, the number of vertices in the *positions* buffer will be more than the number of extracted vertices due to the transition from 4 vertices to 6 vertices.
 void Mesh::extract_from_OBJ_file(const std::filesystem::path& file_path, const uint8_t& ADD_VERTICES) {
 
-	std::vector<vec3> temp_positions;
-	std::vector<vec3> temp_normals;
-	std::vector<vec2> temp_uv;
-	int index_counter = 0;
-	vec3 vec(0, 0, 0);
-	
-	std::vector<Vertex> vertices;
-	Vertex vertex(0, 0, 0);
+	if (ADD_VERTICES != ADD_ONLY_UNIQUE_VERTICES && ADD_VERTICES != ADD_ALL_VERTICES && ADD_VERTICES != ADD_ONLY_UNIQUE_VERTICES_BY_SORTING) {
 
-	std::vector<std::string> lines = read_file_by_line(file_path);
-	std::vector<std::string> line_tokens;
-	std::string attribute_type;
+		std::cerr << "ERROR: invalid ADD_VERTICES type!\n";
+		exit(EXIT_FAILURE);
 
-	int v_index;
-	int vn_index;
-	int vt_index;
+	};
 
-	int n_faces = 0;
+	OBJ_Parser parser;
+	parser.parse(file_path);
 
-	for (auto& line : lines) {
+	//every corner can become a vertex of its own, and the indices are 32 bit
+	if (parser.triangle_corners.size() > UINT32_MAX) {
 
-		attribute_type = line.substr(0, 2);
+		std::cerr << "ERROR: the OBJ file has " << parser.triangle_corners.size() / 3 << " triangles, more than 32 bit indices can address\n";
+		exit(EXIT_FAILURE);
 
-		if (attribute_type == "vn") {
-	
-			safe_sscanf(line.c_str() + 3, "%f %f %f", 3, &vec.x, &vec.y, &vec.z);
-			temp_normals.emplace_back(vec.x, vec.y, vec.z);		
+	};
 
-		}
-		else if (attribute_type == "vt") {
+	//a closed triangle mesh has about half as many vertices as triangles, sizing the table by the triangles leaves room for the seams of the uvs and normals
+	uint32_t index_counter = 0;
+	if (ADD_VERTICES == ADD_ONLY_UNIQUE_VERTICES) { this->vertices_table.reserve(parser.triangle_corners.size() / 3); }
+	else {
 
-			safe_sscanf(line.c_str() + 3, "%f %f", 2, &vec.x, &vec.y);
-			temp_uv.emplace_back(vec.x, vec.y);
+		const size_t n_vertices = parser.triangle_corners.size();
+		this->indices.reserve(n_vertices);
+		this->positions.reserve(n_vertices);
+		this->normals.reserve(n_vertices);
+		this->tangents.reserve(n_vertices);
+		this->bitangents.reserve(n_vertices);
+		this->texture_coordinates.reserve(n_vertices);
+		this->colors.reserve(n_vertices);
 
-		}
-		else if (attribute_type == "v ") {
+	};
 
-			safe_sscanf(line.c_str() + 2, "%f %f %f", 3, &vec.x, &vec.y, &vec.z);
-			temp_positions.emplace_back(vec.x, vec.y, vec.z);
+	Vertex vertices[3] = { Vertex(0, 0, 0), Vertex(0, 0, 0), Vertex(0, 0, 0) };
+	for (size_t i = 0; i < parser.triangle_corners.size(); i += 3) {
 
-		}
-		else if (attribute_type == "f ") {
-			
-			vertices.clear();
-			line_tokens.clear();
-			line_tokens = tokenise_data(line.substr(2), ' ');
-			for (auto& line_token : line_tokens) {
+		for (int corner = 0; corner < 3; corner++) {
 
-				//searches first for *//* to check if we are working with the format: v//vn; otherwise the face command will have the format v/vt/vn
-				if (line_token.find("//") != std::string::npos) {
+			const OBJ_Parser::Corner& triangle_corner = parser.triangle_corners[i + corner];
+			Vertex& vertex = vertices[corner];
+			vertex.position = parser.positions[triangle_corner.position];
+			vertex.uv = triangle_corner.texture_coordinates >= 0 ? parser.texture_coordinates[triangle_corner.texture_coordinates] : vec2(0.0f, 0.0f);
+			vertex.tangent = vec3(1, 0, 0);
+			vertex.bitangent = vec3(0, 1, 0);
+			vertex.color = vec3(255, 0, 0);
 
-					safe_sscanf(line_token.c_str(), "%d//%d", 2, &v_index, &vn_index);
-					vertex.uv = vec2(0.0f, 0.0f);
+		};
 
-				}
-				else {//format: v/vt/vn
+		//the v and v/vt forms carry no normals, their triangles get the normal of their plane
+		const bool has_normals = parser.triangle_corners[i].normal >= 0 && parser.triangle_corners[i + 1].normal >= 0 && parser.triangle_corners[i + 2].normal >= 0;
+		const vec3 face_normal = has_normals ? vec3(0, 0, 0) : (vertices[1].position - vertices[0].position).cross(vertices[2].position - vertices[0].position);
+		const float face_normal_length = face_normal.magnitude();
+		for (int corner = 0; corner < 3; corner++) {
 
-					safe_sscanf(line_token.c_str(), "%d/%d/%d", 3, &v_index, &vt_index, &vn_index);
-					vertex.uv = temp_uv[vt_index - 1];
+			const int32_t& normal = parser.triangle_corners[i + corner].normal;
+			vertices[corner].normal = normal >= 0 ? parser.normals[normal] : face_normal_length > 0.0f ? face_normal / face_normal_length : vec3(0, 0, 1);
 
-				};
-	
-				vertex.position = temp_positions[v_index - 1];
-				vertex.normal = temp_normals[vn_index - 1];
-				vertex.tangent = vec3(1, 0, 0);
-				vertex.bitangent = vec3(0, 1, 0);
-				vertex.color = vec3(255, 0, 0);				
+		};
 
-				vertices.emplace_back(vertex);
+		for (int corner = 0; corner < 3; corner++) {
 
-			};
+			//checking for duplicates, accumalating TBNs, adding to our data vectors(buffers)
+			if (ADD_VERTICES == ADD_ONLY_UNIQUE_VERTICES) { check_accumalate_add(vertices[corner], index_counter); }
+			else { add_without_check(vertices[corner], index_counter); };
 
-			//creating triangles based off of the number of vertices we extracted from the face command as a triangle fan. Example: a,b,c,d = abc and acd. Example: a,b,c,d,e = abc and acd and ade.
-			int A = 0;
-			int B = 0;
-			int C = 0;
-			switch (ADD_VERTICES) {
+		};
 
-				case ADD_ONLY_UNIQUE_VERTICES: {
+	};
 
-					for (int i = 1; i < vertices.size() - 1; i++) {
-	
-						B = i;
-						C = i + 1;
+	if (ADD_VERTICES == ADD_ONLY_UNIQUE_VERTICES_BY_SORTING) { deduplicate_vertices(); };
 
-						//checking for duplicates, accumalating TBNs, adding to our data vectors(buffers)
-						check_accumalate_add(vertices[A], index_counter);
-						check_accumalate_add(vertices[B], index_counter);
-						check_accumalate_add(vertices[C], index_counter);
+	//normalizing the TBN of each vertex after it was accumalated
+	if (ADD_VERTICES != ADD_ALL_VERTICES) {
 
-						n_faces += 1;
+		for (int i = 0; i < this->positions.size(); i++) {
 
-					};
+			this->normals[i].normalize();
+			this->tangents[i].normalize();
+			this->bitangents[i].normalize();
 
-					break;
+		};
 
-				};
+	};
 
-				case ADD_ALL_VERTICES: {
+	std::pair<vec3, vec3> bounds = get_min_max(this->positions);
+	this->minimum_bounds = bounds.first;
+	this->maximum_bounds = bounds.second;
+	if (ADD_VERTICES != ADD_ALL_VERTICES) { this->optimize_vertex_order(); };
 
-					for (int i = 1; i < vertices.size() - 1; i++) {
-			
-						B = i;
-						C = i + 1;
+	std::cout << "n_extracted vertices from OBJ file = " << parser.positions.size() << "\n";
+	std::cout << "n_extracted faces from OBJ file = " << parser.number_of_faces << "\n";
 
-						add_without_check(vertices[A], index_counter);
-						add_without_check(vertices[B], index_counter);
-						add_without_check(vertices[C], index_counter);
+};
 
-						n_faces += 1;
+void Mesh::extract_from_LAS_file(const std::filesystem::path& file_path, const Point_Cloud::Point_Filter& point_filter, const bool& keep_point_attributes) {
 
-					};
+	auto start = std::chrono::steady_clock::now();
+	const bool filtered = point_filter.is_active();
+	this->keep_point_attributes = keep_point_attributes;
+	this->coordinate_reference_system = Point_Cloud::read_coordinate_reference_system(file_path);
+	if (!filtered) { this->point_cloud_cache = Point_Cloud_Cache::open(file_path); };
 
-					break;
+	//a cache written without the point attributes is decoded again, and rewritten with them
+	if (this->point_cloud_cache && keep_point_attributes && !this->point_cloud_cache->has_point_attributes()) { this->point_cloud_cache.reset(); };
+	if (this->point_cloud_cache) {
 
-				};
+		this->extra_bytes_columns = std::move(this->point_cloud_cache->extra_bytes_columns);
+		this->minimum_bounds = this->point_cloud_cache->minimum_bounds;
+		this->maximum_bounds = this->point_cloud_cache->maximum_bounds;
+		this->geospatial_frame = Point_Cloud::read_geospatial_frame(file_path);
 
-				default: {
+		std::chrono::duration<double> elapsed_time = std::chrono::steady_clock::now() - start;
+		std::cout << "opened " << this->point_cloud_cache->number_of_points << " points from the cache of " << file_path << " in " << elapsed_time.count() * 1000.0 << " ms\n";
+		return;
 
-					std::cerr << "ERROR: invalid ADD_VERTICES type!\n";
-					exit(EXIT_FAILURE);
+	};
 
-				};
+	Point_Cloud cloud;
+	cloud.extract_extra_bytes = true;
+	cloud.point_filter = point_filter;
+	cloud.extract_point_attributes = keep_point_attributes;
+	cloud.extract_openGL_points_attributes(file_path, this->positions, this->colors);
+	this->extra_bytes_columns = std::move(cloud.extra_bytes_columns);
+	this->point_attributes = std::move(cloud.point_attributes);
+	this->geospatial_frame = cloud.get_geospatial_frame();
+	std::pair<vec3, vec3> bounds = get_min_max(this->positions);
+	this->minimum_bounds = bounds.first;
+	this->maximum_bounds = bounds.second;
 
-			};
+	if (!filtered) { Point_Cloud_Cache::write(file_path, this->positions, this->colors, this->minimum_bounds, this->maximum_bounds, this->extra_bytes_columns, this->point_attributes); };
 
-		};
+};
 
-	};
+void Mesh::downsample_points(const float& voxel_size, const uint64_t& point_budget, const uint8_t& SELECTION) {
 
-	//normalizing the TBN of each vertex after it was accumalated
-	if (ADD_VERTICES == ADD_ONLY_UNIQUE_VERTICES) {
+	//the downsampled points are uploaded from the vectors instead of the cache
+	this->copy_points_out_of_cache();
 
-		for (int i = 0; i < this->positions.size(); i++) {
+	float size = voxel_size > 0.0f ? voxel_size : Voxel_Downsampler::compute_voxel_size(this->positions, point_budget);
+	if (size <= 0.0f) {
 
-			this->normals[i].normalize();
-			this->tangents[i].normalize();
-			this->bitangents[i].normalize();
+		return;
 
-		};
+	};
+	this->KD_tree.reset();
+	this->normals.clear();
+	this->curvatures.clear();
+	std::vector<uint32_t> representatives;
+	Voxel_Downsampler::downsample(this->positions, this->colors, size, SELECTION, 0, this->point_attributes.empty() ? nullptr : &representatives);
+	if (!this->point_attributes.empty()) { this->point_attributes = this->point_attributes.gather(representatives); };
+
+	//the values of the Extra Bytes columns belong to the original points, the kept columns only describe what the file holds
+	for (Point_Cloud::Extra_Bytes_Column& column : this->extra_bytes_columns) {
+
+		column.values.clear();
 
 	};
 
@@ -562,19 +695,172 @@ void Mesh::extract_from_OBJ_file(const std::filesystem::path& file_path, const u
 	this->minimum_bounds = bounds.first;
 	this->maximum_bounds = bounds.second;
 
-	std::cout << "n_extracted vertices from OBJ file = " << temp_positions.size() << "\n";
-	std::cout << "n_extracted faces from OBJ file = " << n_faces << "\n";
-
 };
 
-void Mesh::extract_from_LAS_file(const std::filesystem::path& file_path) {
+void Mesh::remove_outliers(const uint32_t& neighbours, const float& standard_deviations) {
+
+	if (!this->point_cloud_tiles.empty()) {
+
+		std::cerr << "WARNING: outliers arent removed from mosaics, every tile owns a fixed range of the points\n";
+		return;
+
+	};
+
+	this->copy_points_out_of_cache();
+	this->KD_tree.reset();
+	this->normals.clear();
+	this->curvatures.clear();
+
+	std::vector<uint32_t> kept;
+	const uint64_t n_points = this->positions.size();
+	if (Outlier_Filter::remove_statistical_outliers(this->positions, this->colors, neighbours, standard_deviations, &kept) == 0) { return; };
+	if (!this->point_attributes.empty()) { this->point_attributes = this->point_attributes.gather(kept); };
+
+	//unlike downsampling every point left is an original one, so the Extra Bytes values follow them
+	for (Point_Cloud::Extra_Bytes_Column& column : this->extra_bytes_columns) {
+
+		if (column.values.size() != n_points * column.size) { continue; };
+		for (size_t i = 0; i < kept.size(); i++) {
+
+			std::memmove(column.values.data() + i * column.size, column.values.data() + size_t(kept[i]) * column.size, column.size);
+
+		};
+		column.values.resize(kept.size() * column.size);
+		column.values.shrink_to_fit();
+
+	};
 
-	Point_Cloud cloud;
-	cloud.extract_openGL_points_attributes(file_path, this->positions, this->colors);
 	std::pair<vec3, vec3> bounds = get_min_max(this->positions);
 	this->minimum_bounds = bounds.first;
 	this->maximum_bounds = bounds.second;
 
+	//the frame was centred and scaled on the header bounds, which the outliers stretched, so the points left are centred and scaled again on their own bounds
+	const double scale_factor = this->geospatial_frame.scale_factor;
+	const vec3 extent = this->maximum_bounds - this->minimum_bounds;
+	if (scale_factor <= 0.0 || extent.magnitude() <= 0.0f) { return; };
+
+	const vec3 center = (this->minimum_bounds + this->maximum_bounds) * 0.5f;
+	const double new_scale_factor = 100.0 / (double(extent.magnitude()) / scale_factor);
+	const float rescale = float(new_scale_factor / scale_factor);
+	Thread_Pool::shared().parallel_for(this->positions.size(), 65536, [&](const size_t& first, const size_t& last) {
+
+		for (size_t i = first; i < last; i++) { this->positions[i] = (this->positions[i] - center) * rescale; };
+
+	});
+	this->geospatial_frame.origin[0] += double(center.x) / scale_factor;
+	this->geospatial_frame.origin[1] += double(center.y) / scale_factor;
+	this->geospatial_frame.origin[2] += double(center.z) / scale_factor;
+	this->geospatial_frame.scale_factor = new_scale_factor;
+
+	this->minimum_bounds = (this->minimum_bounds - center) * rescale;
+	this->maximum_bounds = (this->maximum_bounds - center) * rescale;
+
+};
+
+void Mesh::copy_points_out_of_cache() {
+
+	if (!this->point_cloud_cache) { return; };
+
+	this->positions.assign(this->point_cloud_cache->positions, this->point_cloud_cache->positions + this->point_cloud_cache->number_of_points);
+	this->colors.assign(this->point_cloud_cache->colors, this->point_cloud_cache->colors + this->point_cloud_cache->number_of_points);
+	if (this->keep_point_attributes) { this->point_attributes = this->point_cloud_cache->get_point_attributes(); };
+	this->point_cloud_cache.reset();
+
+};
+
+const KD_Tree& Mesh::get_KD_tree() {
+
+	if (this->KD_tree) { return *this->KD_tree; };
+
+	if (this->point_cloud_cache) { this->KD_tree = std::make_unique<KD_Tree>(this->point_cloud_cache->positions, this->point_cloud_cache->number_of_points); }
+	else if (!this->point_cloud_tiles.empty()) {
+
+		std::vector<vec3> positions(this->positions.size());
+		for (const Point_Cloud_Mosaic::Tile& tile : this->point_cloud_tiles) {
+
+			const vec3 origin(float(tile.origin[0]), float(tile.origin[1]), float(tile.origin[2]));
+			for (uint64_t i = tile.first_point; i < tile.first_point + tile.number_of_points; i++) { positions[i] = this->positions[i] + origin; };
+
+		};
+		this->KD_tree = std::make_unique<KD_Tree>(positions);
+
+	}
+	else { this->KD_tree = std::make_unique<KD_Tree>(this->positions); };
+
+	return *this->KD_tree;
+
+};
+
+void Mesh::estimate_normals(const uint32_t& neighbours) {
+
+	if (this->streamed || this->octree) {
+
+		std::cerr << "WARNING: streamed and octree meshes dont hold their points, open the file whole to estimate its normals\n";
+		return;
+
+	};
+
+	//PCA doesnt care where the points are, so the tree of the mosaic, in the frame of the bounds, serves the tiles as well
+	Normal_Estimator::estimate(this->get_KD_tree(), this->normals, &this->curvatures, neighbours);
+
+};
+
+bool Mesh::write_LAS(const std::filesystem::path& path_to_LASer_file, const uint8_t& version_minor, const vec3& crop_minimum, const vec3& crop_maximum) {
+
+	if (this->streamed || this->octree) {
+
+		std::cerr << "WARNING: streamed and octree meshes dont hold their points, open the file whole to export it\n";
+		return false;
+
+	};
+
+	std::vector<LAS_Writer::Point_Range> point_ranges;
+	if (this->point_cloud_cache) { point_ranges.push_back({ this->point_cloud_cache->positions, this->point_cloud_cache->colors, this->point_cloud_cache->number_of_points, this->geospatial_frame, &this->coordinate_reference_system }); }
+	else if (!this->point_cloud_tiles.empty()) {
+
+		for (const Point_Cloud_Mosaic::Tile& tile : this->point_cloud_tiles) {
+
+			point_ranges.push_back({ this->positions.data() + tile.first_point, this->colors.data() + tile.first_point, tile.number_of_points, tile.frame, &this->coordinate_reference_system });
+
+		};
+
+	}
+	else { point_ranges.push_back({ this->positions.data(), this->colors.size() == this->positions.size() ? this->colors.data() : nullptr, this->positions.size(), this->geospatial_frame, &this->coordinate_reference_system }); };
+
+	//the attributes of a cached mesh stay in the mapping until they are needed
+	Point_Cloud::Point_Attributes cached_point_attributes;
+	const Point_Cloud::Point_Attributes* point_attributes = this->point_attributes.empty() ? nullptr : &this->point_attributes;
+	if (this->point_cloud_cache && this->keep_point_attributes && this->point_cloud_cache->has_point_attributes()) {
+
+		cached_point_attributes = this->point_cloud_cache->get_point_attributes();
+		point_attributes = &cached_point_attributes;
+
+	};
+
+	const bool cropped = crop_minimum.x <= crop_maximum.x && crop_minimum.y <= crop_maximum.y && crop_minimum.z <= crop_maximum.z;
+	std::vector<uint64_t> selection;
+	if (cropped) {
+
+		uint64_t range_start = 0;
+		for (size_t range = 0; range < point_ranges.size(); range++) {
+
+			//tiles are moved off their origins into the frame of the bounds
+			const vec3 origin = this->point_cloud_tiles.empty() ? vec3(0.0f, 0.0f, 0.0f) : vec3(float(this->point_cloud_tiles[range].origin[0]), float(this->point_cloud_tiles[range].origin[1]), float(this->point_cloud_tiles[range].origin[2]));
+			for (uint64_t i = 0; i < point_ranges[range].n_points; i++) {
+
+				const vec3 position = point_ranges[range].positions[i] + origin;
+				if (position.x >= crop_minimum.x && position.x <= crop_maximum.x && position.y >= crop_minimum.y && position.y <= crop_maximum.y && position.z >= crop_minimum.z && position.z <= crop_maximum.z) { selection.push_back(range_start + i); };
+
+			};
+			range_start += point_ranges[range].n_points;
+
+		};
+		if (selection.empty()) { std::cerr << "WARNING: no points inside the crop box, " << path_to_LASer_file << " isnt written\n"; return false; };
+
+	};
+
+	return LAS_Writer::write(path_to_LASer_file, point_ranges, point_attributes, cropped ? &selection : nullptr, version_minor);
+
 };
 
 Mesh::Mesh(const std::vector<vec3>& positions) : 
@@ -602,7 +888,8 @@ Mesh::Mesh(const vec2& mesh_dimensions, const uint8_t& ADD_VERTICES, Texture&& d
 
 	switch (ADD_VERTICES) {
 
-		case ADD_ONLY_UNIQUE_VERTICES: {
+		case ADD_ONLY_UNIQUE_VERTICES:
+		case ADD_ONLY_UNIQUE_VERTICES_BY_SORTING: {
 
 			draw_as_elements = true;
 			break;
@@ -632,8 +919,8 @@ Mesh::Mesh(const vec2& mesh_dimensions, const uint8_t& ADD_VERTICES, Texture&& d
 	std::cout << "n_uv_coords: " << this->texture_coordinates.size() << std::endl;
 	std::cout << "n_TBNs: " << this->normals.size() << std::endl;
 	
-	this->vertices_map.clear();
-	std::cout << "cleared map\n";
+	this->vertices_table.clear();
+	std::cout << "cleared vertex table\n";
 
 };
 Mesh::Mesh(const std::filesystem::path& obj_file_path, const uint8_t& ADD_VERTICES, Texture&& diffuse_map, Texture&& normal_map, Texture&& displacement_map) :
@@ -646,7 +933,8 @@ Mesh::Mesh(const std::filesystem::path& obj_file_path, const uint8_t& ADD_VERTIC
 
 	switch (ADD_VERTICES) {
 
-		case ADD_ONLY_UNIQUE_VERTICES: {
+		case ADD_ONLY_UNIQUE_VERTICES:
+		case ADD_ONLY_UNIQUE_VERTICES_BY_SORTING: {
 
 			draw_as_elements = true;
 			break;
@@ -676,8 +964,8 @@ Mesh::Mesh(const std::filesystem::path& obj_file_path, const uint8_t& ADD_VERTIC
 	std::cout << "n_uv_coords: " << this->texture_coordinates.size() << std::endl;
 	std::cout << "n_TBNs: " << this->normals.size() << std::endl;
 	
-	this->vertices_map.clear();
-	std::cout << "cleared map\n";
+	this->vertices_table.clear();
+	std::cout << "cleared vertex table\n";
 
 };
 
@@ -691,7 +979,8 @@ Mesh::Mesh(const vec2& mesh_dimensions, const std::filesystem::path& path_diffus
 
 	switch (ADD_VERTICES) {
 
-		case ADD_ONLY_UNIQUE_VERTICES: {
+		case ADD_ONLY_UNIQUE_VERTICES:
+		case ADD_ONLY_UNIQUE_VERTICES_BY_SORTING: {
 
 			draw_as_elements = true;
 			break;
@@ -721,8 +1010,8 @@ Mesh::Mesh(const vec2& mesh_dimensions, const std::filesystem::path& path_diffus
 	std::cout << "n_uv_coords: " << this->texture_coordinates.size() << std::endl;
 	std::cout << "n_TBNs: " << this->normals.size() << std::endl;
 
-	this->vertices_map.clear();
-	std::cout << "cleared map\n";
+	this->vertices_table.clear();
+	std::cout << "cleared vertex table\n";
 
 };
 Mesh::Mesh(const std::filesystem::path& obj_file_path, const std::filesystem::path& path_diffuse_map_file, const uint8_t& ADD_VERTICES, const std::filesystem::path& path_normal_map_file, const std::filesystem::path& path_displacement_map_file) :
@@ -735,7 +1024,8 @@ Mesh::Mesh(const std::filesystem::path& obj_file_path, const std::filesystem::pa
 
 	switch (ADD_VERTICES) {
 
-		case ADD_ONLY_UNIQUE_VERTICES: {
+		case ADD_ONLY_UNIQUE_VERTICES:
+		case ADD_ONLY_UNIQUE_VERTICES_BY_SORTING: {
 
 			draw_as_elements = true;
 			break;
@@ -765,8 +1055,8 @@ Mesh::Mesh(const std::filesystem::path& obj_file_path, const std::filesystem::pa
 	std::cout << "n_uv_coords: " << this->texture_coordinates.size() << std::endl;
 	std::cout << "n_TBNs: " << this->normals.size() << std::endl;
 
-	this->vertices_map.clear();
-	std::cout << "cleared map\n";
+	this->vertices_table.clear();
+	std::cout << "cleared vertex table\n";
 
 };
 
@@ -780,7 +1070,8 @@ Mesh::Mesh(const vec2& mesh_dimensions, const std::filesystem::path& path_maps_f
 
 	switch (ADD_VERTICES) {
 
-		case ADD_ONLY_UNIQUE_VERTICES: {
+		case ADD_ONLY_UNIQUE_VERTICES:
+		case ADD_ONLY_UNIQUE_VERTICES_BY_SORTING: {
 
 			draw_as_elements = true;
 			break;
@@ -810,8 +1101,8 @@ Mesh::Mesh(const vec2& mesh_dimensions, const std::filesystem::path& path_maps_f
 	std::cout << "n_uv_coords: " << this->texture_coordinates.size() << std::endl;
 	std::cout << "n_TBNs: " << this->normals.size() << std::endl;
 
-	this->vertices_map.clear();
-	std::cout << "cleared map\n";
+	this->vertices_table.clear();
+	std::cout << "cleared vertex table\n";
 
 };
 Mesh::Mesh(const std::filesystem::path& obj_file_path, const std::filesystem::path& path_maps_folder, const uint8_t& ADD_VERTICES) :
@@ -824,7 +1115,8 @@ Mesh::Mesh(const std::filesystem::path& obj_file_path, const std::filesystem::pa
 
 	switch (ADD_VERTICES) {
 
-		case ADD_ONLY_UNIQUE_VERTICES: {
+		case ADD_ONLY_UNIQUE_VERTICES:
+		case ADD_ONLY_UNIQUE_VERTICES_BY_SORTING: {
 
 			draw_as_elements = true;
 			break;
@@ -854,26 +1146,99 @@ Mesh::Mesh(const std::filesystem::path& obj_file_path, const std::filesystem::pa
 	std::cout << "n_uv_coords: " << this->texture_coordinates.size() << std::endl;
 	std::cout << "n_TBNs: " << this->normals.size() << std::endl;
 
-	this->vertices_map.clear();
-	std::cout << "cleared map\n";
+	this->vertices_table.clear();
+	std::cout << "cleared vertex table\n";
 
 };
 
-Mesh::Mesh(const std::filesystem::path& las_file_path) :
+Mesh::Mesh(const std::filesystem::path& las_file_path, const float& voxel_size, const uint64_t& point_budget, const uint8_t& SELECTION, const Point_Cloud::Point_Filter& point_filter, const bool& keep_point_attributes, const bool& remove_outliers, const bool& estimate_normals) :
 
 	generate_buffers_and_textures(true),
 	mesh_dimensions(100, 100),
     draw_as_elements(false) {
 
-	extract_from_LAS_file(las_file_path);
+	extract_from_LAS_file(las_file_path, point_filter, keep_point_attributes);
+	if (remove_outliers) {
+
+		this->remove_outliers();
+
+	};
+	if (voxel_size > 0.0f || point_budget > 0) {
+
+		downsample_points(voxel_size, point_budget, SELECTION);
+
+	};
+	if (estimate_normals) {
+
+		this->estimate_normals();
+
+	};
 	std::cout << "actual texture width: " << this->diffuse_map.width << " actual texture height: " << this->diffuse_map.height << " model dimensions: "; print_vec(this->mesh_dimensions);
 	std::cout << "n_vertices: " << positions.size() << std::endl;
 	std::cout << "n_indices: " << indices.size() << std::endl;
 	std::cout << "n_uv_coords: " << this->texture_coordinates.size() << std::endl;
 	std::cout << "n_TBNs: " << this->normals.size() << std::endl;
 
-	this->vertices_map.clear();
-	std::cout << "cleared map\n";
+	this->vertices_table.clear();
+	std::cout << "cleared vertex table\n";
+
+};
+
+Mesh::Mesh(const std::filesystem::path& las_file_path, const size_t& host_memory_budget) :
+
+	generate_buffers_and_textures(true),
+	mesh_dimensions(100, 100),
+	draw_as_elements(false),
+	streamed(true),
+	point_cloud_stream(std::make_unique<Point_Cloud_Stream>(las_file_path, host_memory_budget)) {
+
+	//the points arrive later, so the bounds come from the header instead of the positions
+	this->minimum_bounds = this->point_cloud_stream->minimum_bounds;
+	this->maximum_bounds = this->point_cloud_stream->maximum_bounds;
+	std::cout << "n_vertices to stream: " << this->point_cloud_stream->number_of_points << std::endl;
+
+};
+
+Mesh::Mesh(const std::filesystem::path& las_file_path, const std::filesystem::path& octree_directory) :
+
+	generate_buffers_and_textures(true),
+	mesh_dimensions(100, 100),
+	draw_as_elements(false) {
+
+	if (!Octree::exists(octree_directory, las_file_path)) {
+
+		exit_if_file_doesnt_exist(las_file_path);
+		Octree::build(las_file_path, octree_directory);
+
+	};
+	this->octree = std::make_unique<Octree>(octree_directory);
+
+	this->minimum_bounds = this->octree->minimum_bounds;
+	this->maximum_bounds = this->octree->minimum_bounds + vec3(this->octree->size, this->octree->size, this->octree->size);
+	std::cout << "n_vertices in octree: " << this->octree->number_of_points << " in " << this->octree->nodes.size() << " nodes" << std::endl;
+
+};
+
+Mesh::Mesh(const std::vector<std::filesystem::path>& las_file_paths, const Point_Cloud::Point_Filter& point_filter, const bool& keep_point_attributes, const bool& estimate_normals) :
+
+	generate_buffers_and_textures(true),
+	mesh_dimensions(100, 100),
+	draw_as_elements(false),
+	keep_point_attributes(keep_point_attributes) {
+
+	for (const std::filesystem::path& las_file_path : las_file_paths) { exit_if_file_doesnt_exist(las_file_path); };
+
+	Point_Cloud_Mosaic mosaic(las_file_paths);
+	mosaic.point_filter = point_filter;
+	mosaic.decode(this->positions, this->colors, keep_point_attributes ? &this->point_attributes : nullptr);
+	this->point_cloud_tiles = mosaic.tiles;
+	if (!mosaic.tiles.empty()) { this->coordinate_reference_system = Point_Cloud::read_coordinate_reference_system(mosaic.tiles.front().path); };
+
+	//the positions are relative to the origins of their tiles, so the bounds come from the headers instead
+	this->minimum_bounds = mosaic.minimum_bounds;
+	this->maximum_bounds = mosaic.maximum_bounds;
+	std::cout << "n_vertices: " << this->positions.size() << " from " << mosaic.tiles.size() << " tiles" << std::endl;
+	if (estimate_normals) { this->estimate_normals(); };
 
 };
 
@@ -951,9 +1316,23 @@ Mesh Mesh::from_OBJ_folder(const std::filesystem::path& file_path, const std::fi
 	return { file_path, path_maps_folder, ADD_VERTICES };
 
 };
-Mesh Mesh::from_LAS(const std::filesystem::path& las_file_path) {
+Mesh Mesh::from_LAS(const std::filesystem::path& las_file_path, const float& voxel_size, const uint64_t& point_budget, const uint8_t& SELECTION, const Point_Cloud::Point_Filter& point_filter, const bool& keep_point_attributes, const bool& remove_outliers, const bool& estimate_normals) {
 
-	return { las_file_path };
+	return { las_file_path, voxel_size, point_budget, SELECTION, point_filter, keep_point_attributes, remove_outliers, estimate_normals };
 
 };
+Mesh Mesh::from_LAS_stream(const std::filesystem::path& las_file_path, const size_t& host_memory_budget) {
+
+	return { las_file_path, host_memory_budget };
+
+};
+Mesh Mesh::from_LAS_octree(const std::filesystem::path& las_file_path, const std::filesystem::path& octree_directory) {
+
+	return { las_file_path, octree_directory.empty() ? std::filesystem::path(las_file_path).replace_extension(".octree") : octree_directory };
+
+};
+Mesh Mesh::from_LAS_mosaic(const std::vector<std::filesystem::path>& las_file_paths, const Point_Cloud::Point_Filter& point_filter, const bool& keep_point_attributes, const bool& estimate_normals) {
+
+	return { las_file_paths, point_filter, keep_point_attributes, estimate_normals };
 
+};
\ No newline at end of file
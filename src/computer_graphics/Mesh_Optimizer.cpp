@@ -0,0 +1,234 @@
+#include "computer_graphics/Mesh_Optimizer.h"
+
+Mesh_Optimizer::Statistics Mesh_Optimizer::analyze_vertex_cache(const std::vector<unsigned int>& indices, const size_t& n_vertices, const uint32_t& cache_size) {
+
+	//a vertex is in the cache while fewer than *cache_size* misses happened since it was last loaded
+	std::vector<uint32_t> loaded_at(n_vertices, 0);
+	std::vector<bool> used(n_vertices, false);
+	uint32_t time = cache_size + 1;
+	uint64_t n_misses = 0, n_used = 0;
+	for (const unsigned int& index : indices) {
+
+		if (time - loaded_at[index] > cache_size) { loaded_at[index] = time++; n_misses++; };
+		if (!used[index]) { used[index] = true; n_used++; };
+
+	};
+
+	const size_t n_triangles = indices.size() / 3;
+	return { n_triangles ? float(double(n_misses) / n_triangles) : 0.0f, n_used ? float(double(n_misses) / n_used) : 0.0f };
+
+};
+
+Mesh_Optimizer::Adjacency Mesh_Optimizer::build_adjacency(const std::vector<unsigned int>& indices, const size_t& n_vertices) {
+
+	Adjacency adjacency;
+	adjacency.offsets.assign(n_vertices + 1, 0);
+	for (const unsigned int& index : indices) { adjacency.offsets[index + 1]++; };
+	for (size_t v = 0; v < n_vertices; v++) { adjacency.offsets[v + 1] += adjacency.offsets[v]; };
+
+	std::vector<uint32_t> fill(adjacency.offsets.begin(), adjacency.offsets.end() - 1);
+	adjacency.triangles.resize(indices.size());
+	for (size_t i = 0; i < indices.size(); i++) { adjacency.triangles[fill[indices[i]]++] = uint32_t(i / 3); };
+	return adjacency;
+
+};
+
+void Mesh_Optimizer::optimize_vertex_cache(std::vector<unsigned int>& indices, const size_t& n_vertices, const uint32_t& cache_size, std::vector<uint32_t>* clusters) {
+
+	if (clusters) { clusters->clear(); };
+	const size_t n_triangles = indices.size() / 3;
+	if (n_triangles == 0) { return; };
+
+	const Adjacency adjacency = build_adjacency(indices, n_vertices);
+
+	//*live_triangles* counts the corners of every vertex not emitted yet, *dead_ends* the vertices of the emitted triangles, the ones to fall back on when no candidate is left
+	std::vector<uint32_t> live_triangles(n_vertices);
+	for (size_t v = 0; v < n_vertices; v++) { live_triangles[v] = adjacency.offsets[v + 1] - adjacency.offsets[v]; };
+	std::vector<uint32_t> loaded_at(n_vertices, 0);
+	std::vector<bool> emitted(n_triangles, false);
+	std::vector<uint32_t> dead_ends;
+	std::vector<uint32_t> candidates;
+	std::vector<unsigned int> output;
+	output.reserve(indices.size());
+
+	uint32_t time = cache_size + 1;
+	size_t cursor = 0;
+	int64_t fanning_vertex = 0;
+	bool flushed = true;
+	while (fanning_vertex >= 0) {
+
+		//every triangle around the fanning vertex not emitted yet is emitted
+		candidates.clear();
+		for (uint32_t a = adjacency.offsets[fanning_vertex]; a < adjacency.offsets[fanning_vertex + 1]; a++) {
+
+			const uint32_t triangle = adjacency.triangles[a];
+			if (emitted[triangle]) { continue; };
+
+			if (flushed && clusters) { clusters->push_back(uint32_t(output.size() / 3)); };
+			flushed = false;
+			for (int corner = 0; corner < 3; corner++) {
+
+				const unsigned int& vertex = indices[triangle * 3 + corner];
+				output.push_back(vertex);
+				dead_ends.push_back(vertex);
+				candidates.push_back(vertex);
+				live_triangles[vertex]--;
+				if (time - loaded_at[vertex] > cache_size) { loaded_at[vertex] = time++; };
+
+			};
+			emitted[triangle] = true;
+
+		};
+
+		//the next fanning vertex is the candidate that will still be in the cache once its remaining triangles are emitted, the one loaded the longest time ago among them
+		fanning_vertex = -1;
+		int64_t best_priority = -1;
+		for (const uint32_t& vertex : candidates) {
+
+			if (live_triangles[vertex] == 0) { continue; };
+			int64_t priority = 0;
+			if (int64_t(time - loaded_at[vertex]) + 2 * int64_t(live_triangles[vertex]) <= int64_t(cache_size)) { priority = time - loaded_at[vertex]; };
+			if (priority > best_priority) { best_priority = priority; fanning_vertex = vertex; };
+
+		};
+		if (fanning_vertex >= 0) { continue; };
+
+		//a dead end: the most recently emitted vertex with triangles left, else the next one in index order, in which case the cache no longer holds anything useful
+		while (!dead_ends.empty() && fanning_vertex < 0) {
+
+			if (live_triangles[dead_ends.back()] > 0) { fanning_vertex = dead_ends.back(); };
+			dead_ends.pop_back();
+
+		};
+		while (fanning_vertex < 0 && cursor < n_vertices) {
+
+			if (live_triangles[cursor] > 0) { fanning_vertex = int64_t(cursor); flushed = true; };
+			cursor++;
+
+		};
+
+	};
+
+	indices = std::move(output);
+
+};
+
+void Mesh_Optimizer::optimize_overdraw(std::vector<unsigned int>& indices, const std::vector<vec3>& positions, const std::vector<uint32_t>& clusters, const uint32_t& cache_size, const float& threshold) {
+
+	const size_t n_triangles = indices.size() / 3;
+	if (n_triangles == 0) { return; };
+
+	//every run is cut again at the triangles where the misses of the cluster so far come within *threshold* of the misses of the whole run, the cache starts empty in every cluster
+	std::vector<uint32_t> hard_clusters = clusters;
+	if (hard_clusters.empty() || hard_clusters.front() != 0) { hard_clusters.insert(hard_clusters.begin(), 0); };
+	hard_clusters.push_back(uint32_t(n_triangles));
+
+	std::vector<uint32_t> loaded_at(positions.size(), 0);
+	uint32_t time = cache_size + 1;
+	auto count_misses = [&](const uint32_t& triangle) {
+
+		uint32_t n_misses = 0;
+		for (int corner = 0; corner < 3; corner++) {
+
+			const unsigned int& vertex = indices[triangle * 3 + corner];
+			if (time - loaded_at[vertex] > cache_size) { loaded_at[vertex] = time++; n_misses++; };
+
+		};
+		return n_misses;
+
+	};
+
+	std::vector<uint32_t> soft_clusters;
+	for (size_t c = 0; c + 1 < hard_clusters.size(); c++) {
+
+		const uint32_t first = hard_clusters[c], last = hard_clusters[c + 1];
+		time += cache_size + 1;
+		uint64_t n_misses = 0;
+		for (uint32_t triangle = first; triangle < last; triangle++) { n_misses += count_misses(triangle); };
+		const double run_ACMR = double(n_misses) / (last - first);
+
+		time += cache_size + 1;
+		soft_clusters.push_back(first);
+		uint32_t cluster_start = first;
+		n_misses = 0;
+		for (uint32_t triangle = first; triangle < last; triangle++) {
+
+			n_misses += count_misses(triangle);
+			if (triangle + 1 < last && double(n_misses) / (triangle + 1 - cluster_start) <= run_ACMR * threshold) {
+
+				soft_clusters.push_back(triangle + 1);
+				cluster_start = triangle + 1;
+				n_misses = 0;
+				time += cache_size + 1;
+
+			};
+
+		};
+
+	};
+	soft_clusters.push_back(uint32_t(n_triangles));
+
+	//area weighted centroid and normal of every cluster. Clusters far out along their normal face the outside of the mesh and are drawn first, they are the likeliest to hide the rest
+	vec3 mesh_centroid(0.0f, 0.0f, 0.0f);
+	float mesh_area = 0.0f;
+	const size_t n_clusters = soft_clusters.size() - 1;
+	std::vector<vec3> centroids(n_clusters, vec3(0.0f, 0.0f, 0.0f)), normals(n_clusters, vec3(0.0f, 0.0f, 0.0f));
+	std::vector<float> areas(n_clusters, 0.0f);
+	for (size_t c = 0; c < n_clusters; c++) {
+
+		for (uint32_t triangle = soft_clusters[c]; triangle < soft_clusters[c + 1]; triangle++) {
+
+			const vec3& A = positions[indices[triangle * 3]];
+			const vec3& B = positions[indices[triangle * 3 + 1]];
+			const vec3& C = positions[indices[triangle * 3 + 2]];
+			const vec3 normal = (B - A).cross(C - A);
+			const float area = normal.magnitude();
+			centroids[c] += (A + B + C) * (area / 3.0f);
+			normals[c] += normal;
+			areas[c] += area;
+
+		};
+		mesh_centroid += centroids[c];
+		mesh_area += areas[c];
+		if (areas[c] > 0.0f) { centroids[c] = centroids[c] / areas[c]; };
+
+	};
+	if (mesh_area > 0.0f) { mesh_centroid = mesh_centroid / mesh_area; };
+
+	std::vector<float> sort_keys(n_clusters, 0.0f);
+	for (size_t c = 0; c < n_clusters; c++) {
+
+		const float normal_length = normals[c].magnitude();
+		if (normal_length > 0.0f) { sort_keys[c] = (centroids[c] - mesh_centroid).dot(normals[c] / normal_length); };
+
+	};
+
+	std::vector<uint32_t> order(n_clusters);
+	for (uint32_t c = 0; c < n_clusters; c++) { order[c] = c; };
+	std::stable_sort(order.begin(), order.end(), [&](const uint32_t& A, const uint32_t& B) { return sort_keys[A] > sort_keys[B]; });
+
+	std::vector<unsigned int> output;
+	output.reserve(indices.size());
+	for (const uint32_t& c : order) { output.insert(output.end(), indices.begin() + size_t(soft_clusters[c]) * 3, indices.begin() + size_t(soft_clusters[c + 1]) * 3); };
+	indices = std::move(output);
+
+};
+
+std::vector<uint32_t> Mesh_Optimizer::optimize_vertex_fetch(std::vector<unsigned int>& indices, const size_t& n_vertices) {
+
+	std::vector<uint32_t> remap(n_vertices, UINT32_MAX);
+	uint32_t n_remapped = 0;
+	for (unsigned int& index : indices) {
+
+		if (remap[index] == UINT32_MAX) { remap[index] = n_remapped++; };
+		index = remap[index];
+
+	};
+	for (uint32_t& new_index : remap) {
+
+		if (new_index == UINT32_MAX) { new_index = n_remapped++; };
+
+	};
+	return remap;
+
+};
@@ -0,0 +1,119 @@
+#include "computer_graphics/Normal_Estimator.h"
+
+void Normal_Estimator::compute_eigenvalues(const double covariance[6], double eigenvalues[3]) {
+
+	const double off_diagonal = covariance[1] * covariance[1] + covariance[2] * covariance[2] + covariance[4] * covariance[4];
+	const double q = (covariance[0] + covariance[3] + covariance[5]) / 3.0;
+	if (off_diagonal == 0.0) {
+
+		eigenvalues[0] = covariance[0]; eigenvalues[1] = covariance[3]; eigenvalues[2] = covariance[5];
+		std::sort(eigenvalues, eigenvalues + 3);
+		return;
+
+	};
+
+	//the eigenvalues of *covariance* - q * I scaled to unit size are 2cos(phi + 2k * pi / 3), see the trigonometric solution of the characteristic cubic
+	const double a = covariance[0] - q, d = covariance[3] - q, f = covariance[5] - q;
+	const double p = std::sqrt((a * a + d * d + f * f + 2.0 * off_diagonal) / 6.0);
+	const double determinant = a * (d * f - covariance[4] * covariance[4]) - covariance[1] * (covariance[1] * f - covariance[4] * covariance[2]) + covariance[2] * (covariance[1] * covariance[4] - d * covariance[2]);
+	const double r = std::clamp(determinant / (2.0 * p * p * p), -1.0, 1.0);
+	const double phi = std::acos(r) / 3.0;
+
+	eigenvalues[2] = q + 2.0 * p * std::cos(phi);
+	eigenvalues[0] = q + 2.0 * p * std::cos(phi + (2.0 * 3.14159265358979323846 / 3.0));
+	eigenvalues[1] = 3.0 * q - eigenvalues[0] - eigenvalues[2];
+
+};
+
+bool Normal_Estimator::compute_eigenvector(const double covariance[6], const double& eigenvalue, double eigenvector[3]) {
+
+	//the rows of *covariance* - eigenvalue * I span the plane the eigenvector is normal to, the cross product of the two most independent rows is the most accurate
+	const double rows[3][3] = {
+
+		{ covariance[0] - eigenvalue, covariance[1], covariance[2] },
+		{ covariance[1], covariance[3] - eigenvalue, covariance[4] },
+		{ covariance[2], covariance[4], covariance[5] - eigenvalue }
+
+	};
+	const int pairs[3][2] = { { 0, 1 }, { 0, 2 }, { 1, 2 } };
+
+	double largest = 0.0;
+	for (const auto& pair : pairs) {
+
+		const double* u = rows[pair[0]];
+		const double* v = rows[pair[1]];
+		const double cross[3] = { u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0] };
+		const double squared_length = cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2];
+		if (squared_length > largest) {
+
+			largest = squared_length;
+			eigenvector[0] = cross[0]; eigenvector[1] = cross[1]; eigenvector[2] = cross[2];
+
+		};
+
+	};
+
+	//relative to the size of the matrix, below this the rows are parallel and the eigenvalue is repeated
+	const double scale = std::max({ std::abs(rows[0][0]), std::abs(rows[1][1]), std::abs(rows[2][2]), std::abs(covariance[1]), std::abs(covariance[2]), std::abs(covariance[4]) });
+	if (largest <= 1e-20 * scale * scale * scale * scale) { return false; };
+
+	const double length = std::sqrt(largest);
+	for (int axis = 0; axis < 3; axis++) { eigenvector[axis] /= length; };
+	return true;
+
+};
+
+void Normal_Estimator::estimate(const KD_Tree& KD_tree, std::vector<vec3>& normals, std::vector<float>* curvatures, const uint32_t& neighbours, const vec3& up) {
+
+	if (neighbours < 2) {
+
+		std::cerr << "ERROR: normal estimation needs at least two neighbours per point to span a plane\n";
+		exit(EXIT_FAILURE);
+
+	};
+
+	auto start = std::chrono::steady_clock::now();
+	normals.assign(KD_tree.number_of_points, up);
+	if (curvatures) { curvatures->assign(KD_tree.number_of_points, 0.0f); };
+
+	KD_tree.for_each_neighbourhood(neighbours, [&](const uint32_t& index, const std::vector<vec3>& offsets) {
+
+		if (offsets.size() < 2) { return; };
+
+		//the point itself sits at the origin of the offsets, it takes part in the mean with a zero offset
+		double mean[3] = { 0.0, 0.0, 0.0 };
+		double moments[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+		for (const vec3& offset : offsets) {
+
+			mean[0] += offset.x; mean[1] += offset.y; mean[2] += offset.z;
+			moments[0] += double(offset.x) * offset.x; moments[1] += double(offset.x) * offset.y; moments[2] += double(offset.x) * offset.z;
+			moments[3] += double(offset.y) * offset.y; moments[4] += double(offset.y) * offset.z; moments[5] += double(offset.z) * offset.z;
+
+		};
+		const double n = double(offsets.size() + 1);
+		for (int axis = 0; axis < 3; axis++) { mean[axis] /= n; };
+		const double covariance[6] = {
+
+			moments[0] / n - mean[0] * mean[0], moments[1] / n - mean[0] * mean[1], moments[2] / n - mean[0] * mean[2],
+			moments[3] / n - mean[1] * mean[1], moments[4] / n - mean[1] * mean[2], moments[5] / n - mean[2] * mean[2]
+
+		};
+
+		double eigenvalues[3];
+		compute_eigenvalues(covariance, eigenvalues);
+		double normal[3];
+		if (!compute_eigenvector(covariance, eigenvalues[0], normal)) { return; };
+
+		vec3 oriented(static_cast<float>(normal[0]), static_cast<float>(normal[1]), static_cast<float>(normal[2]));
+		if (oriented.dot(up) < 0.0f) { oriented = oriented * -1.0f; };
+		normals[index] = oriented;
+
+		const double sum = eigenvalues[0] + eigenvalues[1] + eigenvalues[2];
+		if (curvatures && sum > 0.0) { (*curvatures)[index] = float(std::max(eigenvalues[0], 0.0) / sum); };
+
+	});
+
+	std::chrono::duration<double> elapsed_time = std::chrono::steady_clock::now() - start;
+	std::cout << "estimated the normals of " << KD_tree.number_of_points << " points from " << neighbours << " neighbours in " << elapsed_time.count() * 1000.0 << " ms\n";
+
+};
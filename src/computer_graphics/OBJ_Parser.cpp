@@ -0,0 +1,264 @@
+#include "computer_graphics/OBJ_Parser.h"
+
+const char* OBJ_Parser::parse_floats(const char* data, const char* cursor, const char* end, float* values, const int& n_required, const int& n_values) {
+
+	for (int i = 0; i < n_values; i++) {
+
+		cursor = skip_spaces(cursor, end);
+		if (i >= n_required && is_end_of_line(cursor, end)) { values[i] = 0.0f; continue; };
+
+		//std::from_chars doesnt take a leading plus
+		if (cursor < end && *cursor == '+') { ++cursor; };
+		std::from_chars_result result = std::from_chars(cursor, end, values[i]);
+		if (result.ec != std::errc()) {
+
+			std::cerr << "ERROR: expected a number on line " << get_line_number(data, cursor) << " of the OBJ file\n";
+			exit(EXIT_FAILURE);
+
+		};
+		cursor = result.ptr;
+
+	};
+	return cursor;
+
+};
+
+const char* OBJ_Parser::parse_index(const char* data, const char* cursor, const char* end, const size_t& count, int32_t& index) {
+
+	int64_t value = 0;
+	std::from_chars_result result = std::from_chars(cursor, end, value);
+	if (result.ec != std::errc() || value == 0 || value > int64_t(count) || -value > int64_t(count)) {
+
+		std::cerr << "ERROR: invalid index on line " << get_line_number(data, cursor) << " of the OBJ file, " << count << " were declared before it\n";
+		exit(EXIT_FAILURE);
+
+	};
+
+	//negative indices count back from the last one declared so far
+	index = int32_t(value > 0 ? value - 1 : int64_t(count) + value);
+	return result.ptr;
+
+};
+
+const char* OBJ_Parser::parse_face(const char* data, const char* cursor, const char* end, Chunk& chunk) {
+
+	Corner first = {}, previous = {};
+	int n_corners = 0;
+	while (true) {
+
+		cursor = skip_spaces(cursor, end);
+		if (is_end_of_line(cursor, end)) { break; };
+
+		Corner corner = { -1, -1, -1 };
+		cursor = parse_index(data, cursor, end, chunk.positions_before + chunk.positions.size(), corner.position);
+		if (cursor < end && *cursor == '/') {
+
+			++cursor;
+			if (cursor < end && *cursor != '/') { cursor = parse_index(data, cursor, end, chunk.texture_coordinates_before + chunk.texture_coordinates.size(), corner.texture_coordinates); };
+			if (cursor < end && *cursor == '/') { ++cursor; cursor = parse_index(data, cursor, end, chunk.normals_before + chunk.normals.size(), corner.normal); };
+
+		};
+
+		if (n_corners == 0) { first = corner; }
+		else if (n_corners >= 2) {
+
+			chunk.triangle_corners.push_back(first);
+			chunk.triangle_corners.push_back(previous);
+			chunk.triangle_corners.push_back(corner);
+
+		};
+		previous = corner;
+		n_corners++;
+
+	};
+
+	if (n_corners < 3) {
+
+		std::cerr << "ERROR: face with " << n_corners << " corners on line " << get_line_number(data, cursor) << " of the OBJ file\n";
+		exit(EXIT_FAILURE);
+
+	};
+	chunk.number_of_faces++;
+	return cursor;
+
+};
+
+void OBJ_Parser::count_attributes(const Chunk& chunk, size_t& n_positions, size_t& n_texture_coordinates, size_t& n_normals) {
+
+	n_positions = 0; n_texture_coordinates = 0; n_normals = 0;
+	const char* cursor = chunk.first;
+	const char* end = chunk.last;
+	while (cursor < end) {
+
+		cursor = skip_spaces(cursor, end);
+		if (end - cursor >= 2 && cursor[0] == 'v') {
+
+			if (cursor[1] == ' ' || cursor[1] == '\t') { n_positions++; }
+			else if (end - cursor >= 3 && (cursor[2] == ' ' || cursor[2] == '\t')) {
+
+				if (cursor[1] == 't') { n_texture_coordinates++; }
+				else if (cursor[1] == 'n') { n_normals++; };
+
+			};
+
+		};
+		cursor = skip_line(cursor, end);
+
+	};
+
+};
+
+void OBJ_Parser::parse_chunk(const char* data, Chunk& chunk) {
+
+	const char* cursor = chunk.first;
+	const char* end = chunk.last;
+	float values[3];
+	while (cursor < end) {
+
+		cursor = skip_spaces(cursor, end);
+		if (end - cursor >= 2 && cursor[0] == 'v' && (cursor[1] == ' ' || cursor[1] == '\t')) {
+
+			cursor = parse_floats(data, cursor + 2, end, values, 3, 3);
+			chunk.positions.emplace_back(values[0], values[1], values[2]);
+
+		}
+		else if (end - cursor >= 3 && cursor[0] == 'v' && cursor[1] == 't' && (cursor[2] == ' ' || cursor[2] == '\t')) {
+
+			cursor = parse_floats(data, cursor + 3, end, values, 1, 2);
+			chunk.texture_coordinates.emplace_back(values[0], values[1]);
+
+		}
+		else if (end - cursor >= 3 && cursor[0] == 'v' && cursor[1] == 'n' && (cursor[2] == ' ' || cursor[2] == '\t')) {
+
+			cursor = parse_floats(data, cursor + 3, end, values, 3, 3);
+			chunk.normals.emplace_back(values[0], values[1], values[2]);
+
+		}
+		else if (end - cursor >= 2 && cursor[0] == 'f' && (cursor[1] == ' ' || cursor[1] == '\t')) {
+
+			cursor = parse_face(data, cursor + 2, end, chunk);
+
+		};
+
+		//comments, the w of positions and every other statement are skipped along with the rest of the line
+		cursor = skip_line(cursor, end);
+
+	};
+
+};
+
+void OBJ_Parser::parse_in_parallel(const char* data, const size_t& size) {
+
+	Thread_Pool& pool = Thread_Pool::shared();
+	const size_t n_chunks = std::clamp<size_t>(size / MINIMUM_CHUNK_SIZE, 1, size_t(pool.n_threads) * 4);
+
+	//every chunk but the first starts on the line after its nominal start, so no line is cut in two
+	const char* end = data + size;
+	std::vector<Chunk> chunks(n_chunks);
+	for (size_t i = 0; i < n_chunks; i++) {
+
+		chunks[i].first = i == 0 ? data : std::max(chunks[i - 1].first, skip_line(data + (size / n_chunks) * i - 1, end));
+		if (i > 0) { chunks[i - 1].last = chunks[i].first; };
+
+	};
+	chunks.back().last = end;
+
+	std::vector<size_t> counts(n_chunks * 3);
+	pool.parallel_for(n_chunks, 1, [&](const size_t& first, const size_t& last) {
+
+		for (size_t i = first; i < last; i++) { count_attributes(chunks[i], counts[i * 3], counts[i * 3 + 1], counts[i * 3 + 2]); };
+
+	});
+
+	//prefix sums of the counts are what the indices of every chunk are resolved against, starting after whatever was parsed before
+	size_t positions_before = this->positions.size(), texture_coordinates_before = this->texture_coordinates.size(), normals_before = this->normals.size();
+	for (size_t i = 0; i < n_chunks; i++) {
+
+		chunks[i].positions_before = positions_before;
+		chunks[i].texture_coordinates_before = texture_coordinates_before;
+		chunks[i].normals_before = normals_before;
+		positions_before += counts[i * 3];
+		texture_coordinates_before += counts[i * 3 + 1];
+		normals_before += counts[i * 3 + 2];
+
+	};
+
+	pool.parallel_for(n_chunks, 1, [&](const size_t& first, const size_t& last) {
+
+		for (size_t i = first; i < last; i++) {
+
+			chunks[i].positions.reserve(counts[i * 3]);
+			chunks[i].texture_coordinates.reserve(counts[i * 3 + 1]);
+			chunks[i].normals.reserve(counts[i * 3 + 2]);
+			parse_chunk(data, chunks[i]);
+
+		};
+
+	});
+
+	//stitching: the attributes go where the prefix sums put them, the corners after the corners of the chunks before
+	std::vector<size_t> corners_before(n_chunks);
+	size_t n_corners = this->triangle_corners.size();
+	for (size_t i = 0; i < n_chunks; i++) {
+
+		corners_before[i] = n_corners;
+		n_corners += chunks[i].triangle_corners.size();
+		this->number_of_faces += chunks[i].number_of_faces;
+
+	};
+	this->positions.resize(positions_before);
+	this->texture_coordinates.resize(texture_coordinates_before);
+	this->normals.resize(normals_before);
+	this->triangle_corners.resize(n_corners);
+
+	pool.parallel_for(n_chunks, 1, [&](const size_t& first, const size_t& last) {
+
+		for (size_t i = first; i < last; i++) {
+
+			const Chunk& chunk = chunks[i];
+			std::copy(chunk.positions.begin(), chunk.positions.end(), this->positions.begin() + chunk.positions_before);
+			std::copy(chunk.texture_coordinates.begin(), chunk.texture_coordinates.end(), this->texture_coordinates.begin() + chunk.texture_coordinates_before);
+			std::copy(chunk.normals.begin(), chunk.normals.end(), this->normals.begin() + chunk.normals_before);
+			std::copy(chunk.triangle_corners.begin(), chunk.triangle_corners.end(), this->triangle_corners.begin() + corners_before[i]);
+
+		};
+
+	});
+
+};
+
+void OBJ_Parser::parse(const char* data, const size_t& size, const uint8_t& PARSE_MODE) {
+
+	if (PARSE_MODE == PARSE_IN_PARALLEL) { this->parse_in_parallel(data, size); return; };
+
+	//serially the whole text is one chunk that carries on the arrays parsed so far
+	Chunk chunk;
+	chunk.first = data;
+	chunk.last = data + size;
+	chunk.positions = std::move(this->positions);
+	chunk.texture_coordinates = std::move(this->texture_coordinates);
+	chunk.normals = std::move(this->normals);
+	chunk.triangle_corners = std::move(this->triangle_corners);
+	parse_chunk(data, chunk);
+
+	this->positions = std::move(chunk.positions);
+	this->texture_coordinates = std::move(chunk.texture_coordinates);
+	this->normals = std::move(chunk.normals);
+	this->triangle_corners = std::move(chunk.triangle_corners);
+	this->number_of_faces += chunk.number_of_faces;
+
+};
+
+void OBJ_Parser::parse(const std::filesystem::path& path_to_OBJ_file, const uint8_t& PARSE_MODE) {
+
+	exit_if_file_doesnt_exist(path_to_OBJ_file);
+	auto start = std::chrono::steady_clock::now();
+
+	Memory_Mapped_File file(path_to_OBJ_file);
+	this->parse(file.data, file.size, PARSE_MODE);
+
+	std::chrono::duration<double> elapsed_time = std::chrono::steady_clock::now() - start;
+	double megabytes = file.size / (1024.0 * 1024.0);
+	std::cout << "parsed " << this->positions.size() << " positions and " << this->number_of_faces << " faces (" << megabytes << " MB) in " << elapsed_time.count() * 1000.0 << " ms, " << megabytes / elapsed_time.count() << " MB/s\n";
+
+};
@@ -0,0 +1,488 @@
+#include "computer_graphics/Octree.h"
+
+std::array<int64_t, 3> Octree::get_cell(const vec3& position, const vec3& minimum_bounds, const float& size, const int32_t& level) {
+
+	//double precision so the cells of deep levels still line up with the cells of their parents
+	const double n_cells = static_cast<double>(int64_t(1) << level);
+	std::array<int64_t, 3> cell;
+	for (int axis = 0; axis < 3; axis++) {
+
+		const double coordinate = (static_cast<double>((&position.x)[axis]) - static_cast<double>((&minimum_bounds.x)[axis])) / static_cast<double>(size);
+		cell[axis] = std::clamp(static_cast<int64_t>(coordinate * n_cells), int64_t(0), static_cast<int64_t>(n_cells) - 1);
+
+	};
+
+	return cell;
+
+};
+
+uint32_t Octree::get_sampling_cell(const vec3& position, const vec3& minimum_bounds, const float& size, const Voxel_Key& key) {
+
+	//the sampling grid of a node is the cell grid 7 levels below it, restricted to the cube of the node
+	std::array<int64_t, 3> cell = get_cell(position, minimum_bounds, size, key.level + 7);
+	const uint32_t x = static_cast<uint32_t>(std::clamp<int64_t>(cell[0] - int64_t(key.x) * SAMPLING_GRID_RESOLUTION, 0, SAMPLING_GRID_RESOLUTION - 1));
+	const uint32_t y = static_cast<uint32_t>(std::clamp<int64_t>(cell[1] - int64_t(key.y) * SAMPLING_GRID_RESOLUTION, 0, SAMPLING_GRID_RESOLUTION - 1));
+	const uint32_t z = static_cast<uint32_t>(std::clamp<int64_t>(cell[2] - int64_t(key.z) * SAMPLING_GRID_RESOLUTION, 0, SAMPLING_GRID_RESOLUTION - 1));
+	return x | (y << 7) | (z << 14);
+
+};
+
+void Octree::build_subtree(const Voxel_Key& key, std::vector<Point>& points, const vec3& minimum_bounds, const float& size, std::vector<Built_Node>& built_nodes) {
+
+	Built_Node node = { key, {} };
+	if (points.size() <= MAX_POINTS_PER_LEAF || key.level >= MAX_DEPTH) {
+
+		node.points = std::move(points);
+		built_nodes.push_back(std::move(node));
+		return;
+
+	};
+
+	//the first point landing in a cell stays in the node, every other one moves down into the child containing it
+	std::unordered_set<uint32_t> occupied_cells;
+	occupied_cells.reserve(points.size());
+	std::array<std::vector<Point>, 8> children_points;
+	for (const Point& point : points) {
+
+		if (occupied_cells.insert(get_sampling_cell(point.position, minimum_bounds, size, key)).second) { node.points.push_back(point); continue; };
+
+		std::array<int64_t, 3> cell = get_cell(point.position, minimum_bounds, size, key.level + 1);
+		children_points[(cell[0] & 1) | ((cell[1] & 1) << 1) | ((cell[2] & 1) << 2)].push_back(point);
+
+	};
+	std::vector<Point>().swap(points);
+	built_nodes.push_back(std::move(node));
+
+	for (int i = 0; i < 8; i++) {
+
+		if (!children_points[i].empty()) { build_subtree(key.get_child(i), children_points[i], minimum_bounds, size, built_nodes); };
+
+	};
+
+};
+
+void Octree::build(const std::filesystem::path& path_to_LASer_file, const std::filesystem::path& octree_directory, const size_t& host_memory_budget) {
+
+	auto start = std::chrono::steady_clock::now();
+
+	Memory_Mapped_File file(path_to_LASer_file);
+	Point_Cloud cloud;
+	Point_Cloud::Points_Decoder decoder = cloud.create_openGL_points_decoder(file);
+	decoder.decode_attributes = nullptr;
+	const uint64_t number_of_points = decoder.number_of_point_records;
+	if (number_of_points == 0) { std::cerr << "ERROR: LAS file " << path_to_LASer_file << " has no points to build an octree from!\n"; exit(EXIT_FAILURE); };
+
+	//the root is the cube around the bounds of the header
+	std::pair<vec3, vec3> bounds = cloud.get_openGL_bounds();
+	const vec3 minimum_bounds = bounds.first;
+	const vec3 extent = bounds.second - bounds.first;
+	const float size = std::max({ extent.x, extent.y, extent.z, 1e-6f }) * 1.0001f;
+
+	std::filesystem::create_directories(octree_directory);
+	const std::filesystem::path chunks_directory = octree_directory / "chunks";
+	std::filesystem::create_directories(chunks_directory);
+
+	//a quarter of the budget holds the decoded batch, another quarter the points waiting to be written into the chunk files
+	size_t points_per_batch = std::max<size_t>(1, host_memory_budget / (4 * sizeof(Point)));
+	points_per_batch = static_cast<size_t>(std::min<uint64_t>(points_per_batch, number_of_points));
+	if (points_per_batch > decoder.points_per_chunk) { points_per_batch -= points_per_batch % decoder.points_per_chunk; };
+	const size_t max_buffered_points = std::max<size_t>(1, host_memory_budget / (4 * sizeof(Point)));
+	std::vector<vec3> positions(points_per_batch);
+	std::vector<vec3> colors(points_per_batch);
+
+	//decodes every batch of the file and hands it to *function*, dropping the pages of the records once they were decoded
+	auto for_each_batch = [&](const std::function<void(const size_t& n_points)>& function) {
+
+		for (uint64_t first_point = 0; first_point < number_of_points; first_point += points_per_batch) {
+
+			const size_t n_points = static_cast<size_t>(std::min<uint64_t>(points_per_batch, number_of_points - first_point));
+			Thread_Pool::shared().parallel_for(n_points, decoder.points_per_chunk, [&](const size_t& first, const size_t& last) {
+
+				decoder.decode(first_point + first, first_point + last, positions.data() + first, colors.data() + first);
+
+			});
+			function(n_points);
+
+			std::pair<uint64_t, uint64_t> byte_range = decoder.get_byte_range(first_point, first_point + n_points);
+			file.discard(byte_range.first, byte_range.second);
+
+		};
+
+	};
+
+	//1st pass, counting the points on the finest grid
+	const int64_t n_cells = int64_t(1) << COUNTING_GRID_LEVEL;
+	std::vector<std::atomic<uint64_t>> counts(n_cells * n_cells * n_cells);
+	for_each_batch([&](const size_t& n_points) {
+
+		Thread_Pool::shared().parallel_for(n_points, 65536, [&](const size_t& first, const size_t& last) {
+
+			for (size_t i = first; i < last; i++) {
+
+				std::array<int64_t, 3> cell = get_cell(positions[i], minimum_bounds, size, COUNTING_GRID_LEVEL);
+				counts[(cell[2] * n_cells + cell[1]) * n_cells + cell[0]].fetch_add(1, std::memory_order_relaxed);
+
+			};
+
+		});
+
+	});
+
+	//the chunks are the largest nodes holding few enough points, at worst the cells of the counting grid themselves. Every chunk being built at once holds its points about twice
+	const uint64_t max_points_per_chunk = std::max<uint64_t>(uint64_t(MAX_POINTS_PER_LEAF) * 8, host_memory_budget / (2 * 2 * sizeof(Point) * Thread_Pool::shared().n_threads));
+	std::vector<Voxel_Key> chunk_keys;
+	std::vector<int32_t> chunk_of_cell(counts.size(), -1);
+	std::function<uint64_t(const Voxel_Key&)> count_points = [&](const Voxel_Key& key) {
+
+		const int64_t n_cells_per_node = int64_t(1) << (COUNTING_GRID_LEVEL - key.level);
+		uint64_t n_points = 0;
+		for (int64_t z = key.z * n_cells_per_node; z < (key.z + 1) * n_cells_per_node; z++) {
+
+			for (int64_t y = key.y * n_cells_per_node; y < (key.y + 1) * n_cells_per_node; y++) {
+
+				for (int64_t x = key.x * n_cells_per_node; x < (key.x + 1) * n_cells_per_node; x++) { n_points += counts[(z * n_cells + y) * n_cells + x].load(std::memory_order_relaxed); };
+
+			};
+
+		};
+		return n_points;
+
+	};
+	std::vector<Voxel_Key> stack = { Voxel_Key{ 0, 0, 0, 0 } };
+	while (!stack.empty()) {
+
+		Voxel_Key key = stack.back();
+		stack.pop_back();
+
+		const uint64_t n_points = count_points(key);
+		if (n_points == 0) { continue; };
+		if (n_points > max_points_per_chunk && key.level < COUNTING_GRID_LEVEL) {
+
+			for (int i = 0; i < 8; i++) { stack.push_back(key.get_child(i)); };
+			continue;
+
+		};
+
+		const int64_t n_cells_per_node = int64_t(1) << (COUNTING_GRID_LEVEL - key.level);
+		for (int64_t z = key.z * n_cells_per_node; z < (key.z + 1) * n_cells_per_node; z++) {
+
+			for (int64_t y = key.y * n_cells_per_node; y < (key.y + 1) * n_cells_per_node; y++) {
+
+				for (int64_t x = key.x * n_cells_per_node; x < (key.x + 1) * n_cells_per_node; x++) { chunk_of_cell[(z * n_cells + y) * n_cells + x] = static_cast<int32_t>(chunk_keys.size()); };
+
+			};
+
+		};
+		chunk_keys.push_back(key);
+
+	};
+	std::cout << "octree: " << number_of_points << " points split into " << chunk_keys.size() << " chunks of at most " << max_points_per_chunk << " points\n";
+
+	//2nd pass, spreading the points into one file per chunk. The buffers are flushed as soon as they hold too many points together
+	auto get_chunk_path = [&](const size_t& chunk) { return chunks_directory / (std::to_string(chunk) + ".bin"); };
+	std::vector<std::vector<Point>> chunk_buffers(chunk_keys.size());
+	size_t n_buffered_points = 0;
+	auto flush_chunk_buffers = [&]() {
+
+		for (size_t chunk = 0; chunk < chunk_buffers.size(); chunk++) {
+
+			if (chunk_buffers[chunk].empty()) { continue; };
+			std::ofstream chunk_file(get_chunk_path(chunk), std::ios::binary | std::ios::app);
+			if (!chunk_file) { std::cerr << "ERROR: failed to write the octree chunk file " << get_chunk_path(chunk) << "!\n"; exit(EXIT_FAILURE); };
+			chunk_file.write(reinterpret_cast<const char*>(chunk_buffers[chunk].data()), chunk_buffers[chunk].size() * sizeof(Point));
+			std::vector<Point>().swap(chunk_buffers[chunk]);
+
+		};
+		n_buffered_points = 0;
+
+	};
+	for_each_batch([&](const size_t& n_points) {
+
+		for (size_t i = 0; i < n_points; i++) {
+
+			std::array<int64_t, 3> cell = get_cell(positions[i], minimum_bounds, size, COUNTING_GRID_LEVEL);
+			chunk_buffers[chunk_of_cell[(cell[2] * n_cells + cell[1]) * n_cells + cell[0]]].push_back({ positions[i], colors[i] });
+			if (++n_buffered_points >= max_buffered_points) { flush_chunk_buffers(); };
+
+		};
+
+	});
+	flush_chunk_buffers();
+	std::vector<vec3>().swap(positions);
+	std::vector<vec3>().swap(colors);
+
+	//the nodes above the chunks are shared by several of them, so they are created up front and sampled chunk by chunk in the order of *chunk_keys*
+	std::unordered_map<Voxel_Key, Sampled_Node, COPC_Reader::Voxel_Key_Hasher> sampled_nodes;
+	for (const Voxel_Key& chunk_key : chunk_keys) {
+
+		for (int32_t level = 0; level < chunk_key.level; level++) {
+
+			const int32_t shift = chunk_key.level - level;
+			sampled_nodes.try_emplace(Voxel_Key{ level, chunk_key.x >> shift, chunk_key.y >> shift, chunk_key.z >> shift });
+
+		};
+
+	};
+	auto get_chunk_points = [&](const size_t& chunk) {
+
+		std::vector<Point> points(std::filesystem::file_size(get_chunk_path(chunk)) / sizeof(Point));
+		std::ifstream chunk_file(get_chunk_path(chunk), std::ios::binary);
+		chunk_file.read(reinterpret_cast<char*>(points.data()), points.size() * sizeof(Point));
+		if (!chunk_file) { std::cerr << "ERROR: failed to read the octree chunk file " << get_chunk_path(chunk) << "!\n"; exit(EXIT_FAILURE); };
+		return points;
+
+	};
+
+	//every chunk samples the nodes above it on its own first, without locking, into sets of its own
+	std::vector<std::vector<Upper_Sample>> chunk_samples(chunk_keys.size());
+	Thread_Pool::shared().parallel_for(chunk_keys.size(), 1, [&](const size_t& first, const size_t& last) {
+
+		for (size_t chunk = first; chunk < last; chunk++) {
+
+			const Voxel_Key& chunk_key = chunk_keys[chunk];
+			if (chunk_key.level == 0) { continue; };
+
+			const std::vector<Point> points = get_chunk_points(chunk);
+			std::vector<std::unordered_set<uint32_t>> occupied_cells(chunk_key.level);
+			for (uint32_t i = 0; i < points.size(); i++) {
+
+				for (int32_t level = 0; level < chunk_key.level; level++) {
+
+					const int32_t shift = chunk_key.level - level;
+					const Voxel_Key key = { level, chunk_key.x >> shift, chunk_key.y >> shift, chunk_key.z >> shift };
+					if (occupied_cells[level].insert(get_sampling_cell(points[i].position, minimum_bounds, size, key)).second) { chunk_samples[chunk].push_back({ i, level, points[i] }); break; };
+
+				};
+
+			};
+
+		};
+
+	});
+
+	//then the samples are merged serially in the order of the chunks, so the same file always gives the same octree. A sample whose cell an earlier chunk took tries the levels below it,
+	//and stays in its chunk when none is free. *taken_points* holds the indices of the points of every chunk that moved up, in increasing order
+	std::vector<std::vector<uint32_t>> taken_points(chunk_keys.size());
+	for (size_t chunk = 0; chunk < chunk_keys.size(); chunk++) {
+
+		const Voxel_Key& chunk_key = chunk_keys[chunk];
+		for (const Upper_Sample& sample : chunk_samples[chunk]) {
+
+			for (int32_t level = sample.level; level < chunk_key.level; level++) {
+
+				const int32_t shift = chunk_key.level - level;
+				const Voxel_Key key = { level, chunk_key.x >> shift, chunk_key.y >> shift, chunk_key.z >> shift };
+				Sampled_Node& node = sampled_nodes[key];
+				if (node.occupied_cells.insert(get_sampling_cell(sample.point.position, minimum_bounds, size, key)).second) { node.points.push_back(sample.point); taken_points[chunk].push_back(sample.index); break; };
+
+			};
+
+		};
+		std::vector<Upper_Sample>().swap(chunk_samples[chunk]);
+
+	};
+
+	//3rd pass, building the subtree of every chunk and appending its nodes to the point data file
+	std::ofstream points_file(octree_directory / POINTS_FILE_NAME, std::ios::binary | std::ios::trunc);
+	if (!points_file) { std::cerr << "ERROR: failed to create the octree file " << octree_directory / POINTS_FILE_NAME << "!\n"; exit(EXIT_FAILURE); };
+	std::mutex points_file_mutex;
+	uint64_t points_file_size = 0;
+	std::vector<Hierarchy_Entry> entries;
+	auto write_node = [&](const Voxel_Key& key, const std::vector<Point>& points) {
+
+		std::vector<vec3> node_data(2 * points.size());
+		for (size_t i = 0; i < points.size(); i++) {
+
+			node_data[i] = points[i].position;
+			node_data[points.size() + i] = points[i].color;
+
+		};
+
+		std::lock_guard<std::mutex> lock(points_file_mutex);
+		entries.push_back({ key, points_file_size, static_cast<uint32_t>(points.size()) });
+		points_file.write(reinterpret_cast<const char*>(node_data.data()), node_data.size() * sizeof(vec3));
+		points_file_size += node_data.size() * sizeof(vec3);
+
+	};
+
+	Thread_Pool::shared().parallel_for(chunk_keys.size(), 1, [&](const size_t& first, const size_t& last) {
+
+		for (size_t chunk = first; chunk < last; chunk++) {
+
+			const Voxel_Key& chunk_key = chunk_keys[chunk];
+			std::vector<Point> points = get_chunk_points(chunk);
+			std::filesystem::remove(get_chunk_path(chunk));
+
+			//points taken by a node above the chunk leave it, the others keep their order
+			size_t n_kept_points = 0, n_taken_points = 0;
+			for (uint32_t i = 0; i < points.size(); i++) {
+
+				if (n_taken_points < taken_points[chunk].size() && taken_points[chunk][n_taken_points] == i) { n_taken_points++; continue; };
+				points[n_kept_points++] = points[i];
+
+			};
+			points.resize(n_kept_points);
+			std::vector<uint32_t>().swap(taken_points[chunk]);
+
+			std::vector<Built_Node> built_nodes;
+			if (points.empty()) { built_nodes.push_back({ chunk_key, {} }); }
+			else { build_subtree(chunk_key, points, minimum_bounds, size, built_nodes); };
+			for (const Built_Node& node : built_nodes) { write_node(node.key, node.points); };
+
+		};
+
+	});
+	for (const auto& [key, node] : sampled_nodes) { write_node(key, node.points); };
+	points_file.close();
+	std::filesystem::remove_all(chunks_directory);
+
+	//parents before children, which *select_nodes* relies on
+	std::sort(entries.begin(), entries.end(), [](const Hierarchy_Entry& A, const Hierarchy_Entry& B) {
+
+		return std::tie(A.key.level, A.key.z, A.key.y, A.key.x) < std::tie(B.key.level, B.key.z, B.key.y, B.key.x);
+
+	});
+
+	Hierarchy_Header header = { { 'L', 'O', 'D', 'O' }, VERSION, number_of_points, static_cast<uint32_t>(entries.size()), 0, 0, 0, { minimum_bounds.x, minimum_bounds.y, minimum_bounds.z }, size };
+	Point_Cloud_Cache::identify_source(path_to_LASer_file, header.source_size, header.source_modification_time, header.source_hash);
+	std::ofstream hierarchy_file(octree_directory / HIERARCHY_FILE_NAME, std::ios::binary | std::ios::trunc);
+	hierarchy_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	hierarchy_file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(Hierarchy_Entry));
+	if (!hierarchy_file) { std::cerr << "ERROR: failed to write the octree hierarchy " << octree_directory / HIERARCHY_FILE_NAME << "!\n"; exit(EXIT_FAILURE); };
+
+	std::chrono::duration<double> elapsed_time = std::chrono::steady_clock::now() - start;
+	std::cout << "octree: built " << entries.size() << " nodes in " << elapsed_time.count() << " s\n";
+
+};
+
+bool Octree::exists(const std::filesystem::path& octree_directory, const std::filesystem::path& path_to_LASer_file) {
+
+	if (!std::filesystem::is_regular_file(octree_directory / HIERARCHY_FILE_NAME) || !std::filesystem::is_regular_file(octree_directory / POINTS_FILE_NAME)) { return false; };
+
+	//an octree of another version is built again instead of being read
+	Hierarchy_Header header;
+	std::ifstream hierarchy_file(octree_directory / HIERARCHY_FILE_NAME, std::ios::binary);
+	hierarchy_file.read(reinterpret_cast<char*>(&header), sizeof(header));
+	if (!hierarchy_file || std::string(header.signature, 4) != "LODO" || header.version != VERSION) { std::cout << "octree " << octree_directory << " is out of date\n"; return false; };
+
+	if (!std::filesystem::is_regular_file(path_to_LASer_file)) { std::cerr << "WARNING: cant check octree " << octree_directory << " against " << path_to_LASer_file << ", it doesnt exist!\n"; return true; };
+
+	uint64_t source_size;
+	int64_t source_modification_time;
+	uint64_t source_hash;
+	Point_Cloud_Cache::identify_source(path_to_LASer_file, source_size, source_modification_time, source_hash);
+	if (header.source_size != source_size || header.source_modification_time != source_modification_time || header.source_hash != source_hash) { std::cout << "octree " << octree_directory << " is out of date\n"; return false; };
+	return true;
+
+};
+
+Octree::Octree(const std::filesystem::path& octree_directory) : points_file(octree_directory / POINTS_FILE_NAME) {
+
+	std::ifstream hierarchy_file(octree_directory / HIERARCHY_FILE_NAME, std::ios::binary);
+	if (!hierarchy_file) { std::cerr << "ERROR: failed to open the octree hierarchy " << octree_directory / HIERARCHY_FILE_NAME << "!\n"; exit(EXIT_FAILURE); };
+
+	Hierarchy_Header header;
+	hierarchy_file.read(reinterpret_cast<char*>(&header), sizeof(header));
+	if (!hierarchy_file || std::string(header.signature, 4) != "LODO") { std::cerr << "ERROR: " << octree_directory << " doesnt hold an octree!\n"; exit(EXIT_FAILURE); };
+	if (header.version != VERSION) { std::cerr << "ERROR: octree " << octree_directory << " was built by another version, build it again!\n"; exit(EXIT_FAILURE); };
+
+	std::vector<Hierarchy_Entry> entries(header.number_of_nodes);
+	hierarchy_file.read(reinterpret_cast<char*>(entries.data()), entries.size() * sizeof(Hierarchy_Entry));
+	if (!hierarchy_file || entries.empty() || entries[0].key.level != 0) { std::cerr << "ERROR: octree hierarchy " << octree_directory / HIERARCHY_FILE_NAME << " is truncated!\n"; exit(EXIT_FAILURE); };
+
+	this->number_of_points = header.number_of_points;
+	this->minimum_bounds = vec3(header.minimum_bounds[0], header.minimum_bounds[1], header.minimum_bounds[2]);
+	this->size = header.size;
+
+	std::unordered_map<Voxel_Key, int32_t, COPC_Reader::Voxel_Key_Hasher> node_of_key;
+	this->nodes.reserve(entries.size());
+	for (const Hierarchy_Entry& entry : entries) {
+
+		if (entry.offset > this->points_file.size || 2 * uint64_t(entry.n_points) * sizeof(vec3) > this->points_file.size - entry.offset) { std::cerr << "ERROR: octree node " << entry.key.level << "-" << entry.key.x << "-" << entry.key.y << "-" << entry.key.z << " exceeds the point data!\n"; exit(EXIT_FAILURE); };
+
+		const float node_size = this->size / static_cast<float>(int64_t(1) << entry.key.level);
+		Node node;
+		node.key = entry.key;
+		node.n_points = entry.n_points;
+		node.offset = entry.offset;
+		node.children.fill(-1);
+		node.minimum_bounds = this->minimum_bounds + vec3(entry.key.x, entry.key.y, entry.key.z) * node_size;
+		node.maximum_bounds = node.minimum_bounds + vec3(node_size, node_size, node_size);
+		node.spacing = node_size / SAMPLING_GRID_RESOLUTION;
+
+		//parents are sorted before their children
+		if (entry.key.level > 0) {
+
+			auto parent = node_of_key.find(Voxel_Key{ entry.key.level - 1, entry.key.x >> 1, entry.key.y >> 1, entry.key.z >> 1 });
+			if (parent == node_of_key.end()) { std::cerr << "WARNING: octree node " << entry.key.level << "-" << entry.key.x << "-" << entry.key.y << "-" << entry.key.z << " has no parent, ignoring it!\n"; continue; };
+			this->nodes[parent->second].children[(entry.key.x & 1) | ((entry.key.y & 1) << 1) | ((entry.key.z & 1) << 2)] = static_cast<int32_t>(this->nodes.size());
+
+		};
+		node_of_key[entry.key] = static_cast<int32_t>(this->nodes.size());
+		this->nodes.push_back(node);
+
+	};
+
+};
+
+const vec3* Octree::get_positions(const Node& node) const {
+
+	return reinterpret_cast<const vec3*>(this->points_file.data + node.offset);
+
+};
+
+const vec3* Octree::get_colors(const Node& node) const {
+
+	return reinterpret_cast<const vec3*>(this->points_file.data + node.offset) + node.n_points;
+
+};
+
+float Octree::compute_screen_space_error(const Node& node, const View& view) const {
+
+	//orthographic projections keep the same size at every depth
+	float distance = 1.0f;
+	if (view.perspective) {
+
+		const vec3 center = (node.minimum_bounds + node.maximum_bounds) * 0.5f;
+		const float radius = (node.maximum_bounds - node.minimum_bounds).magnitude() * 0.5f * view.model_scale;
+		distance = (view.model_view_projection * vec4(center, 1.0f)).w - radius;
+		if (distance <= 0.0f) { return std::numeric_limits<float>::infinity(); };
+
+	};
+
+	return node.spacing * view.model_scale * view.projection_scale / distance * view.screen_height * 0.5f;
+
+};
+
+std::vector<uint32_t> Octree::select_nodes(const View& view, const uint64_t& point_budget, const float& max_screen_space_error) const {
+
+	std::vector<uint32_t> selected_nodes;
+	Frustum frustum(view.model_view_projection);
+
+	std::priority_queue<std::pair<float, uint32_t>> queue;
+	if (frustum.intersects_box(this->nodes[0].minimum_bounds, this->nodes[0].maximum_bounds)) { queue.push({ this->compute_screen_space_error(this->nodes[0], view), 0 }); };
+
+	uint64_t n_selected_points = 0;
+	while (!queue.empty()) {
+
+		const auto [screen_space_error, index] = queue.top();
+		queue.pop();
+
+		const Node& node = this->nodes[index];
+		if (n_selected_points + node.n_points > point_budget) { break; };
+		selected_nodes.push_back(index);
+		n_selected_points += node.n_points;
+
+		if (screen_space_error <= max_screen_space_error) { continue; };
+		for (const int32_t& child : node.children) {
+
+			if (child < 0 || !frustum.intersects_box(this->nodes[child].minimum_bounds, this->nodes[child].maximum_bounds)) { continue; };
+			queue.push({ this->compute_screen_space_error(this->nodes[child], view), static_cast<uint32_t>(child) });
+
+		};
+
+	};
+
+	return selected_nodes;
+
+};
@@ -0,0 +1,67 @@
+#include "computer_graphics/Outlier_Filter.h"
+
+uint64_t Outlier_Filter::remove_statistical_outliers(std::vector<vec3>& positions, std::vector<vec3>& colors, const uint32_t& neighbours, const float& standard_deviations, std::vector<uint32_t>* kept) {
+
+	if (neighbours == 0) {
+
+		std::cerr << "ERROR: statistical outlier removal needs at least one neighbour per point\n";
+		exit(EXIT_FAILURE);
+
+	};
+
+	auto start = std::chrono::steady_clock::now();
+	const size_t n_points = positions.size();
+	const bool has_colors = colors.size() == n_points;
+	std::vector<float> mean_distances = KD_Tree(positions).compute_mean_neighbour_distances(neighbours);
+
+	//sums in double per chunk, a float running sum over tens of millions of distances would drift
+	const size_t n_chunks = (n_points + POINTS_PER_TASK - 1) / POINTS_PER_TASK;
+	std::vector<std::pair<double, double>> chunk_sums(n_chunks, { 0.0, 0.0 });
+	Thread_Pool::shared().parallel_for(n_chunks, 1, [&](const size_t& first, const size_t& last) {
+
+		for (size_t chunk = first; chunk < last; ++chunk) {
+
+			const size_t end = std::min(n_points, (chunk + 1) * POINTS_PER_TASK);
+			for (size_t i = chunk * POINTS_PER_TASK; i < end; ++i) {
+
+				chunk_sums[chunk].first += mean_distances[i];
+				chunk_sums[chunk].second += double(mean_distances[i]) * double(mean_distances[i]);
+
+			};
+
+		};
+
+	});
+
+	double sum = 0.0, squared_sum = 0.0;
+	for (const std::pair<double, double>& chunk_sum : chunk_sums) {
+
+		sum += chunk_sum.first;
+		squared_sum += chunk_sum.second;
+
+	};
+	const double mean = n_points > 0 ? sum / double(n_points) : 0.0;
+	const double standard_deviation = n_points > 0 ? std::sqrt(std::max(squared_sum / double(n_points) - mean * mean, 0.0)) : 0.0;
+	const float threshold = float(mean + double(standard_deviations) * standard_deviation);
+
+	if (kept) { kept->clear(); kept->reserve(n_points); };
+	size_t n_kept = 0;
+	for (size_t i = 0; i < n_points; ++i) {
+
+		if (mean_distances[i] > threshold) { continue; };
+
+		positions[n_kept] = positions[i];
+		if (has_colors) { colors[n_kept] = colors[i]; };
+		if (kept) { kept->push_back(uint32_t(i)); };
+		++n_kept;
+
+	};
+	positions.resize(n_kept);
+	positions.shrink_to_fit();
+	if (has_colors) { colors.resize(n_kept); colors.shrink_to_fit(); };
+
+	std::chrono::duration<double> elapsed_time = std::chrono::steady_clock::now() - start;
+	std::cout << "removed " << n_points - n_kept << " outliers of " << n_points << " points, mean distance to " << neighbours << " neighbours above " << threshold << ", in " << elapsed_time.count() * 1000.0 << " ms\n";
+	return n_points - n_kept;
+
+};
@@ -1,9 +1,129 @@
 #include "computer_graphics/Point_Cloud.h"
 
-void Point_Cloud::extract_openGL_points_attributes(const std::filesystem::path& path_to_LASer_file, std::vector<vec3>& points_coordinates, std::vector<vec3>& points_colors) {
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define POINT_CLOUD_SSE2
+#endif
 
-	exit_if_file_doesnt_exist(path_to_LASer_file);
-	if (std::filesystem::is_directory(std::filesystem::path(path_to_LASer_file))) { std::cerr << "ERROR: path is a directory and not a LAS file!\n"; exit(EXIT_FAILURE); };
+#if defined(__AVX2__)
+//int32 -> double, scale and offset, origin and scale down, all in double precision, then rounded to float, exactly like the scalar *compute_openGL_point_coordinates*
+static inline __m256 dequantize_8_coordinates(const int32_t* raw, const __m256d& scale, const __m256d& offset, const __m256d& origin, const __m256d& scale_factor) {
+
+	__m256i integers = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(raw));
+	__m256d low = _mm256_add_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(integers)), scale), offset);
+	__m256d high = _mm256_add_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(integers, 1)), scale), offset);
+	low = _mm256_mul_pd(_mm256_sub_pd(low, origin), scale_factor);
+	high = _mm256_mul_pd(_mm256_sub_pd(high, origin), scale_factor);
+	return _mm256_set_m128(_mm256_cvtpd_ps(high), _mm256_cvtpd_ps(low));
+
+};
+
+static inline __m256 dequantize_8_colors(const uint16_t* raw, const __m256& divisor) {
+
+	__m128i integers = _mm_loadu_si128(reinterpret_cast<const __m128i*>(raw));
+	return _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(integers)), divisor);
+
+};
+#elif defined(POINT_CLOUD_SSE2)
+static inline __m128 dequantize_4_coordinates(const int32_t* raw, const __m128d& scale, const __m128d& offset, const __m128d& origin, const __m128d& scale_factor) {
+
+	__m128i integers = _mm_loadu_si128(reinterpret_cast<const __m128i*>(raw));
+	__m128d low = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(integers), scale), offset);
+	__m128d high = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(integers, _MM_SHUFFLE(1, 0, 3, 2))), scale), offset);
+	low = _mm_mul_pd(_mm_sub_pd(low, origin), scale_factor);
+	high = _mm_mul_pd(_mm_sub_pd(high, origin), scale_factor);
+	return _mm_movelh_ps(_mm_cvtpd_ps(low), _mm_cvtpd_ps(high));
+
+};
+
+static inline __m128 dequantize_4_colors(const uint16_t* raw, const __m128& divisor) {
+
+	__m128i integers = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(raw)), _mm_setzero_si128());
+	return _mm_div_ps(_mm_cvtepi32_ps(integers), divisor);
+
+};
+#endif
+
+void Point_Cloud::dequantize_openGL_points_attributes(const int32_t* X, const int32_t* Y, const int32_t* Z, const uint16_t* red, const uint16_t* green, const uint16_t* blue, const size_t& n_points, vec3* positions, vec3* colors) const {
+
+	size_t i = 0;
+
+#if defined(__AVX2__)
+	const __m256d scale_x = _mm256_set1_pd(this->quantization_scale[0]), scale_y = _mm256_set1_pd(this->quantization_scale[1]), scale_z = _mm256_set1_pd(this->quantization_scale[2]);
+	const __m256d offset_x = _mm256_set1_pd(this->quantization_offset[0]), offset_y = _mm256_set1_pd(this->quantization_offset[1]), offset_z = _mm256_set1_pd(this->quantization_offset[2]);
+	//the inverted openGL Z is (y + origin) * -scale, so Y gets a negated origin and scale
+	const __m256d origin_x = _mm256_set1_pd(this->openGL_origin[0]), origin_y = _mm256_set1_pd(-this->openGL_origin[2]), origin_z = _mm256_set1_pd(this->openGL_origin[1]);
+	const __m256d scale_factor = _mm256_set1_pd(this->scale_factor), negated_scale_factor = _mm256_set1_pd(-this->scale_factor);
+	const __m256 divisor = _mm256_set1_ps(255.0f);
+
+	alignas(32) float lanes[6][8];
+	for (; i + 8 <= n_points; i += 8) {
+
+		//LAS is Z up whilst openGL is Y up with an inverted Z, hence (x, z, -y)
+		_mm256_store_ps(lanes[0], dequantize_8_coordinates(X + i, scale_x, offset_x, origin_x, scale_factor));
+		_mm256_store_ps(lanes[1], dequantize_8_coordinates(Z + i, scale_z, offset_z, origin_z, scale_factor));
+		_mm256_store_ps(lanes[2], dequantize_8_coordinates(Y + i, scale_y, offset_y, origin_y, negated_scale_factor));
+		if (red != nullptr) {
+
+			_mm256_store_ps(lanes[3], dequantize_8_colors(red + i, divisor));
+			_mm256_store_ps(lanes[4], dequantize_8_colors(green + i, divisor));
+			_mm256_store_ps(lanes[5], dequantize_8_colors(blue + i, divisor));
+
+		};
+
+		for (size_t lane = 0; lane < 8; lane++) {
+
+			positions[i + lane] = vec3(lanes[0][lane], lanes[1][lane], lanes[2][lane]);
+			colors[i + lane] = red != nullptr ? vec3(lanes[3][lane], lanes[4][lane], lanes[5][lane]) : vec3(1.0f, 1.0f, 1.0f);
+
+		};
+
+	};
+#elif defined(POINT_CLOUD_SSE2)
+	const __m128d scale_x = _mm_set1_pd(this->quantization_scale[0]), scale_y = _mm_set1_pd(this->quantization_scale[1]), scale_z = _mm_set1_pd(this->quantization_scale[2]);
+	const __m128d offset_x = _mm_set1_pd(this->quantization_offset[0]), offset_y = _mm_set1_pd(this->quantization_offset[1]), offset_z = _mm_set1_pd(this->quantization_offset[2]);
+	const __m128d origin_x = _mm_set1_pd(this->openGL_origin[0]), origin_y = _mm_set1_pd(-this->openGL_origin[2]), origin_z = _mm_set1_pd(this->openGL_origin[1]);
+	const __m128d scale_factor = _mm_set1_pd(this->scale_factor), negated_scale_factor = _mm_set1_pd(-this->scale_factor);
+	const __m128 divisor = _mm_set1_ps(255.0f);
+
+	alignas(16) float lanes[6][4];
+	for (; i + 4 <= n_points; i += 4) {
+
+		//LAS is Z up whilst openGL is Y up with an inverted Z, hence (x, z, -y)
+		_mm_store_ps(lanes[0], dequantize_4_coordinates(X + i, scale_x, offset_x, origin_x, scale_factor));
+		_mm_store_ps(lanes[1], dequantize_4_coordinates(Z + i, scale_z, offset_z, origin_z, scale_factor));
+		_mm_store_ps(lanes[2], dequantize_4_coordinates(Y + i, scale_y, offset_y, origin_y, negated_scale_factor));
+		if (red != nullptr) {
+
+			_mm_store_ps(lanes[3], dequantize_4_colors(red + i, divisor));
+			_mm_store_ps(lanes[4], dequantize_4_colors(green + i, divisor));
+			_mm_store_ps(lanes[5], dequantize_4_colors(blue + i, divisor));
+
+		};
+
+		for (size_t lane = 0; lane < 4; lane++) {
+
+			positions[i + lane] = vec3(lanes[0][lane], lanes[1][lane], lanes[2][lane]);
+			colors[i + lane] = red != nullptr ? vec3(lanes[3][lane], lanes[4][lane], lanes[5][lane]) : vec3(1.0f, 1.0f, 1.0f);
+
+		};
+
+	};
+#endif
+
+	//scalar fallback, also handles the tail of the batch that doesnt fill a whole register
+	for (; i < n_points; i++) {
+
+		positions[i] = this->compute_openGL_point_coordinates((X[i] * this->quantization_scale[0]) + this->quantization_offset[0], (Y[i] * this->quantization_scale[1]) + this->quantization_offset[1], (Z[i] * this->quantization_scale[2]) + this->quantization_offset[2]);
+		colors[i] = red != nullptr ? vec3(red[i], green[i], blue[i]) / 255.0f : vec3(1.0f, 1.0f, 1.0f);
+
+	};
+
+};
+
+void Point_Cloud::extract_openGL_points_attributes_from_stream(const std::filesystem::path& path_to_LASer_file, std::vector<vec3>& points_coordinates, std::vector<vec3>& points_colors) {
 
 	std::ifstream data(path_to_LASer_file, std::ios::binary);
 	if (!data.is_open()) { std::cerr << "ERROR: failed to open LAS file!\n"; exit(EXIT_FAILURE); };
@@ -17,7 +137,14 @@ void Point_Cloud::extract_openGL_points_attributes(const std::filesystem::path&
 	data.read(reinterpret_cast<char*>(&version_major), 1); data.read(reinterpret_cast<char*>(&version_minor), 1);
 	if (version_major != 1) { std::cerr << "ERROR: major version must be 1! read version is " << static_cast<int>(version_major) << "!\n"; data.clear(); data.close(); exit(EXIT_FAILURE); };
 
+	//the point data record format sits at the same offset in every header version
+	data.seekg(104, std::ios::beg);
+	uint8_t point_data_record_format;
+	data.read(reinterpret_cast<char*>(&point_data_record_format), 1);
+	if (point_data_record_format & COMPRESSED_POINT_DATA_RECORD_FORMAT_BITS) { std::cerr << "ERROR: LAZ files can only be read through a memory map!\n"; data.clear(); data.close(); exit(EXIT_FAILURE); };
+
 	data.seekg(0, std::ios::beg);
+	uint64_t n_kept_points = 0;
 	switch (version_minor) {
 
 		case 0: {
@@ -33,7 +160,7 @@ void Point_Cloud::extract_openGL_points_attributes(const std::filesystem::path&
 			data.seekg(header.offset_to_point_data, std::ios::beg);
 			for (int i = 0; i < header.number_of_point_records; i++) {
 
-				read_point_and_extract_openGL_attributes(header, data, points_coordinates[i], points_colors[i]);
+				n_kept_points += read_point_and_extract_openGL_attributes(header, data, points_coordinates[n_kept_points], points_colors[n_kept_points]);
 
 			};
 
@@ -54,7 +181,7 @@ void Point_Cloud::extract_openGL_points_attributes(const std::filesystem::path&
 			data.seekg(header.offset_to_point_data, std::ios::beg);
 			for (int i = 0; i < header.number_of_point_records; i++) {
 
-				read_point_and_extract_openGL_attributes(header, data, points_coordinates[i], points_colors[i]);
+				n_kept_points += read_point_and_extract_openGL_attributes(header, data, points_coordinates[n_kept_points], points_colors[n_kept_points]);
 
 			};
 
@@ -75,7 +202,7 @@ void Point_Cloud::extract_openGL_points_attributes(const std::filesystem::path&
 			data.seekg(header.offset_to_point_data, std::ios::beg);
 			for (int i = 0; i < header.number_of_point_records; i++) {
 
-				read_point_and_extract_openGL_attributes(header, data, points_coordinates[i], points_colors[i]);
+				n_kept_points += read_point_and_extract_openGL_attributes(header, data, points_coordinates[n_kept_points], points_colors[n_kept_points]);
 
 			};
 
@@ -96,7 +223,7 @@ void Point_Cloud::extract_openGL_points_attributes(const std::filesystem::path&
 			data.seekg(header.offset_to_point_data, std::ios::beg);
 			for (int i = 0; i < header.number_of_point_records; i++) {
 
-				read_point_and_extract_openGL_attributes(header, data, points_coordinates[i], points_colors[i]);
+				n_kept_points += read_point_and_extract_openGL_attributes(header, data, points_coordinates[n_kept_points], points_colors[n_kept_points]);
 
 			};
 
@@ -117,7 +244,7 @@ void Point_Cloud::extract_openGL_points_attributes(const std::filesystem::path&
 			data.seekg(header.offset_to_point_data, std::ios::beg);
 			for (int i = 0; i < header.number_of_point_records; i++) {
 
-				read_point_and_extract_openGL_attributes(header, data, points_coordinates[i], points_colors[i]);
+				n_kept_points += read_point_and_extract_openGL_attributes(header, data, points_coordinates[n_kept_points], points_colors[n_kept_points]);
 
 			};
 
@@ -128,10 +255,727 @@ void Point_Cloud::extract_openGL_points_attributes(const std::filesystem::path&
 	};
 
 	if (!data.good()) { std::cerr << "ERROR: data stream was bad!\n"; data.clear(); data.close(); exit(EXIT_FAILURE); };
+	points_coordinates.resize(n_kept_points);
+	points_colors.resize(n_kept_points);
+	if (points_coordinates.empty() && this->point_filter.is_active()) { std::cerr << "ERROR: the point filter rejected every point!\n"; data.clear(); data.close(); exit(EXIT_FAILURE); };
 	if (points_coordinates.empty()) { std::cerr << "ERROR: points_coordinates vector was empty!\n"; data.clear(); data.close(); exit(EXIT_FAILURE); };
 	data.clear();
 	data.close();
 
+};
+
+Point_Cloud::Points_Decoder Point_Cloud::create_openGL_points_decoder(const Memory_Mapped_File& file) {
+
+	if (file.size < 26) { std::cerr << "ERROR: couldnt read file!\n"; exit(EXIT_FAILURE); };
+	if (std::string(file.data, 4) != "LASF") { std::cerr << "ERROR: not a valid LAS file!\n"; exit(EXIT_FAILURE); };
+
+	uint8_t version_major = static_cast<uint8_t>(file.data[24]);
+	uint8_t version_minor = static_cast<uint8_t>(file.data[25]);
+	if (version_major != 1) { std::cerr << "ERROR: major version must be 1! read version is " << static_cast<int>(version_major) << "!\n"; exit(EXIT_FAILURE); };
+
+	switch (version_minor) {
+
+		case 0: return this->create_openGL_points_decoder<Public_Header_Block_Version_1_0>(file);
+		case 1: return this->create_openGL_points_decoder<Public_Header_Block_Version_1_1>(file);
+		case 2: return this->create_openGL_points_decoder<Public_Header_Block_Version_1_2>(file);
+		case 3: return this->create_openGL_points_decoder<Public_Header_Block_Version_1_3>(file);
+		case 4: return this->create_openGL_points_decoder<Public_Header_Block_Version_1_4>(file);
+		default: std::cerr << "ERROR: unsupported LAS minor version " << static_cast<int>(version_minor) << "!\n"; exit(EXIT_FAILURE);
+
+	};
+
+};
+
+std::pair<vec3, vec3> Point_Cloud::get_openGL_bounds() const {
+
+	//the Y to Z flip swaps which corner holds the minimum, so we take the per component extremes of both transformed corners
+	float minimum_bounds[3], maximum_bounds[3];
+	for (int axis = 0; axis < 3; axis++) {
+
+		const double A = (this->openGL_min_position[axis] - this->openGL_center[axis]) * this->scale_factor;
+		const double B = (this->openGL_max_position[axis] - this->openGL_center[axis]) * this->scale_factor;
+		minimum_bounds[axis] = std::min(A, B);
+		maximum_bounds[axis] = std::max(A, B);
+
+	};
+	return { vec3(minimum_bounds[0], minimum_bounds[1], minimum_bounds[2]), vec3(maximum_bounds[0], maximum_bounds[1], maximum_bounds[2]) };
+
+};
+
+vec3 Point_Cloud::compute_openGL_coordinates(const double& x, const double& y, const double& z) const {
+
+	return vec3((x - this->openGL_center[0]) * this->scale_factor, (z - this->openGL_center[1]) * this->scale_factor, (y + this->openGL_center[2]) * -this->scale_factor);
+
+};
+
+void Point_Cloud::set_openGL_frame(const double minimum_bounds[3], const double maximum_bounds[3]) {
+
+	//since the LAS geospace takes Z as up whilst openGL takes Y(and Y inverted at that), we need to switch them
+	this->openGL_min_position[0] = minimum_bounds[0]; this->openGL_min_position[1] = minimum_bounds[2]; this->openGL_min_position[2] = -minimum_bounds[1];
+	this->openGL_max_position[0] = maximum_bounds[0]; this->openGL_max_position[1] = maximum_bounds[2]; this->openGL_max_position[2] = -maximum_bounds[1];
+
+	double squared_length = 0.0;
+	for (int axis = 0; axis < 3; axis++) {
+
+		this->openGL_center[axis] = (this->openGL_min_position[axis] + this->openGL_max_position[axis]) * 0.5;
+		this->openGL_origin[axis] = this->openGL_center[axis];
+		squared_length += (this->openGL_max_position[axis] - this->openGL_min_position[axis]) * (this->openGL_max_position[axis] - this->openGL_min_position[axis]);
+
+	};
+	this->length = std::sqrt(squared_length);
+	this->scale_factor = 100.0 / this->length;
+
+};
+
+void Point_Cloud::set_openGL_origin(const double& x, const double& y, const double& z) {
+
+	this->openGL_origin[0] = x; this->openGL_origin[1] = z; this->openGL_origin[2] = -y;
+
+};
+
+void Point_Cloud::get_openGL_origin(double origin[3]) const {
+
+	for (int axis = 0; axis < 3; axis++) { origin[axis] = (this->openGL_origin[axis] - this->openGL_center[axis]) * this->scale_factor; };
+
+};
+
+Point_Cloud::Geospatial_Frame Point_Cloud::get_geospatial_frame() const {
+
+	Geospatial_Frame frame;
+	frame.scale_factor = this->scale_factor;
+	for (int axis = 0; axis < 3; axis++) {
+
+		frame.origin[axis] = this->openGL_origin[axis];
+		frame.quantization_scale[axis] = this->quantization_scale[axis];
+		frame.quantization_offset[axis] = this->quantization_offset[axis];
+
+	};
+	return frame;
+
+};
+
+Point_Cloud::Geospatial_Frame Point_Cloud::read_geospatial_frame(const std::filesystem::path& path_to_LASer_file) {
+
+	Header_Summary summary = read_header_summary(path_to_LASer_file);
+	if (!summary.valid) { std::cerr << "ERROR: cant read the header of " << path_to_LASer_file << ": " << summary.error << "!\n"; exit(EXIT_FAILURE); };
+
+	//the same frame *extract_members_data* sets up when the file is decoded
+	Point_Cloud cloud;
+	cloud.set_openGL_frame(summary.minimum_bounds, summary.maximum_bounds);
+	for (int axis = 0; axis < 3; axis++) {
+
+		cloud.quantization_scale[axis] = summary.scale[axis];
+		cloud.quantization_offset[axis] = summary.offset[axis];
+
+	};
+	return cloud.get_geospatial_frame();
+
+};
+
+std::vector<Point_Cloud::Coordinate_Reference_System_Record> Point_Cloud::read_coordinate_reference_system(const std::filesystem::path& path_to_LASer_file) {
+
+	Header_Summary summary = read_header_summary(path_to_LASer_file);
+	if (!summary.valid) { std::cerr << "ERROR: cant read the header of " << path_to_LASer_file << ": " << summary.error << "!\n"; exit(EXIT_FAILURE); };
+
+	Point_Cloud cloud;
+	Memory_Mapped_File file(path_to_LASer_file);
+	switch (summary.version_minor) {
+
+		case 0: cloud.read_variable_length_records(cloud.read_header_from_memory<Public_Header_Block_Version_1_0>(file), file); break;
+		case 1: cloud.read_variable_length_records(cloud.read_header_from_memory<Public_Header_Block_Version_1_1>(file), file); break;
+		case 2: cloud.read_variable_length_records(cloud.read_header_from_memory<Public_Header_Block_Version_1_2>(file), file); break;
+		case 3: cloud.read_variable_length_records(cloud.read_header_from_memory<Public_Header_Block_Version_1_3>(file), file); break;
+		case 4: cloud.read_variable_length_records(cloud.read_header_from_memory<Public_Header_Block_Version_1_4>(file), file); break;
+
+	};
+
+	std::vector<Coordinate_Reference_System_Record> records;
+	for (const Variable_Length_Record& record : cloud.variable_length_records) {
+
+		if (record.user_ID != "LASF_Projection") { continue; };
+		if (record.record_ID != WKT_MATH_TRANSFORM_RECORD_ID && record.record_ID != WKT_COORDINATE_SYSTEM_RECORD_ID && (record.record_ID < GEO_KEY_DIRECTORY_RECORD_ID || record.record_ID > GEO_ASCII_PARAMS_RECORD_ID)) { continue; };
+		records.push_back({ record.record_ID, record.description, std::vector<char>(file.data + record.offset_to_data, file.data + record.offset_to_data + record.record_length) });
+
+	};
+	return records;
+
+};
+
+Point_Cloud::Header_Summary Point_Cloud::read_header_summary(const std::filesystem::path& path_to_LASer_file) {
+
+	Header_Summary summary = {};
+	summary.path = path_to_LASer_file;
+
+	std::error_code error;
+	summary.file_size = std::filesystem::file_size(path_to_LASer_file, error);
+	if (error) { summary.error = error.message(); return summary; };
+
+	//the largest header version is all that is ever read, the point data isnt touched
+	char header_bytes[sizeof(Public_Header_Block_Version_1_4)];
+	std::ifstream data(path_to_LASer_file, std::ios::binary);
+	if (!data.is_open()) { summary.error = "failed to open file"; return summary; };
+	data.read(header_bytes, sizeof(header_bytes));
+	const size_t n_header_bytes = static_cast<size_t>(data.gcount());
+
+	if (n_header_bytes < 26 || std::string(header_bytes, 4) != "LASF") { summary.error = "not a valid LAS file"; return summary; };
+	summary.version_major = static_cast<uint8_t>(header_bytes[24]);
+	summary.version_minor = static_cast<uint8_t>(header_bytes[25]);
+	if (summary.version_major != 1) { summary.error = "unsupported major version " + std::to_string(summary.version_major); return summary; };
+
+	switch (summary.version_minor) {
+
+		case 0: summarize_header<Public_Header_Block_Version_1_0>(header_bytes, n_header_bytes, summary); break;
+		case 1: summarize_header<Public_Header_Block_Version_1_1>(header_bytes, n_header_bytes, summary); break;
+		case 2: summarize_header<Public_Header_Block_Version_1_2>(header_bytes, n_header_bytes, summary); break;
+		case 3: summarize_header<Public_Header_Block_Version_1_3>(header_bytes, n_header_bytes, summary); break;
+		case 4: summarize_header<Public_Header_Block_Version_1_4>(header_bytes, n_header_bytes, summary); break;
+		default: summary.error = "unsupported minor version " + std::to_string(summary.version_minor); break;
+
+	};
+
+	return summary;
+
+};
+
+std::vector<Point_Cloud::Header_Summary> Point_Cloud::read_header_summaries(const std::vector<std::filesystem::path>& paths_to_LASer_files) {
+
+	//every file costs an open and a single small read, so the time goes into waiting on the file system and many files are read at once
+	static constexpr size_t FILES_PER_TASK = 16;
+
+	std::vector<Header_Summary> summaries(paths_to_LASer_files.size());
+	Thread_Pool::shared().parallel_for(paths_to_LASer_files.size(), FILES_PER_TASK, [&](const size_t& first, const size_t& last) {
+
+		for (size_t i = first; i < last; i++) { summaries[i] = read_header_summary(paths_to_LASer_files[i]); };
+
+	});
+
+	return summaries;
+
+};
+
+double Point_Cloud::Extra_Bytes_Column::get_value(const uint64_t& point, const uint8_t& element) const {
+
+	double value;
+	switch (this->data_type) {
+
+		case UNSIGNED_CHAR: value = this->get<uint8_t>(point, element); break;
+		case CHAR: value = this->get<int8_t>(point, element); break;
+		case UNSIGNED_SHORT: value = this->get<uint16_t>(point, element); break;
+		case SHORT: value = this->get<int16_t>(point, element); break;
+		case UNSIGNED_LONG: value = this->get<uint32_t>(point, element); break;
+		case LONG: value = this->get<int32_t>(point, element); break;
+		case UNSIGNED_LONG_LONG: value = static_cast<double>(this->get<uint64_t>(point, element)); break;
+		case LONG_LONG: value = static_cast<double>(this->get<int64_t>(point, element)); break;
+		case FLOAT: value = this->get<float>(point, element); break;
+		case DOUBLE: value = this->get<double>(point, element); break;
+		//undocumented extra bytes have no type, the best we can do is their first byte
+		default: value = this->get<uint8_t>(point, 0); break;
+
+	};
+
+	if (this->options & SCALE_IS_RELEVANT) value *= this->scale[element];
+	if (this->options & OFFSET_IS_RELEVANT) value += this->offset[element];
+	return value;
+
+};
+
+void Point_Cloud::read_extra_bytes_descriptors(const Memory_Mapped_File& file, const uint64_t& point_data_record_size, const uint64_t& point_data_record_length) {
+
+	this->extra_bytes_columns.clear();
+
+	auto descriptors = std::find_if(this->variable_length_records.begin(), this->variable_length_records.end(), [](const Variable_Length_Record& record) { return record.user_ID == "LASF_Spec" && record.record_ID == 4; });
+	if (descriptors == this->variable_length_records.end()) return;
+	if (descriptors->record_length % sizeof(Extra_Bytes_Descriptor) != 0) std::cerr << "WARNING: Extra Bytes VLR length " << descriptors->record_length << " isnt a multiple of " << sizeof(Extra_Bytes_Descriptor) << "!\n";
+
+	//sizes in bytes of the spec data types 1 to 10
+	static constexpr uint8_t DATA_TYPE_SIZES[11] = { 0, 1, 1, 2, 2, 4, 4, 8, 8, 4, 8 };
+
+	uint64_t offset_in_record = point_data_record_size;
+	const uint64_t n_descriptors = descriptors->record_length / sizeof(Extra_Bytes_Descriptor);
+	for (uint64_t i = 0; i < n_descriptors; i++) {
+
+		Extra_Bytes_Descriptor descriptor;
+		std::memcpy(&descriptor, file.data + descriptors->offset_to_data + i * sizeof(Extra_Bytes_Descriptor), sizeof(Extra_Bytes_Descriptor));
+
+		Extra_Bytes_Column column;
+		column.name = fixed_length_string(descriptor.name, 32);
+		column.description = fixed_length_string(descriptor.description, 32);
+		column.options = descriptor.options;
+		if (descriptor.data_type == Extra_Bytes_Column::UNDOCUMENTED_EXTRA_BYTES) {
+
+			//for undocumented extra bytes the options field holds their count instead of flags
+			column.data_type = Extra_Bytes_Column::UNDOCUMENTED_EXTRA_BYTES;
+			column.n_elements = 1;
+			column.element_size = descriptor.options;
+			column.options = 0;
+
+		}
+		else if (descriptor.data_type <= 30) {
+
+			//types 11 to 30 are the deprecated 2 and 3 element arrays of types 1 to 10
+			column.data_type = (descriptor.data_type - 1) % 10 + 1;
+			column.n_elements = (descriptor.data_type - 1) / 10 + 1;
+			column.element_size = DATA_TYPE_SIZES[column.data_type];
+
+		}
+		else { std::cerr << "WARNING: Extra Bytes attribute " << column.name << " has unknown data type " << static_cast<int>(descriptor.data_type) << ", ignoring it and the attributes after it!\n"; break; };
+
+		column.size = column.n_elements * column.element_size;
+		if (column.size == 0 || offset_in_record + column.size > point_data_record_length) { std::cerr << "WARNING: Extra Bytes attribute " << column.name << " doesnt fit inside the point data record, ignoring it and the attributes after it!\n"; break; };
+
+		column.offset_in_record = static_cast<uint16_t>(offset_in_record);
+		std::memcpy(column.scale, descriptor.scale, sizeof(column.scale));
+		std::memcpy(column.offset, descriptor.offset, sizeof(column.offset));
+		offset_in_record += column.size;
+
+		this->extra_bytes_columns.push_back(std::move(column));
+
+	};
+
+};
+
+bool Point_Cloud::Point_Filter::accepts(const char* record, const uint8_t& point_data_record_format) const {
+
+	switch (point_data_record_format) {
+
+		case 0: return this->accepts<Point_Data_Record_Format_0>(record);
+		case 1: return this->accepts<Point_Data_Record_Format_1>(record);
+		case 2: return this->accepts<Point_Data_Record_Format_2>(record);
+		case 3: return this->accepts<Point_Data_Record_Format_3>(record);
+		case 4: return this->accepts<Point_Data_Record_Format_4>(record);
+		case 5: return this->accepts<Point_Data_Record_Format_5>(record);
+		case 6: return this->accepts<Point_Data_Record_Format_6>(record);
+		case 7: return this->accepts<Point_Data_Record_Format_7>(record);
+		case 8: return this->accepts<Point_Data_Record_Format_8>(record);
+		case 9: return this->accepts<Point_Data_Record_Format_9>(record);
+		case 10: return this->accepts<Point_Data_Record_Format_10>(record);
+		default: std::cerr << "ERROR: unsupported Data Record Format " << static_cast<int>(point_data_record_format) << "\n"; exit(EXIT_FAILURE);
+
+	};
+
+};
+
+void Point_Cloud::extract_extra_bytes_columns(const char* records, const uint64_t& point_data_record_length, const uint8_t& point_data_record_format, const uint64_t& n_records, const uint64_t& first_value) {
+
+	const bool filtering = this->point_filter.is_active();
+	for (Extra_Bytes_Column& column : this->extra_bytes_columns) {
+
+		const char* record = records;
+		uint8_t* value = column.values.data() + first_value * column.size;
+		for (uint64_t i = 0; i < n_records; i++, record += point_data_record_length) {
+
+			if (filtering && !this->point_filter.accepts(record, point_data_record_format)) { continue; };
+			std::memcpy(value, record + column.offset_in_record, column.size);
+			value += column.size;
+
+		};
+
+	};
+
+};
+
+void Point_Cloud::extract_point_attributes_columns(const char* records, const uint64_t& point_data_record_length, const uint8_t& point_data_record_format, const uint64_t& n_records, const uint64_t& first_value) {
+
+	switch (point_data_record_format) {
+
+		case 0: { this->extract_point_attributes_columns<Point_Data_Record_Format_0>(records, point_data_record_length, n_records, first_value); break; };
+		case 1: { this->extract_point_attributes_columns<Point_Data_Record_Format_1>(records, point_data_record_length, n_records, first_value); break; };
+		case 2: { this->extract_point_attributes_columns<Point_Data_Record_Format_2>(records, point_data_record_length, n_records, first_value); break; };
+		case 3: { this->extract_point_attributes_columns<Point_Data_Record_Format_3>(records, point_data_record_length, n_records, first_value); break; };
+		case 4: { this->extract_point_attributes_columns<Point_Data_Record_Format_4>(records, point_data_record_length, n_records, first_value); break; };
+		case 5: { this->extract_point_attributes_columns<Point_Data_Record_Format_5>(records, point_data_record_length, n_records, first_value); break; };
+		case 6: { this->extract_point_attributes_columns<Point_Data_Record_Format_6>(records, point_data_record_length, n_records, first_value); break; };
+		case 7: { this->extract_point_attributes_columns<Point_Data_Record_Format_7>(records, point_data_record_length, n_records, first_value); break; };
+		case 8: { this->extract_point_attributes_columns<Point_Data_Record_Format_8>(records, point_data_record_length, n_records, first_value); break; };
+		case 9: { this->extract_point_attributes_columns<Point_Data_Record_Format_9>(records, point_data_record_length, n_records, first_value); break; };
+		case 10: { this->extract_point_attributes_columns<Point_Data_Record_Format_10>(records, point_data_record_length, n_records, first_value); break; };
+		default: std::cerr << "ERROR: unsupported Data Record Format " << static_cast<int>(point_data_record_format) << "\n"; exit(EXIT_FAILURE);
+
+	};
+
+};
+
+void Point_Cloud::Point_Attributes::resize(const uint64_t& n_points, const bool& has_GPS_times) {
+
+	this->intensities.resize(n_points);
+	this->classifications.resize(n_points);
+	this->returns.resize(n_points);
+	this->GPS_times.resize(has_GPS_times ? n_points : 0);
+
+};
+
+void Point_Cloud::Point_Attributes::shrink_to_fit() {
+
+	this->intensities.shrink_to_fit();
+	this->classifications.shrink_to_fit();
+	this->returns.shrink_to_fit();
+	this->GPS_times.shrink_to_fit();
+
+};
+
+void Point_Cloud::Point_Attributes::copy(const Point_Attributes& source, const uint64_t& first_source_point, const uint64_t& first_point, const uint64_t& n_points) {
+
+	std::memmove(this->intensities.data() + first_point, source.intensities.data() + first_source_point, n_points * sizeof(uint16_t));
+	std::memmove(this->classifications.data() + first_point, source.classifications.data() + first_source_point, n_points);
+	std::memmove(this->returns.data() + first_point, source.returns.data() + first_source_point, n_points);
+	if (!this->GPS_times.empty() && !source.GPS_times.empty()) { std::memmove(this->GPS_times.data() + first_point, source.GPS_times.data() + first_source_point, n_points * sizeof(double)); };
+
+};
+
+Point_Cloud::Point_Attributes Point_Cloud::Point_Attributes::gather(const std::vector<uint32_t>& indices) const {
+
+	Point_Attributes gathered;
+	gathered.resize(indices.size(), !this->GPS_times.empty());
+	for (size_t i = 0; i < indices.size(); i++) {
+
+		gathered.intensities[i] = this->intensities[indices[i]];
+		gathered.classifications[i] = this->classifications[indices[i]];
+		gathered.returns[i] = this->returns[indices[i]];
+		if (!this->GPS_times.empty()) { gathered.GPS_times[i] = this->GPS_times[indices[i]]; };
+
+	};
+	return gathered;
+
+};
+
+//maps the file once and decodes every record in place starting at *offset_to_point_data*, either serially or split into chunks across the shared *Thread_Pool*
+void Point_Cloud::extract_openGL_points_attributes_from_memory(const std::filesystem::path& path_to_LASer_file, std::vector<vec3>& points_coordinates, std::vector<vec3>& points_colors, const bool& in_parallel) {
+
+	Memory_Mapped_File file(path_to_LASer_file);
+	Points_Decoder decoder = this->create_openGL_points_decoder(file);
+
+	points_coordinates.resize(decoder.number_of_point_records);
+	points_colors.resize(decoder.number_of_point_records);
+	//the columns keep their descriptors even when their values arent extracted, so callers can still see which attributes the file has
+	if (this->extract_extra_bytes) { for (Extra_Bytes_Column& column : this->extra_bytes_columns) column.values.resize(decoder.number_of_point_records * column.size); };
+	if (this->extract_point_attributes) { this->point_attributes.resize(decoder.number_of_point_records, has_GPS_time(decoder.point_data_record_format)); };
+	if (!this->extract_extra_bytes && !this->extract_point_attributes) { decoder.decode_attributes = nullptr; };
+
+	uint64_t n_kept_points = 0;
+	if (in_parallel) {
+
+		//each record is independent and uses the same per point math as the serial path, so the result is bit identical. For LAZ files every task decompresses whole chunks of its own
+		const uint64_t n_chunks = (decoder.number_of_point_records + decoder.points_per_chunk - 1) / decoder.points_per_chunk;
+		std::vector<uint64_t> n_chunk_kept_points(n_chunks, 0);
+		Thread_Pool::shared().parallel_for(decoder.number_of_point_records, decoder.points_per_chunk, [&](const size_t& first, const size_t& last) {
+
+			n_chunk_kept_points[first / decoder.points_per_chunk] = decoder.decode(first, last, points_coordinates.data() + first, points_colors.data() + first);
+			if (decoder.decode_attributes) decoder.decode_attributes(first, last);
+
+		});
+
+		//every chunk wrote its kept points at the start of its own slice, those are moved down to follow the previous chunks. Moves only go down, so in order they never overwrite unmoved points
+		for (uint64_t chunk = 0; chunk < n_chunks; chunk++) {
+
+			const uint64_t first = chunk * decoder.points_per_chunk;
+			const uint64_t n_points = n_chunk_kept_points[chunk];
+			if (first != n_kept_points) {
+
+				std::memmove(points_coordinates.data() + n_kept_points, points_coordinates.data() + first, n_points * sizeof(vec3));
+				std::memmove(points_colors.data() + n_kept_points, points_colors.data() + first, n_points * sizeof(vec3));
+				for (Extra_Bytes_Column& column : this->extra_bytes_columns) {
+
+					if (!column.values.empty()) std::memmove(column.values.data() + n_kept_points * column.size, column.values.data() + first * column.size, n_points * column.size);
+
+				};
+				if (!this->point_attributes.empty()) this->point_attributes.copy(this->point_attributes, first, n_kept_points, n_points);
+
+			};
+			n_kept_points += n_points;
+
+		};
+
+	}
+	else {
+
+		n_kept_points = decoder.decode(0, decoder.number_of_point_records, points_coordinates.data(), points_colors.data());
+		if (decoder.decode_attributes) decoder.decode_attributes(0, decoder.number_of_point_records);
+
+	};
+
+	//the space of the rejected points is given back
+	if (n_kept_points != decoder.number_of_point_records) {
+
+		points_coordinates.resize(n_kept_points); points_coordinates.shrink_to_fit();
+		points_colors.resize(n_kept_points); points_colors.shrink_to_fit();
+		for (Extra_Bytes_Column& column : this->extra_bytes_columns) {
+
+			if (!column.values.empty()) { column.values.resize(n_kept_points * column.size); column.values.shrink_to_fit(); };
+
+		};
+		if (!this->point_attributes.empty()) { this->point_attributes.resize(n_kept_points, !this->point_attributes.GPS_times.empty()); this->point_attributes.shrink_to_fit(); };
+
+	};
+
+	if (points_coordinates.empty() && this->point_filter.is_active()) { std::cerr << "ERROR: the point filter rejected every point!\n"; exit(EXIT_FAILURE); };
+	if (points_coordinates.empty()) { std::cerr << "ERROR: points_coordinates vector was empty!\n"; exit(EXIT_FAILURE); };
+
+};
+
+void Point_Cloud::extract_openGL_points_attributes(const std::filesystem::path& path_to_LASer_file, std::vector<vec3>& points_coordinates, std::vector<vec3>& points_colors, const uint8_t& READ_MODE) {
+
+	exit_if_file_doesnt_exist(path_to_LASer_file);
+	if (std::filesystem::is_directory(std::filesystem::path(path_to_LASer_file))) { std::cerr << "ERROR: path is a directory and not a LAS file!\n"; exit(EXIT_FAILURE); };
+
+	auto start = std::chrono::steady_clock::now();
+	switch (READ_MODE) {
+
+		case READ_WITH_STREAM: { this->extract_openGL_points_attributes_from_stream(path_to_LASer_file, points_coordinates, points_colors); break; };
+		case READ_WITH_MEMORY_MAP: { this->extract_openGL_points_attributes_from_memory(path_to_LASer_file, points_coordinates, points_colors, false); break; };
+		case READ_WITH_MEMORY_MAP_MULTITHREADED: { this->extract_openGL_points_attributes_from_memory(path_to_LASer_file, points_coordinates, points_colors, true); break; };
+		default: std::cerr << "ERROR: invalid READ_MODE type!\n"; exit(EXIT_FAILURE);
+
+	};
+	std::chrono::duration<double> elapsed_time = std::chrono::steady_clock::now() - start;
+
+	//load throughput, used to compare the reading modes against each other on the same file
+	double megabytes = std::filesystem::file_size(path_to_LASer_file) / (1024.0 * 1024.0);
 	std::cout << "Header Version: " << this->Public_Header_Block_Version << " Data Format: " << this->Point_Data_Record_Format << "\n";
+	std::cout << "read " << points_coordinates.size() << " points (" << megabytes << " MB) in " << elapsed_time.count() * 1000.0 << " ms, " << megabytes / elapsed_time.count() << " MB/s, "
+		<< points_coordinates.size() / elapsed_time.count() / 1000000.0 << " Mpoints/s using " << (READ_MODE == READ_WITH_STREAM ? "std::ifstream" : READ_MODE == READ_WITH_MEMORY_MAP ? "memory map" : "memory map on " + std::to_string(Thread_Pool::shared().n_threads) + " threads") << "\n";
+
+};
+
+Point_Cloud_Mosaic::Tile_Source::Tile_Source(const std::filesystem::path& path_to_LASer_file) : file(path_to_LASer_file) {
+
+	this->decoder = this->cloud.create_openGL_points_decoder(this->file);
+
+};
+
+Point_Cloud_Mosaic::Point_Cloud_Mosaic(const std::vector<std::filesystem::path>& paths_to_LASer_files) : number_of_points(0) {
+
+	if (paths_to_LASer_files.empty()) { std::cerr << "ERROR: a mosaic needs at least one LAS file!\n"; exit(EXIT_FAILURE); };
+
+	//the shared frame only needs the header bounds, which are read for all tiles before any of them is mapped
+	std::vector<Point_Cloud::Header_Summary> summaries = Point_Cloud::read_header_summaries(paths_to_LASer_files);
+	double minimum_bounds[3] = { DBL_MAX, DBL_MAX, DBL_MAX };
+	double maximum_bounds[3] = { -DBL_MAX, -DBL_MAX, -DBL_MAX };
+	for (const Point_Cloud::Header_Summary& summary : summaries) {
+
+		if (!summary.valid) { std::cerr << "ERROR: cant add " << summary.path << " to the mosaic: " << summary.error << "!\n"; exit(EXIT_FAILURE); };
+		for (int axis = 0; axis < 3; axis++) {
+
+			minimum_bounds[axis] = std::min(minimum_bounds[axis], summary.minimum_bounds[axis]);
+			maximum_bounds[axis] = std::max(maximum_bounds[axis], summary.maximum_bounds[axis]);
+
+		};
+
+	};
+
+	for (const Point_Cloud::Header_Summary& summary : summaries) {
+
+		std::unique_ptr<Tile_Source> source = std::make_unique<Tile_Source>(summary.path);
+		source->cloud.set_openGL_frame(minimum_bounds, maximum_bounds);
+
+		vec3 A = source->cloud.compute_openGL_coordinates(summary.minimum_bounds[0], summary.minimum_bounds[1], summary.minimum_bounds[2]);
+		vec3 B = source->cloud.compute_openGL_coordinates(summary.maximum_bounds[0], summary.maximum_bounds[1], summary.maximum_bounds[2]);
+		source->cloud.set_openGL_origin((summary.minimum_bounds[0] + summary.maximum_bounds[0]) * 0.5, (summary.minimum_bounds[1] + summary.maximum_bounds[1]) * 0.5, (summary.minimum_bounds[2] + summary.maximum_bounds[2]) * 0.5);
+
+		Tile tile = { summary.path, this->number_of_points, source->decoder.number_of_point_records, {}, vec3(std::min(A.x, B.x), std::min(A.y, B.y), std::min(A.z, B.z)), vec3(std::max(A.x, B.x), std::max(A.y, B.y), std::max(A.z, B.z)) };
+		source->cloud.get_openGL_origin(tile.origin);
+		tile.frame = source->cloud.get_geospatial_frame();
+		this->tiles.push_back(tile);
+		this->number_of_points += source->decoder.number_of_point_records;
+		this->sources.push_back(std::move(source));
+
+	};
+
+	std::pair<vec3, vec3> bounds = this->sources.front()->cloud.get_openGL_bounds();
+	this->minimum_bounds = bounds.first;
+	this->maximum_bounds = bounds.second;
+	std::cout << "mosaic of " << this->tiles.size() << " tiles with " << this->number_of_points << " points\n";
+
+};
+
+void Point_Cloud_Mosaic::decode(std::vector<vec3>& positions, std::vector<vec3>& colors, Point_Cloud::Point_Attributes* point_attributes) {
+
+	positions.resize(this->number_of_points);
+	colors.resize(this->number_of_points);
+
+	//one task per decoding chunk of every tile, so small tiles dont leave threads idle while a large one is still being decoded
+	struct Task { size_t tile; uint64_t first_point; uint64_t last_point; };
+	std::vector<Task> tasks;
+	for (size_t i = 0; i < this->sources.size(); i++) {
+
+		const Point_Cloud::Points_Decoder& decoder = this->sources[i]->decoder;
+		for (uint64_t first_point = 0; first_point < decoder.number_of_point_records; first_point += decoder.points_per_chunk) {
+
+			tasks.push_back({ i, first_point, std::min(decoder.number_of_point_records, first_point + decoder.points_per_chunk) });
+
+		};
+
+	};
+
+	//the attributes of every tile are decoded into its own cloud and gathered into *point_attributes* afterwards, the tiles dont all have a GPS time
+	bool has_GPS_times = false;
+	for (std::unique_ptr<Tile_Source>& source : this->sources) {
+
+		source->cloud.point_filter = this->point_filter;
+		source->cloud.extract_point_attributes = point_attributes != nullptr;
+		if (point_attributes) { source->cloud.point_attributes.resize(source->decoder.number_of_point_records, Point_Cloud::has_GPS_time(source->decoder.point_data_record_format)); };
+		has_GPS_times |= Point_Cloud::has_GPS_time(source->decoder.point_data_record_format);
+
+	};
+	if (point_attributes) { point_attributes->resize(this->number_of_points, has_GPS_times); };
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<uint64_t> n_task_kept_points(tasks.size(), 0);
+	Thread_Pool::shared().parallel_for(tasks.size(), 1, [&](const size_t& first, const size_t& last) {
+
+		for (size_t i = first; i < last; i++) {
+
+			const Task& task = tasks[i];
+			const Point_Cloud::Points_Decoder& decoder = this->sources[task.tile]->decoder;
+			const uint64_t offset = this->tiles[task.tile].first_point + task.first_point;
+			n_task_kept_points[i] = decoder.decode(task.first_point, task.last_point, positions.data() + offset, colors.data() + offset);
+			if (point_attributes && decoder.decode_attributes) { decoder.decode_attributes(task.first_point, task.last_point); };
+
+		};
+
+	});
+
+	//every task wrote its kept points at the start of its own range, in task order they only ever move down
+	if (this->point_filter.is_active() || point_attributes) {
+
+		uint64_t n_kept_points = 0;
+		for (size_t i = 0; i < tasks.size(); i++) {
+
+			const Task& task = tasks[i];
+			if (task.first_point == 0) { this->tiles[task.tile].number_of_points = 0; };
+
+			const uint64_t offset = this->tiles[task.tile].first_point + task.first_point;
+			std::memmove(positions.data() + n_kept_points, positions.data() + offset, n_task_kept_points[i] * sizeof(vec3));
+			std::memmove(colors.data() + n_kept_points, colors.data() + offset, n_task_kept_points[i] * sizeof(vec3));
+			if (point_attributes) { point_attributes->copy(this->sources[task.tile]->cloud.point_attributes, task.first_point, n_kept_points, n_task_kept_points[i]); };
+			n_kept_points += n_task_kept_points[i];
+			this->tiles[task.tile].number_of_points += n_task_kept_points[i];
+
+		};
+
+		for (std::unique_ptr<Tile_Source>& source : this->sources) { source->cloud.point_attributes = Point_Cloud::Point_Attributes(); };
+
+		//the original first points are needed until every task has moved, so the ranges of the tiles are only updated now
+		uint64_t first_point = 0;
+		for (Tile& tile : this->tiles) { tile.first_point = first_point; first_point += tile.number_of_points; };
+
+		if (n_kept_points != this->number_of_points) {
+
+			std::cout << "kept " << n_kept_points << " of " << this->number_of_points << " points\n";
+			this->number_of_points = n_kept_points;
+			positions.resize(n_kept_points); positions.shrink_to_fit();
+			colors.resize(n_kept_points); colors.shrink_to_fit();
+			if (point_attributes) { point_attributes->resize(n_kept_points, has_GPS_times); point_attributes->shrink_to_fit(); };
+
+		};
+
+	};
+
+	std::chrono::duration<double> elapsed_time = std::chrono::steady_clock::now() - start;
+	std::cout << "decoded " << this->number_of_points << " points of " << this->tiles.size() << " tiles in " << elapsed_time.count() * 1000.0 << " ms\n";
+
+};
+
+Point_Cloud_Stream::Point_Cloud_Stream(const std::filesystem::path& path_to_LASer_file, const size_t& host_memory_budget) : file(path_to_LASer_file), stop(false) {
+
+	this->decoder = this->cloud.create_openGL_points_decoder(this->file);
+	this->number_of_points = this->decoder.number_of_point_records;
+	if (this->number_of_points == 0) { std::cerr << "ERROR: LAS file " << path_to_LASer_file << " has no points to stream!\n"; exit(EXIT_FAILURE); };
+
+	std::pair<vec3, vec3> bounds = this->cloud.get_openGL_bounds();
+	this->minimum_bounds = bounds.first;
+	this->maximum_bounds = bounds.second;
+
+	//every batch holds a position and a color per point
+	this->points_per_batch = std::max<size_t>(1, host_memory_budget / (N_STREAMING_BATCHES * 2 * sizeof(vec3)));
+	this->points_per_batch = static_cast<size_t>(std::min<uint64_t>(this->points_per_batch, this->number_of_points));
+
+	//batches that start on a chunk boundary never decompress a LAZ chunk twice
+	if (this->points_per_batch > this->decoder.points_per_chunk) { this->points_per_batch -= this->points_per_batch % this->decoder.points_per_chunk; };
+	for (size_t i = 0; i < N_STREAMING_BATCHES; i++) {
+
+		Batch batch;
+		batch.positions.resize(this->points_per_batch);
+		batch.colors.resize(this->points_per_batch);
+		this->free_batches.emplace_back(std::move(batch));
+
+	};
+
+	std::cout << "streaming " << this->number_of_points << " points in batches of " << this->points_per_batch << "\n";
+	this->decoding_thread = std::thread(&Point_Cloud_Stream::decode_batches, this);
+
+};
+
+void Point_Cloud_Stream::decode_batches() {
+
+	uint64_t next_point = 0;
+	while (next_point < this->number_of_points) {
+
+		Batch batch;
+		{
+
+			std::unique_lock<std::mutex> lock(this->mutex);
+			this->batch_recycled.wait(lock, [&]() { return this->stop || !this->free_batches.empty(); });
+			if (this->stop) { return; };
+			batch = std::move(this->free_batches.back());
+			this->free_batches.pop_back();
+
+		};
+
+		batch.first_point = next_point;
+		batch.n_points = static_cast<size_t>(std::min<uint64_t>(this->points_per_batch, this->number_of_points - next_point));
+		Thread_Pool::shared().parallel_for(batch.n_points, this->decoder.points_per_chunk, [&](const size_t& first, const size_t& last) {
+
+			this->decoder.decode(next_point + first, next_point + last, batch.positions.data() + first, batch.colors.data() + first);
+
+		});
+
+		//the raw records of this batch wont be touched again, so their pages dont have to stay resident
+		std::pair<uint64_t, uint64_t> byte_range = this->decoder.get_byte_range(next_point, next_point + batch.n_points);
+		this->file.discard(byte_range.first, byte_range.second);
+		next_point += batch.n_points;
+
+		{
+
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->ready_batches.emplace_back(std::move(batch));
+
+		};
+
+	};
+
+};
+
+bool Point_Cloud_Stream::pop_batch(Batch& batch) {
+
+	std::lock_guard<std::mutex> lock(this->mutex);
+	if (this->ready_batches.empty()) { return false; };
+	batch = std::move(this->ready_batches.front());
+	this->ready_batches.pop_front();
+	return true;
+
+};
+
+void Point_Cloud_Stream::recycle_batch(Batch&& batch) {
+
+	{
+
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->free_batches.emplace_back(std::move(batch));
+
+	};
+	this->batch_recycled.notify_one();
+
+};
+
+Point_Cloud_Stream::~Point_Cloud_Stream() {
+
+	{
+
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->stop = true;
+
+	};
+	this->batch_recycled.notify_one();
+	if (this->decoding_thread.joinable()) { this->decoding_thread.join(); };
 
-};
\ No newline at end of file
+};
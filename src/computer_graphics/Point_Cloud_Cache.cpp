@@ -0,0 +1,193 @@
+#include "computer_graphics/Point_Cloud_Cache.h"
+
+std::filesystem::path Point_Cloud_Cache::get_cache_path(const std::filesystem::path& path_to_LASer_file) {
+
+	std::filesystem::path cache_path = path_to_LASer_file;
+	cache_path += EXTENSION;
+	return cache_path;
+
+};
+
+void Point_Cloud_Cache::identify_source(const std::filesystem::path& path_to_LASer_file, uint64_t& source_size, int64_t& source_modification_time, uint64_t& source_hash) {
+
+	source_size = std::filesystem::file_size(path_to_LASer_file);
+	source_modification_time = static_cast<int64_t>(std::filesystem::last_write_time(path_to_LASer_file).time_since_epoch().count());
+
+	//FNV-1a over the size and both ends of the file, only the pages holding them are read from the mapping
+	Memory_Mapped_File file(path_to_LASer_file);
+	source_hash = 14695981039346656037ull;
+	auto hash_bytes = [&](const char* bytes, const size_t& n_bytes) {
+
+		for (size_t i = 0; i < n_bytes; i++) { source_hash = (source_hash ^ static_cast<uint8_t>(bytes[i])) * 1099511628211ull; };
+
+	};
+	hash_bytes(reinterpret_cast<const char*>(&source_size), sizeof(source_size));
+	if (file.size == 0) { return; };
+
+	const size_t n_hashed_bytes = std::min(HASHED_BYTES, file.size);
+	hash_bytes(file.data, n_hashed_bytes);
+	hash_bytes(file.data + file.size - n_hashed_bytes, n_hashed_bytes);
+
+};
+
+void Point_Cloud_Cache::write(const std::filesystem::path& path_to_LASer_file, const std::vector<vec3>& positions, const std::vector<vec3>& colors, const vec3& minimum_bounds, const vec3& maximum_bounds, const std::vector<Point_Cloud::Extra_Bytes_Column>& extra_bytes_columns, const Point_Cloud::Point_Attributes& point_attributes) {
+
+	if (positions.size() != colors.size()) { std::cerr << "WARNING: cant cache " << path_to_LASer_file << ", it has " << positions.size() << " positions but " << colors.size() << " colors!\n"; return; };
+	const bool has_point_attributes = point_attributes.size() == positions.size() && !positions.empty();
+
+	Cache_Header header = {};
+	std::memcpy(header.signature, "PCCACHE", 8);
+	header.version = VERSION;
+	header.number_of_extra_bytes_columns = static_cast<uint32_t>(extra_bytes_columns.size());
+	header.has_point_attributes = has_point_attributes;
+	header.has_GPS_times = has_point_attributes && point_attributes.GPS_times.size() == positions.size();
+	identify_source(path_to_LASer_file, header.source_size, header.source_modification_time, header.source_hash);
+	header.number_of_points = positions.size();
+	header.minimum_bounds[0] = minimum_bounds.x; header.minimum_bounds[1] = minimum_bounds.y; header.minimum_bounds[2] = minimum_bounds.z;
+	header.maximum_bounds[0] = maximum_bounds.x; header.maximum_bounds[1] = maximum_bounds.y; header.maximum_bounds[2] = maximum_bounds.z;
+
+	const std::filesystem::path cache_path = get_cache_path(path_to_LASer_file);
+	std::filesystem::path temporary_path = cache_path;
+	temporary_path += ".tmp";
+	{
+
+		std::ofstream cache_file(temporary_path, std::ios::binary | std::ios::trunc);
+		if (!cache_file) { std::cerr << "WARNING: cant create the cache " << cache_path << ", the file will be decoded again next time!\n"; return; };
+
+		cache_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		cache_file.write(reinterpret_cast<const char*>(positions.data()), positions.size() * sizeof(vec3));
+		cache_file.write(reinterpret_cast<const char*>(colors.data()), colors.size() * sizeof(vec3));
+		if (header.has_GPS_times) { cache_file.write(reinterpret_cast<const char*>(point_attributes.GPS_times.data()), positions.size() * sizeof(double)); };
+		if (header.has_point_attributes) {
+
+			cache_file.write(reinterpret_cast<const char*>(point_attributes.intensities.data()), positions.size() * sizeof(uint16_t));
+			cache_file.write(reinterpret_cast<const char*>(point_attributes.classifications.data()), positions.size());
+			cache_file.write(reinterpret_cast<const char*>(point_attributes.returns.data()), positions.size());
+
+		};
+		for (const Point_Cloud::Extra_Bytes_Column& column : extra_bytes_columns) {
+
+			Cache_Extra_Bytes_Column cached_column = {};
+			std::memcpy(cached_column.name, column.name.data(), std::min(column.name.size(), sizeof(cached_column.name)));
+			std::memcpy(cached_column.description, column.description.data(), std::min(column.description.size(), sizeof(cached_column.description)));
+			cached_column.data_type = column.data_type;
+			cached_column.options = column.options;
+			cached_column.n_elements = column.n_elements;
+			cached_column.element_size = column.element_size;
+			cached_column.offset_in_record = column.offset_in_record;
+			cached_column.size = column.size;
+			std::memcpy(cached_column.scale, column.scale, sizeof(cached_column.scale));
+			std::memcpy(cached_column.offset, column.offset, sizeof(cached_column.offset));
+
+			//columns whose values werent extracted are cached as descriptors only
+			const uint64_t n_values = column.values.size() == positions.size() * column.size ? column.values.size() : 0;
+			cache_file.write(reinterpret_cast<const char*>(&cached_column), sizeof(cached_column));
+			cache_file.write(reinterpret_cast<const char*>(&n_values), sizeof(n_values));
+			cache_file.write(reinterpret_cast<const char*>(column.values.data()), n_values);
+
+		};
+
+		if (!cache_file) { std::cerr << "WARNING: failed to write the cache " << cache_path << ", the file will be decoded again next time!\n"; cache_file.close(); std::filesystem::remove(temporary_path); return; };
+
+	};
+
+	std::error_code error;
+	std::filesystem::rename(temporary_path, cache_path, error);
+	if (error) { std::cerr << "WARNING: failed to move the cache into " << cache_path << ": " << error.message() << "\n"; std::filesystem::remove(temporary_path, error); return; };
+	std::cout << "cached " << positions.size() << " points into " << cache_path << "\n";
+
+};
+
+std::unique_ptr<Point_Cloud_Cache> Point_Cloud_Cache::open(const std::filesystem::path& path_to_LASer_file) {
+
+	const std::filesystem::path cache_path = get_cache_path(path_to_LASer_file);
+	if (!std::filesystem::is_regular_file(cache_path) || !std::filesystem::is_regular_file(path_to_LASer_file)) { return nullptr; };
+
+	Memory_Mapped_File file(cache_path);
+	Cache_Header header;
+	if (file.size < sizeof(header)) { return nullptr; };
+	std::memcpy(&header, file.data, sizeof(header));
+	if (std::string(header.signature, 8) != std::string("PCCACHE", 8) || header.version != VERSION) { return nullptr; };
+
+	uint64_t source_size; int64_t source_modification_time; uint64_t source_hash;
+	identify_source(path_to_LASer_file, source_size, source_modification_time, source_hash);
+	if (header.source_size != source_size || header.source_modification_time != source_modification_time || header.source_hash != source_hash) { std::cout << "cache " << cache_path << " is out of date\n"; return nullptr; };
+
+	const uint64_t vertex_data_size = 2 * header.number_of_points * sizeof(vec3);
+	const uint64_t point_attributes_size = header.number_of_points * ((header.has_GPS_times ? sizeof(double) : 0) + (header.has_point_attributes ? sizeof(uint16_t) + 2 * sizeof(uint8_t) : 0));
+	if (vertex_data_size + point_attributes_size > file.size - sizeof(header)) { std::cerr << "WARNING: cache " << cache_path << " is truncated, ignoring it!\n"; return nullptr; };
+
+	std::unique_ptr<Point_Cloud_Cache> cache(new Point_Cloud_Cache(std::move(file)));
+	cache->number_of_points = header.number_of_points;
+	cache->minimum_bounds = vec3(header.minimum_bounds[0], header.minimum_bounds[1], header.minimum_bounds[2]);
+	cache->maximum_bounds = vec3(header.maximum_bounds[0], header.maximum_bounds[1], header.maximum_bounds[2]);
+	cache->positions = reinterpret_cast<const vec3*>(cache->file.data + sizeof(header));
+	cache->colors = cache->positions + header.number_of_points;
+
+	uint64_t offset = sizeof(header) + vertex_data_size;
+	if (header.has_GPS_times) { cache->GPS_times = reinterpret_cast<const double*>(cache->file.data + offset); offset += header.number_of_points * sizeof(double); };
+	if (header.has_point_attributes) {
+
+		cache->intensities = reinterpret_cast<const uint16_t*>(cache->file.data + offset); offset += header.number_of_points * sizeof(uint16_t);
+		cache->classifications = reinterpret_cast<const uint8_t*>(cache->file.data + offset); offset += header.number_of_points;
+		cache->returns = reinterpret_cast<const uint8_t*>(cache->file.data + offset); offset += header.number_of_points;
+
+	};
+	for (uint32_t i = 0; i < header.number_of_extra_bytes_columns; i++) {
+
+		Cache_Extra_Bytes_Column cached_column;
+		uint64_t n_values;
+		if (sizeof(cached_column) + sizeof(n_values) > cache->file.size - offset) { std::cerr << "WARNING: cache " << cache_path << " is truncated, ignoring it!\n"; return nullptr; };
+		std::memcpy(&cached_column, cache->file.data + offset, sizeof(cached_column));
+		std::memcpy(&n_values, cache->file.data + offset + sizeof(cached_column), sizeof(n_values));
+		offset += sizeof(cached_column) + sizeof(n_values);
+		if (n_values > cache->file.size - offset) { std::cerr << "WARNING: cache " << cache_path << " is truncated, ignoring it!\n"; return nullptr; };
+
+		Point_Cloud::Extra_Bytes_Column column;
+		column.name = std::string(cached_column.name, strnlen(cached_column.name, sizeof(cached_column.name)));
+		column.description = std::string(cached_column.description, strnlen(cached_column.description, sizeof(cached_column.description)));
+		column.data_type = cached_column.data_type;
+		column.options = cached_column.options;
+		column.n_elements = cached_column.n_elements;
+		column.element_size = cached_column.element_size;
+		column.offset_in_record = cached_column.offset_in_record;
+		column.size = cached_column.size;
+		std::memcpy(column.scale, cached_column.scale, sizeof(column.scale));
+		std::memcpy(column.offset, cached_column.offset, sizeof(column.offset));
+		column.values.assign(cache->file.data + offset, cache->file.data + offset + n_values);
+		offset += n_values;
+
+		cache->extra_bytes_columns.push_back(std::move(column));
+
+	};
+
+	return cache;
+
+};
+
+const char* Point_Cloud_Cache::get_vertex_data() const {
+
+	return reinterpret_cast<const char*>(this->positions);
+
+};
+
+size_t Point_Cloud_Cache::get_vertex_data_size() const {
+
+	return 2 * this->number_of_points * sizeof(vec3);
+
+};
+
+Point_Cloud::Point_Attributes Point_Cloud_Cache::get_point_attributes() const {
+
+	Point_Cloud::Point_Attributes point_attributes;
+	if (!this->has_point_attributes()) { return point_attributes; };
+
+	point_attributes.intensities.assign(this->intensities, this->intensities + this->number_of_points);
+	point_attributes.classifications.assign(this->classifications, this->classifications + this->number_of_points);
+	point_attributes.returns.assign(this->returns, this->returns + this->number_of_points);
+	if (this->GPS_times) { point_attributes.GPS_times.assign(this->GPS_times, this->GPS_times + this->number_of_points); };
+	return point_attributes;
+
+};
+
+Point_Cloud_Cache::Point_Cloud_Cache(Memory_Mapped_File&& file) : number_of_points(0), positions(nullptr), colors(nullptr), GPS_times(nullptr), intensities(nullptr), classifications(nullptr), returns(nullptr), file(std::move(file)) {};
@@ -205,6 +205,16 @@ void Shader::default_uniforms_maps_initialization(const vec2& screen_size) {
 	this->bool_uniforms_map["displacement_mapping"] = false;
 	this->bool_uniforms_map["height_coloring"] = false;
 
+	//coloring LAS points by their attributes, *color_mode* picks RGB, intensity, classification, return or GPS time
+	this->int_uniforms_map["color_mode"] = 0;
+	this->bool_uniforms_map["point_attributes"] = false;
+	this->float_uniforms_map["intensity_scale"] = 1.0f;
+	this->float_uniforms_map["GPS_time_range"] = 1.0f;
+
+	//points are only lit when asked to and when their normals were uploaded
+	this->bool_uniforms_map["point_lighting"] = false;
+	this->bool_uniforms_map["point_normals"] = false;
+
 	//camera vectors
 	this->vec3_uniforms_map["forward_vector"] = vec3(0.0f, 0.0f, 1.0f);
 	this->vec3_uniforms_map["up_vector"] = vec3(0.0f, 1.0f, 0.0f);
@@ -329,13 +339,147 @@ void Shader::update_texture(unsigned int* texture_ID, const unsigned int& GL_TEX
 
 void Shader::bind_mesh_buffers_and_textures(Mesh& mesh, const vec2& screen_size, const unsigned int& GL_DRAW_TYPE, const bool& gamma_correction) {
 
+	//only the branches that have point attributes or normals upload them, every other mesh is drawn with its colors, unlit
+	if (mesh.generate_buffers_and_textures) { this->bool_uniforms_map["point_attributes"] = false; this->bool_uniforms_map["point_normals"] = false; };
+
+	//every octree node has buffers of its own, created once the node is first drawn in *update_octree_buffers*
+	if (mesh.octree) {
+
+		mesh.generate_buffers_and_textures = false;
+		return;
+
+	};
+
+	//a cached point cloud is uploaded straight from the mapping of its cache, where the colors follow the positions, as a single buffer
+	if (mesh.point_cloud_cache) {
+
+		if (mesh.generate_buffers_and_textures && mesh.keep_point_attributes && mesh.point_cloud_cache->has_point_attributes()) {
+
+			this->upload_point_attributes(true, mesh.point_cloud_cache->intensities, mesh.point_cloud_cache->classifications, mesh.point_cloud_cache->returns, mesh.point_cloud_cache->GPS_times, mesh.point_cloud_cache->number_of_points, GL_DRAW_TYPE);
+
+		};
+		if (mesh.generate_buffers_and_textures && mesh.normals.size() == mesh.point_cloud_cache->number_of_points) {
+
+			this->bind_array_buffer(true, &this->normals_buffer, mesh.normals, GL_DRAW_TYPE, 1, 3);
+			this->bool_uniforms_map["point_normals"] = true;
+
+		};
+		if (mesh.generate_buffers_and_textures && mesh.quantized_points) {
+
+			glGenBuffers(1, &this->positions_buffer);
+			glBindBuffer(GL_ARRAY_BUFFER, this->positions_buffer);
+			this->upload_quantized_points(mesh.point_cloud_cache->positions, mesh.point_cloud_cache->colors, mesh.point_cloud_cache->number_of_points, mesh.minimum_bounds, mesh.maximum_bounds - mesh.minimum_bounds, GL_DRAW_TYPE);
+			mesh.generate_buffers_and_textures = false;
+
+		}
+		else if (mesh.generate_buffers_and_textures) {
+
+			glGenBuffers(1, &this->positions_buffer);
+			glBindBuffer(GL_ARRAY_BUFFER, this->positions_buffer);
+			glBufferData(GL_ARRAY_BUFFER, mesh.point_cloud_cache->get_vertex_data_size(), mesh.point_cloud_cache->get_vertex_data(), GL_DRAW_TYPE);
+			glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(vec3), (void*)0);
+			glEnableVertexAttribArray(0);
+			glVertexAttribPointer(5, 3, GL_FLOAT, GL_FALSE, sizeof(vec3), (void*)(mesh.point_cloud_cache->number_of_points * sizeof(vec3)));
+			glEnableVertexAttribArray(5);
+			mesh.generate_buffers_and_textures = false;
+
+		};
+
+		return;
+
+	};
+
+	//a streamed point cloud only has positions and colors, their buffers are sized for the whole file once and then filled batch by batch in *stream_mesh_buffers*
+	if (mesh.streamed) {
+
+		if (mesh.generate_buffers_and_textures && mesh.point_cloud_stream && mesh.quantized_points) {
+
+			glGenBuffers(1, &this->positions_buffer);
+			glBindBuffer(GL_ARRAY_BUFFER, this->positions_buffer);
+			glBufferData(GL_ARRAY_BUFFER, mesh.point_cloud_stream->number_of_points * sizeof(Quantized_Point), NULL, GL_DRAW_TYPE);
+			this->set_quantized_points_attributes();
+			mesh.n_streamed_vertices = 0;
+			mesh.generate_buffers_and_textures = false;
+
+		}
+		else if (mesh.generate_buffers_and_textures && mesh.point_cloud_stream) {
+
+			this->allocate_array_buffer(true, &this->positions_buffer, mesh.point_cloud_stream->number_of_points * sizeof(vec3), GL_DRAW_TYPE, 0, 3);
+			this->allocate_array_buffer(true, &this->colors_buffer, mesh.point_cloud_stream->number_of_points * sizeof(vec3), GL_DRAW_TYPE, 5, 3);
+			mesh.n_streamed_vertices = 0;
+			mesh.generate_buffers_and_textures = false;
+
+		};
+
+		return;
+
+	};
+
+	//a point cloud in memory, tiles are quantized inside their own boxes and their positions are relative to their origins
+	if (mesh.quantized_points && !mesh.colors.empty()) {
+
+		if (mesh.generate_buffers_and_textures) {
+
+			if (mesh.point_attributes.size() == mesh.positions.size() && !mesh.point_attributes.empty()) { this->upload_point_attributes(true, mesh.point_attributes.intensities.data(), mesh.point_attributes.classifications.data(), mesh.point_attributes.returns.data(), mesh.point_attributes.GPS_times.empty() ? nullptr : mesh.point_attributes.GPS_times.data(), mesh.positions.size(), GL_DRAW_TYPE); };
+			if (mesh.normals.size() == mesh.positions.size()) {
+
+				this->bind_array_buffer(true, &this->normals_buffer, mesh.normals, GL_DRAW_TYPE, 1, 3);
+				this->bool_uniforms_map["point_normals"] = true;
+
+			};
+
+			glGenBuffers(1, &this->positions_buffer);
+			glBindBuffer(GL_ARRAY_BUFFER, this->positions_buffer);
+			if (mesh.point_cloud_tiles.empty()) { this->upload_quantized_points(mesh.positions.data(), mesh.colors.data(), mesh.positions.size(), mesh.minimum_bounds, mesh.maximum_bounds - mesh.minimum_bounds, GL_DRAW_TYPE); }
+			else {
+
+				glBufferData(GL_ARRAY_BUFFER, mesh.positions.size() * sizeof(Quantized_Point), NULL, GL_DRAW_TYPE);
+				std::vector<Quantized_Point> quantized_points;
+				for (const Point_Cloud_Mosaic::Tile& tile : mesh.point_cloud_tiles) {
+
+					const vec3 origin(tile.origin[0], tile.origin[1], tile.origin[2]);
+					quantized_points.resize(tile.number_of_points);
+					Quantized_Point::quantize(mesh.positions.data() + tile.first_point, mesh.colors.data() + tile.first_point, tile.number_of_points, tile.minimum_bounds - origin, tile.maximum_bounds - tile.minimum_bounds, quantized_points.data());
+					glBufferSubData(GL_ARRAY_BUFFER, tile.first_point * sizeof(Quantized_Point), tile.number_of_points * sizeof(Quantized_Point), quantized_points.data());
+
+				};
+				this->set_quantized_points_attributes();
+
+			};
+			mesh.generate_buffers_and_textures = false;
+
+		};
+
+		return;
+
+	};
+
 	this->bind_array_buffer(mesh.generate_buffers_and_textures, &this->positions_buffer, mesh.positions, GL_DRAW_TYPE, 0, 3);
-	if (!mesh.indices.empty()) { this->bind_index_buffer(mesh.generate_buffers_and_textures, &this->indices_buffer, mesh.indices, GL_DRAW_TYPE); };
+	if (!mesh.indices.empty()) {
+
+		//16 bit indices halve the index buffer and what every draw reads from it, whenever every vertex can be addressed with them
+		if (mesh.positions.size() <= size_t(UINT16_MAX) + 1) {
+
+			const std::vector<uint16_t> short_indices(mesh.indices.begin(), mesh.indices.end());
+			this->bind_index_buffer(mesh.generate_buffers_and_textures, &this->indices_buffer, short_indices, GL_DRAW_TYPE);
+			this->indices_type = GL_UNSIGNED_SHORT;
+
+		}
+		else {
+
+			this->bind_index_buffer(mesh.generate_buffers_and_textures, &this->indices_buffer, mesh.indices, GL_DRAW_TYPE);
+			this->indices_type = GL_UNSIGNED_INT;
+
+		};
+
+	};
 	if (!mesh.normals.empty()) { this->bind_array_buffer(mesh.generate_buffers_and_textures, &this->normals_buffer, mesh.normals, GL_DRAW_TYPE, 1, 3); };
+	if (mesh.generate_buffers_and_textures && mesh.normals.size() == mesh.positions.size() && !mesh.normals.empty()) { this->bool_uniforms_map["point_normals"] = true; };
 	if (!mesh.tangents.empty()) { this->bind_array_buffer(mesh.generate_buffers_and_textures, &this->tangents_buffer, mesh.tangents, GL_DRAW_TYPE, 2, 3); };
 	if (!mesh.bitangents.empty()) { this->bind_array_buffer(mesh.generate_buffers_and_textures, &this->bitangents_buffer, mesh.bitangents, GL_DRAW_TYPE, 3, 3); };
 	if (!mesh.texture_coordinates.empty()) { this->bind_array_buffer(mesh.generate_buffers_and_textures, &this->texture_coordinates_buffer, mesh.texture_coordinates, GL_DRAW_TYPE, 4, 2); };
 	if (!mesh.colors.empty()) { this->bind_array_buffer(mesh.generate_buffers_and_textures, &this->colors_buffer, mesh.colors, GL_DRAW_TYPE, 5, 3); };
+	if (mesh.point_attributes.size() == mesh.positions.size() && !mesh.point_attributes.empty()) { this->upload_point_attributes(mesh.generate_buffers_and_textures, mesh.point_attributes.intensities.data(), mesh.point_attributes.classifications.data(), mesh.point_attributes.returns.data(), mesh.point_attributes.GPS_times.empty() ? nullptr : mesh.point_attributes.GPS_times.data(), mesh.positions.size(), GL_DRAW_TYPE); };
 
 	if (mesh.diffuse_map.bytes != NULL) {
 
@@ -358,11 +502,322 @@ void Shader::bind_mesh_buffers_and_textures(Mesh& mesh, const vec2& screen_size,
 
 };
 
+//appends the batches the stream decoded since the last frame into the pre-sized buffers. Once the whole file arrived the stream is released together with its host memory
+void Shader::stream_mesh_buffers(Mesh& mesh) {
+
+	if (!mesh.streamed || !mesh.point_cloud_stream || mesh.generate_buffers_and_textures) { return; };
+
+	Point_Cloud_Stream::Batch batch;
+	std::vector<Quantized_Point> quantized_points;
+	while (mesh.point_cloud_stream->pop_batch(batch)) {
+
+		if (mesh.quantized_points) {
+
+			quantized_points.resize(batch.n_points);
+			Quantized_Point::quantize(batch.positions.data(), batch.colors.data(), batch.n_points, mesh.minimum_bounds, mesh.maximum_bounds - mesh.minimum_bounds, quantized_points.data());
+			glBindBuffer(GL_ARRAY_BUFFER, this->positions_buffer);
+			glBufferSubData(GL_ARRAY_BUFFER, batch.first_point * sizeof(Quantized_Point), batch.n_points * sizeof(Quantized_Point), quantized_points.data());
+
+		}
+		else {
+
+			glBindBuffer(GL_ARRAY_BUFFER, this->positions_buffer);
+			glBufferSubData(GL_ARRAY_BUFFER, batch.first_point * sizeof(vec3), batch.n_points * sizeof(vec3), batch.positions.data());
+			glBindBuffer(GL_ARRAY_BUFFER, this->colors_buffer);
+			glBufferSubData(GL_ARRAY_BUFFER, batch.first_point * sizeof(vec3), batch.n_points * sizeof(vec3), batch.colors.data());
+
+		};
+
+		mesh.n_streamed_vertices = batch.first_point + batch.n_points;
+		mesh.point_cloud_stream->recycle_batch(std::move(batch));
+
+	};
+
+	if (mesh.n_streamed_vertices == mesh.point_cloud_stream->number_of_points) {
+
+		std::cout << "finished streaming " << mesh.n_streamed_vertices << " points\n";
+		mesh.point_cloud_stream.reset();
+
+	};
+
+};
+
+mat4 Shader::compute_model_view_projection_matrix() {
+
+	mat4 model_transformation_matrix = create_model_transformation_matrix(this->vec3_uniforms_map["model_translation_vector"], this->vec3_uniforms_map["model_scaling_vector"], this->vec3_uniforms_map["model_rotation_vector"]);
+
+	vec4 forward = create_rotation_matrix(this->vec3_uniforms_map["camera_rotation_vector"]) * vec4(this->vec3_uniforms_map["forward_vector"], 0.0f);
+	const vec3& camera_position = this->vec3_uniforms_map["camera_position"];
+	mat4 view_matrix = create_view_matrix(camera_position, camera_position + vec3(forward.x, forward.y, forward.z), this->vec3_uniforms_map["up_vector"]);
+
+	mat4 projection_matrix = this->bool_uniforms_map["orthogonal_projection"] ?
+		create_orthographic_projection_matrix(this->vec2_uniforms_map["screen_size"], 0.1f, 50000.0f, this->float_uniforms_map["orthogonal_size"]) :
+		create_frustum_projection_matrix(this->float_uniforms_map["FOV"], this->vec2_uniforms_map["screen_size"], 0.1f, 50000.0f);
+
+	return create_model_view_projection_matrix(model_transformation_matrix, view_matrix, projection_matrix);
+
+};
+
+void Shader::upload_camera_relative_origin(const double origin[3]) {
+
+	const vec3& translation = this->vec3_uniforms_map["model_translation_vector"];
+	const vec3& camera_position = this->vec3_uniforms_map["camera_position"];
+	mat4 rotation_scale = create_rotation_matrix(this->vec3_uniforms_map["model_rotation_vector"]) * create_scale_matrix(this->vec3_uniforms_map["model_scaling_vector"]);
+
+	const double relative_origin[3] = {
+
+		static_cast<double>(translation.x) - camera_position.x + rotation_scale.a11 * origin[0] + rotation_scale.a12 * origin[1] + rotation_scale.a13 * origin[2],
+		static_cast<double>(translation.y) - camera_position.y + rotation_scale.a21 * origin[0] + rotation_scale.a22 * origin[1] + rotation_scale.a23 * origin[2],
+		static_cast<double>(translation.z) - camera_position.z + rotation_scale.a31 * origin[0] + rotation_scale.a32 * origin[1] + rotation_scale.a33 * origin[2]
+
+	};
+	this->create_uniform_vec3({ static_cast<float>(relative_origin[0]), static_cast<float>(relative_origin[1]), static_cast<float>(relative_origin[2]) }, "origin_relative_to_camera");
+	this->create_uniform_vec3({ static_cast<float>(origin[0]), static_cast<float>(origin[1]), static_cast<float>(origin[2]) }, "origin");
+
+};
+
+void Shader::upload_quantization_box(const vec3& box_minimum, const vec3& box_size) {
+
+	this->create_uniform_vec3(box_minimum.to_GL(), "quantization_box_minimum");
+	this->create_uniform_vec3(box_size.to_GL(), "quantization_box_size");
+
+};
+
+void Shader::upload_quantized_points(const vec3* positions, const vec3* colors, const size_t& n_points, const vec3& box_minimum, const vec3& box_size, const unsigned int& GL_DRAW_TYPE) {
+
+	std::vector<Quantized_Point> quantized_points(n_points);
+	Quantized_Point::quantize(positions, colors, n_points, box_minimum, box_size, quantized_points.data());
+	glBufferData(GL_ARRAY_BUFFER, n_points * sizeof(Quantized_Point), quantized_points.data(), GL_DRAW_TYPE);
+	set_quantized_points_attributes();
+
+};
+
+void Shader::set_quantized_points_attributes() {
+
+	glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(Quantized_Point), (void*)offsetof(Quantized_Point, x));
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(5, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Quantized_Point), (void*)offsetof(Quantized_Point, red));
+	glEnableVertexAttribArray(5);
+
+};
+
+void Shader::upload_point_attributes(const bool& generate_buffers, const uint16_t* intensities, const uint8_t* classifications, const uint8_t* returns, const double* GPS_times, const size_t& n_points, const unsigned int& GL_DRAW_TYPE) {
+
+	if (intensities == nullptr || n_points == 0) {
+
+		for (int attribute = 6; attribute <= 9; attribute++) { glDisableVertexAttribArray(attribute); };
+		this->bool_uniforms_map["point_attributes"] = false;
+		return;
+
+	};
+
+	if (generate_buffers) { glGenBuffers(1, &this->intensities_buffer); };
+	glBindBuffer(GL_ARRAY_BUFFER, this->intensities_buffer);
+	glBufferData(GL_ARRAY_BUFFER, n_points * sizeof(uint16_t), intensities, GL_DRAW_TYPE);
+	glVertexAttribPointer(6, 1, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(uint16_t), (void*)0);
+	glEnableVertexAttribArray(6);
+
+	if (generate_buffers) { glGenBuffers(1, &this->classifications_buffer); };
+	glBindBuffer(GL_ARRAY_BUFFER, this->classifications_buffer);
+	glBufferData(GL_ARRAY_BUFFER, n_points, classifications, GL_DRAW_TYPE);
+	glVertexAttribIPointer(7, 1, GL_UNSIGNED_BYTE, sizeof(uint8_t), (void*)0);
+	glEnableVertexAttribArray(7);
+
+	if (generate_buffers) { glGenBuffers(1, &this->returns_buffer); };
+	glBindBuffer(GL_ARRAY_BUFFER, this->returns_buffer);
+	glBufferData(GL_ARRAY_BUFFER, n_points, returns, GL_DRAW_TYPE);
+	glVertexAttribIPointer(8, 1, GL_UNSIGNED_BYTE, sizeof(uint8_t), (void*)0);
+	glEnableVertexAttribArray(8);
+
+	//most files only use the low bits of the intensity, so the brightest point is stretched to white
+	const uint16_t maximum_intensity = *std::max_element(intensities, intensities + n_points);
+	this->float_uniforms_map["intensity_scale"] = maximum_intensity > 0 ? float(UINT16_MAX) / float(maximum_intensity) : 1.0f;
+
+	if (GPS_times) {
+
+		std::pair<const double*, const double*> GPS_time_bounds = std::minmax_element(GPS_times, GPS_times + n_points);
+		const double earliest_GPS_time = *GPS_time_bounds.first;
+		std::vector<float> relative_GPS_times(n_points);
+		for (size_t i = 0; i < n_points; i++) { relative_GPS_times[i] = float(GPS_times[i] - earliest_GPS_time); };
+
+		if (generate_buffers) { glGenBuffers(1, &this->GPS_times_buffer); };
+		glBindBuffer(GL_ARRAY_BUFFER, this->GPS_times_buffer);
+		glBufferData(GL_ARRAY_BUFFER, n_points * sizeof(float), relative_GPS_times.data(), GL_DRAW_TYPE);
+		glVertexAttribPointer(9, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)0);
+		glEnableVertexAttribArray(9);
+		this->float_uniforms_map["GPS_time_range"] = std::max(float(*GPS_time_bounds.second - earliest_GPS_time), 1e-6f);
+
+	}
+	else {
+
+		//formats without GPS time read a constant 0
+		glDisableVertexAttribArray(9);
+		glVertexAttrib1f(9, 0.0f);
+		this->float_uniforms_map["GPS_time_range"] = 1.0f;
+
+	};
+
+	this->bool_uniforms_map["point_attributes"] = true;
+
+};
+
+//picks the octree nodes to draw for the current camera and uploads the ones that arent on the GPU yet, most important first, until *MAX_OCTREE_POINTS_UPLOADED_PER_FRAME* is reached.
+//Nodes whose upload has to wait are left out of *drawn_octree_nodes* for this frame, which keeps the frame time bounded no matter how big the cloud is
+void Shader::update_octree_buffers(Mesh& mesh) {
+
+	if (!mesh.octree) { return; };
+	if (this->buffered_octree != mesh.octree.get()) {
+
+		this->delete_octree_node_buffers();
+		this->buffered_octree = mesh.octree.get();
+
+	};
+	this->octree_frame++;
+
+	const vec3& scale = this->vec3_uniforms_map["model_scaling_vector"];
+	Octree::View view;
+	view.model_view_projection = this->compute_model_view_projection_matrix();
+	view.model_scale = std::max({ std::abs(scale.x), std::abs(scale.y), std::abs(scale.z) });
+	view.perspective = !this->bool_uniforms_map["orthogonal_projection"];
+	view.projection_scale = view.perspective ? 1.0f / std::tan(to_radians(this->float_uniforms_map["FOV"]) / 2.0f) : 1.0f / this->float_uniforms_map["orthogonal_size"];
+	view.screen_height = this->vec2_uniforms_map["screen_size"].y;
+
+	const uint64_t point_budget = std::max<uint64_t>(this->octree_point_budget, 1);
+	std::vector<uint32_t> selected_nodes = mesh.octree->select_nodes(view, point_budget, this->octree_max_screen_space_error);
+
+	mesh.drawn_octree_nodes.clear();
+	uint64_t n_uploaded_points = 0;
+	for (const uint32_t& index : selected_nodes) {
+
+		const Octree::Node& node = mesh.octree->nodes[index];
+		if (node.n_points == 0) { continue; };
+
+		auto buffers = this->octree_node_buffers.find(index);
+		if (buffers == this->octree_node_buffers.end()) {
+
+			if (n_uploaded_points + node.n_points > MAX_OCTREE_POINTS_UPLOADED_PER_FRAME && n_uploaded_points > 0) { continue; };
+
+			Octree_Node_Buffers node_buffers = { 0, 0, node.n_points, 0, mesh.quantized_points };
+			glGenBuffers(1, &node_buffers.positions_buffer);
+			glBindBuffer(GL_ARRAY_BUFFER, node_buffers.positions_buffer);
+			if (node_buffers.quantized) { this->upload_quantized_points(mesh.octree->get_positions(node), mesh.octree->get_colors(node), node.n_points, node.minimum_bounds, node.maximum_bounds - node.minimum_bounds, GL_STATIC_DRAW); }
+			else {
+
+				glBufferData(GL_ARRAY_BUFFER, node.n_points * sizeof(vec3), mesh.octree->get_positions(node), GL_STATIC_DRAW);
+				glGenBuffers(1, &node_buffers.colors_buffer);
+				glBindBuffer(GL_ARRAY_BUFFER, node_buffers.colors_buffer);
+				glBufferData(GL_ARRAY_BUFFER, node.n_points * sizeof(vec3), mesh.octree->get_colors(node), GL_STATIC_DRAW);
+
+			};
+
+			buffers = this->octree_node_buffers.emplace(index, node_buffers).first;
+			n_uploaded_points += node.n_points;
+			this->n_resident_octree_points += node.n_points;
+
+		};
+
+		buffers->second.last_drawn_frame = this->octree_frame;
+		mesh.drawn_octree_nodes.push_back(index);
+
+	};
+
+	if (this->n_resident_octree_points <= 2 * point_budget) { return; };
+
+	std::vector<std::pair<uint64_t, uint32_t>> evictable_nodes;
+	for (const auto& [index, node_buffers] : this->octree_node_buffers) {
+
+		if (node_buffers.last_drawn_frame != this->octree_frame) { evictable_nodes.push_back({ node_buffers.last_drawn_frame, index }); };
+
+	};
+	std::sort(evictable_nodes.begin(), evictable_nodes.end());
+	for (size_t i = 0; i < evictable_nodes.size() && this->n_resident_octree_points > 2 * point_budget; i++) {
+
+		Octree_Node_Buffers& node_buffers = this->octree_node_buffers[evictable_nodes[i].second];
+		glDeleteBuffers(1, &node_buffers.positions_buffer);
+		glDeleteBuffers(1, &node_buffers.colors_buffer);
+		this->n_resident_octree_points -= node_buffers.n_points;
+		this->octree_node_buffers.erase(evictable_nodes[i].second);
+
+	};
+
+};
+
+void Shader::delete_octree_node_buffers() {
+
+	for (auto& [index, node_buffers] : this->octree_node_buffers) {
+
+		glDeleteBuffers(1, &node_buffers.positions_buffer);
+		glDeleteBuffers(1, &node_buffers.colors_buffer);
+
+	};
+	this->octree_node_buffers.clear();
+	this->n_resident_octree_points = 0;
+	this->buffered_octree = nullptr;
+
+};
+
 void Shader::draw_mesh_elements(Mesh& mesh, const unsigned int& GL_PRIMITIVE_TYPE) {
 
-	if (mesh.draw_as_elements) {
+	const double no_origin[3] = { 0.0, 0.0, 0.0 };
+	this->upload_camera_relative_origin(no_origin);
+	if (mesh.quantized_points) { this->upload_quantization_box(mesh.minimum_bounds, mesh.maximum_bounds - mesh.minimum_bounds); }
+	else { this->upload_quantization_box(vec3(0.0f, 0.0f, 0.0f), vec3(1.0f, 1.0f, 1.0f)); };
+
+	if (!mesh.point_cloud_tiles.empty()) {
 
-		glDrawElements(GL_PRIMITIVE_TYPE, mesh.indices.size(), GL_UNSIGNED_INT, 0);
+		//every tile is relative to its own origin and quantized inside its own box, so each one is drawn on its own
+		for (const Point_Cloud_Mosaic::Tile& tile : mesh.point_cloud_tiles) {
+
+			const vec3 origin(tile.origin[0], tile.origin[1], tile.origin[2]);
+			this->upload_camera_relative_origin(tile.origin);
+			if (mesh.quantized_points) { this->upload_quantization_box(tile.minimum_bounds - origin, tile.maximum_bounds - tile.minimum_bounds); };
+			glDrawArrays(GL_PRIMITIVE_TYPE, tile.first_point, tile.number_of_points);
+
+		};
+
+	}
+	else if (mesh.octree) {
+
+		//one draw call per node, pointing the attributes at the buffers of the node
+		for (const uint32_t& index : mesh.drawn_octree_nodes) {
+
+			const Octree_Node_Buffers& node_buffers = this->octree_node_buffers[index];
+			glBindBuffer(GL_ARRAY_BUFFER, node_buffers.positions_buffer);
+			if (node_buffers.quantized) {
+
+				const Octree::Node& node = mesh.octree->nodes[index];
+				this->set_quantized_points_attributes();
+				this->upload_quantization_box(node.minimum_bounds, node.maximum_bounds - node.minimum_bounds);
+
+			}
+			else {
+
+				glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(vec3), (void*)0);
+				glEnableVertexAttribArray(0);
+				glBindBuffer(GL_ARRAY_BUFFER, node_buffers.colors_buffer);
+				glVertexAttribPointer(5, 3, GL_FLOAT, GL_FALSE, sizeof(vec3), (void*)0);
+				glEnableVertexAttribArray(5);
+				this->upload_quantization_box(vec3(0.0f, 0.0f, 0.0f), vec3(1.0f, 1.0f, 1.0f));
+
+			};
+			glDrawArrays(GL_PRIMITIVE_TYPE, 0, node_buffers.n_points);
+
+		};
+
+	}
+	else if (mesh.point_cloud_cache) {
+
+		glDrawArrays(GL_PRIMITIVE_TYPE, 0, mesh.point_cloud_cache->number_of_points);
+
+	}
+	else if (mesh.streamed) {
+
+		glDrawArrays(GL_PRIMITIVE_TYPE, 0, mesh.n_streamed_vertices);
+
+	}
+	else if (mesh.draw_as_elements) {
+
+		glDrawElements(GL_PRIMITIVE_TYPE, mesh.indices.size(), this->indices_type, 0);
 
 	}
 	else {
@@ -382,6 +837,8 @@ void Shader::bind_and_draw_mesh_elements(Mesh& mesh, const vec2& screen_size, co
 
 void Shader::delete_buffers() {
 
+	this->delete_octree_node_buffers();
+
 	glDeleteBuffers(1, &this->positions_buffer);
 	glDeleteBuffers(1, &this->normals_buffer);
 	glDeleteBuffers(1, &this->indices_buffer);
@@ -389,6 +846,10 @@ void Shader::delete_buffers() {
 	glDeleteBuffers(1, &this->colors_buffer);
 	glDeleteBuffers(1, &this->tangents_buffer);
 	glDeleteBuffers(1, &this->bitangents_buffer);
+	glDeleteBuffers(1, &this->intensities_buffer);
+	glDeleteBuffers(1, &this->classifications_buffer);
+	glDeleteBuffers(1, &this->returns_buffer);
+	glDeleteBuffers(1, &this->GPS_times_buffer);
 
 	glDeleteFramebuffers(1, &this->frame_buffer);
 	glDeleteTextures(1, &this->frame_buffer_colors_texture_ID);
@@ -0,0 +1,137 @@
+#include "computer_graphics/Thread_Pool.h"
+
+//set inside the worker threads, so that a nested *parallel_for* falls back to a serial loop instead of waiting on itself
+static thread_local bool inside_worker = false;
+
+void Thread_Pool::run_chunks() {
+
+	size_t chunk;
+	while ((chunk = this->next_chunk.fetch_add(1, std::memory_order_relaxed)) < this->job_n_chunks) {
+
+		size_t first = chunk * this->job_chunk_size;
+		size_t last = std::min(first + this->job_chunk_size, this->job_n_elements);
+		(*this->job)(first, last);
+
+	};
+
+};
+
+void Thread_Pool::worker_loop() {
+
+	inside_worker = true;
+	uint64_t seen_generation = 0;
+	while (true) {
+
+		{
+
+			std::unique_lock<std::mutex> lock(this->mutex);
+			this->job_available.wait(lock, [&]() { return this->stop || this->generation != seen_generation; });
+			if (this->stop) { return; };
+			seen_generation = this->generation;
+
+		};
+
+		this->run_chunks();
+
+		{
+
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->n_finished_workers++;
+			if (this->n_finished_workers == this->workers.size()) { this->job_finished.notify_one(); };
+
+		};
+
+	};
+
+};
+
+void Thread_Pool::parallel_for(const size_t& n_elements, const size_t& chunk_size, const std::function<void(const size_t& first, const size_t& last)>& function) {
+
+	if (n_elements == 0) { return; };
+	if (chunk_size == 0) { std::cerr << "ERROR: parallel_for chunk size cant be 0!\n"; exit(EXIT_FAILURE); };
+
+	size_t n_chunks = (n_elements + chunk_size - 1) / chunk_size;
+	if (this->workers.empty() || n_chunks == 1 || inside_worker || !this->submit_mutex.try_lock()) {
+
+		for (size_t first = 0; first < n_elements; first += chunk_size) {
+
+			function(first, std::min(first + chunk_size, n_elements));
+
+		};
+
+		return;
+
+	};
+
+	{
+
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->job = &function;
+		this->job_n_elements = n_elements;
+		this->job_chunk_size = chunk_size;
+		this->job_n_chunks = n_chunks;
+		this->next_chunk.store(0, std::memory_order_relaxed);
+		this->n_finished_workers = 0;
+		this->generation++;
+
+	};
+	this->job_available.notify_all();
+
+	this->run_chunks();
+
+	{
+
+		std::unique_lock<std::mutex> lock(this->mutex);
+		this->job_finished.wait(lock, [&]() { return this->n_finished_workers == this->workers.size(); });
+		this->job = nullptr;
+
+	};
+	this->submit_mutex.unlock();
+
+};
+
+Thread_Pool& Thread_Pool::shared() {
+
+	static Thread_Pool pool(std::max(1u, std::thread::hardware_concurrency()));
+	return pool;
+
+};
+
+Thread_Pool::Thread_Pool(const unsigned int& n_threads) : 
+	
+	n_threads(std::max(1u, n_threads)), 
+	job(nullptr), 
+	job_n_elements(0), 
+	job_chunk_size(1), 
+	job_n_chunks(0), 
+	next_chunk(0), 
+	n_finished_workers(0), 
+	generation(0), 
+	stop(false) {
+
+	//the calling thread works as well, hence one worker less than requested
+	for (unsigned int i = 1; i < this->n_threads; i++) {
+
+		this->workers.emplace_back(&Thread_Pool::worker_loop, this);
+
+	};
+
+};
+
+Thread_Pool::~Thread_Pool() {
+
+	{
+
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->stop = true;
+
+	};
+	this->job_available.notify_all();
+
+	for (auto& worker : this->workers) {
+
+		worker.join();
+
+	};
+
+};
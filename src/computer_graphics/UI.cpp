@@ -367,9 +367,26 @@ void UI::shader_rendering_options(Shader& shader, Mesh& mesh, unsigned int& GL_P
 	this->obj_file_path = "";
 	this->from_OBJ_file = false;
 
+	//the octrees built next to the LAS files live in the same folder, only the LAS and LAZ files themselves are listed
 	this->las_files = get_files_as_paths_recursively(RESOURCES_DIR"/LAS files");
+	std::erase_if(this->las_files, [](const std::filesystem::path& path) { return path.extension() != ".las" && path.extension() != ".laz" && path.extension() != ".LAS" && path.extension() != ".LAZ"; });
+	this->las_files_summaries = Point_Cloud::read_header_summaries(this->las_files);
 	this->las_file_path = "";
+	this->loaded_las_file_path = "";
 	this->from_LAS_file = false;
+	this->stream_LAS_file = false;
+	this->octree_LAS_file = false;
+	this->mosaic_LAS_file = false;
+	this->compact_LAS_points = true;
+	this->keep_LAS_point_attributes = true;
+	this->remove_LAS_outliers = false;
+	this->estimate_LAS_normals = false;
+	this->LAS_point_budget = 0;
+	this->LAS_voxel_selection = Voxel_Downsampler::FIRST_POINT;
+	this->LAS_point_filter = Point_Cloud::Point_Filter();
+	this->LAS_returns = Point_Cloud::Point_Filter::ALL_RETURNS;
+	this->LAS_intensity_range[0] = 0; this->LAS_intensity_range[1] = UINT16_MAX;
+	this->las_mosaic_paths.clear();
 
 	this->console_message = "";
 	this->rendering_information = "Shader Type: NA\nMesh Type: NA\n";
@@ -468,13 +485,66 @@ void UI::shader_rendering_options(Shader& shader, Mesh& mesh, unsigned int& GL_P
 			if (this->from_LAS_file) {
 
 				ImGui::SeparatorText("LAS files");
+				ImGui::Checkbox("stream LAS file in batches", &this->stream_LAS_file);
+				ImGui::Checkbox("level of detail octree", &this->octree_LAS_file);
+				ImGui::Checkbox("mosaic of the chosen LAS files", &this->mosaic_LAS_file);
+				ImGui::Checkbox("compact 12 byte points on the GPU", &this->compact_LAS_points);
+				ImGui::Checkbox("keep intensity, classification, returns and GPS time", &this->keep_LAS_point_attributes);
+				ImGui::Checkbox("remove statistical outliers", &this->remove_LAS_outliers);
+				ImGui::Checkbox("estimate normals for point lighting", &this->estimate_LAS_normals);
+				ImGui::InputInt("downsample to point budget (0 = off)", &this->LAS_point_budget, 100000, 1000000);
+				this->LAS_point_budget = std::max(this->LAS_point_budget, 0);
+				const char* voxel_selections[] = { "first point of a voxel", "centroid of a voxel", "random point of a voxel" };
+				ImGui::Combo("voxel point", &this->LAS_voxel_selection, voxel_selections, IM_ARRAYSIZE(voxel_selections));
+				if (ImGui::TreeNode("point filter")) {
+
+					//the ASPRS standard classes, the ones above are user defined and stay kept
+					const char* classification_names[] = { "never classified", "unclassified", "ground", "low vegetation", "medium vegetation", "high vegetation", "building", "low point (noise)", "reserved", "water",
+						"rail", "road surface", "reserved", "wire guard", "wire conductor", "transmission tower", "wire connector", "bridge deck", "high noise" };
+					for (int i = 0; i < IM_ARRAYSIZE(classification_names); i++) {
+
+						bool kept = this->LAS_point_filter.classifications.test(i);
+						std::string label = std::to_string(i) + " " + classification_names[i];
+						if (ImGui::Checkbox(label.c_str(), &kept)) { this->LAS_point_filter.classifications.set(i, kept); };
+
+					};
+
+					const char* returns[] = { "all returns", "first returns only", "last returns only" };
+					ImGui::Combo("returns", &this->LAS_returns, returns, IM_ARRAYSIZE(returns));
+					ImGui::DragIntRange2("intensity", &this->LAS_intensity_range[0], &this->LAS_intensity_range[1], 16.0f, 0, UINT16_MAX);
+					ImGui::TreePop();
+
+				};
 				for (int i = 0; i < this->las_files.size(); i++) {
 
-					if (ImGui::Button(this->las_files[i].filename().string().c_str(), ImVec2(550, 20))) {
+					const Point_Cloud::Header_Summary& summary = this->las_files_summaries[i];
+					auto in_mosaic = std::find(this->las_mosaic_paths.begin(), this->las_mosaic_paths.end(), std::filesystem::absolute(this->las_files[i]));
+					std::string label = (this->mosaic_LAS_file && in_mosaic != this->las_mosaic_paths.end() ? "[x] " : "") + this->las_files[i].filename().string();
+					if (summary.valid) { label += " | LAS " + std::to_string(summary.version_major) + "." + std::to_string(summary.version_minor) + " | format " + std::to_string(summary.point_data_record_format) + " | " + std::to_string(summary.number_of_point_records) + " points"; }
+					else { label += " | " + summary.error; };
+
+					if (ImGui::Button(label.c_str(), ImVec2(550, 20))) {
 
 						this->las_file_path = std::filesystem::absolute(this->las_files[i]);
 						this->console_message = "new LAS was chosen! " + this->las_file_path.string() + "\n";
 
+						//with the mosaic on, every click adds or removes a tile
+						if (this->mosaic_LAS_file) {
+
+							if (in_mosaic == this->las_mosaic_paths.end()) { this->las_mosaic_paths.push_back(this->las_file_path); }
+							else { this->las_mosaic_paths.erase(in_mosaic); };
+							this->console_message = std::to_string(this->las_mosaic_paths.size()) + " LAS files in the mosaic\n";
+
+						};
+
+					};
+
+					//a fully loaded point cloud holds a position and a color per point
+					if (summary.valid && ImGui::IsItemHovered()) {
+
+						ImGui::SetTooltip("%s\nrecord length: %u bytes\nfile size: %.1f MB\nopenGL memory: %.1f MB\nmin: %.3f %.3f %.3f\nmax: %.3f %.3f %.3f", summary.compressed ? "LAZ compressed" : "uncompressed", static_cast<unsigned int>(summary.point_data_record_length), summary.file_size / (1024.0 * 1024.0), summary.number_of_point_records * 2 * sizeof(vec3) / (1024.0 * 1024.0),
+							summary.minimum_bounds[0], summary.minimum_bounds[1], summary.minimum_bounds[2], summary.maximum_bounds[0], summary.maximum_bounds[1], summary.maximum_bounds[2]);
+
 					};
 
 				};
@@ -504,6 +574,7 @@ void UI::shader_rendering_options(Shader& shader, Mesh& mesh, unsigned int& GL_P
 						shader.bind_mesh_buffers_and_textures(mesh, this->screen_size, GL_STATIC_DRAW, shader.get_reference_bool_uniform("gamma_correction"));
 						this->console_message = "Rebuilt from: SHADER: " + this->shader_folder_path.string() + " GL_PRIMITIVE: " + std::to_string(GL_PRIMITIVE_TYPE) + " LAS: " + this->las_file_path.string();
 						this->rendering_information = "Shader Type: " + this->shader_folder_path.string() + "\n" + "Mesh Type: Texture Map from " + this->texture_map_path.string() + "\n";
+						this->loaded_las_file_path = "";
 
 					}
 					else if (this->from_OBJ_file && this->obj_file_path != "" && this->from_Texture_map && this->texture_map_path != "" && !this->from_LAS_file) {
@@ -516,18 +587,25 @@ void UI::shader_rendering_options(Shader& shader, Mesh& mesh, unsigned int& GL_P
 						shader.bind_mesh_buffers_and_textures(mesh, this->screen_size, GL_STATIC_DRAW, shader.get_reference_bool_uniform("gamma_correction"));
 						this->console_message = "Rebuilt from: SHADER: " + this->shader_folder_path.string() + " GL_PRIMITIVE: " + std::to_string(GL_PRIMITIVE_TYPE) + " LAS: " + this->las_file_path.string();
 						this->rendering_information = "Shader Type: " + this->shader_folder_path.string() + "\n" + "Mesh Type: OBJ file with Texture map from " + this->obj_file_path.string() + " and " + this->texture_map_path.string() + "\n";
+						this->loaded_las_file_path = "";
 
 					}
 					else if (this->from_LAS_file && this->las_file_path != "" && !from_Texture_map && !from_OBJ_file) {
 
 						GL_PRIMITIVE_TYPE = this->gl_primitive_type;
 						shader.rebuild(this->shader_folder_path, vertex_array);
-						mesh = std::move(Mesh::from_LAS(this->las_file_path));
+						//the streamed and octree paths size their buffers and nodes from the header, so only the in memory and mosaic paths are filtered
+						this->LAS_point_filter.RETURNS = uint8_t(this->LAS_returns);
+						this->LAS_point_filter.minimum_intensity = uint16_t(std::clamp(this->LAS_intensity_range[0], 0, int(UINT16_MAX)));
+						this->LAS_point_filter.maximum_intensity = uint16_t(std::clamp(this->LAS_intensity_range[1], 0, int(UINT16_MAX)));
+						mesh = std::move(this->mosaic_LAS_file && !this->las_mosaic_paths.empty() ? Mesh::from_LAS_mosaic(this->las_mosaic_paths, this->LAS_point_filter, this->keep_LAS_point_attributes, this->estimate_LAS_normals) : this->octree_LAS_file ? Mesh::from_LAS_octree(this->las_file_path) : this->stream_LAS_file ? Mesh::from_LAS_stream(this->las_file_path) : Mesh::from_LAS(this->las_file_path, 0.0f, uint64_t(this->LAS_point_budget), uint8_t(this->LAS_voxel_selection), this->LAS_point_filter, this->keep_LAS_point_attributes, this->remove_LAS_outliers, this->estimate_LAS_normals));
+						mesh.quantized_points = this->compact_LAS_points;
 
 						shader.default_uniforms_maps_initialization(this->screen_size);
 						shader.bind_mesh_buffers_and_textures(mesh, this->screen_size, GL_STATIC_DRAW, shader.get_reference_bool_uniform("gamma_correction"));
 						this->console_message = "Rebuilt from: SHADER: " + this->shader_folder_path.string() + " GL_PRIMITIVE: " + std::to_string(GL_PRIMITIVE_TYPE) + " LAS: " + this->las_file_path.string();
 						this->rendering_information = "Shader Type: " + this->shader_folder_path.string() + "\n" + "Mesh Type: LAS file from " + this->las_file_path.string() + "\n";
+						this->loaded_las_file_path = this->mosaic_LAS_file && !this->las_mosaic_paths.empty() ? this->las_mosaic_paths.front() : this->las_file_path;
 
 					}
 					else {
@@ -553,6 +631,14 @@ void UI::shader_rendering_options(Shader& shader, Mesh& mesh, unsigned int& GL_P
 			ImGui::Text(this->rendering_information.c_str());
 			ImGui::Text("\n");
 
+			//writes what is drawn, after filtering, outlier removal and downsampling, next to the file it came from
+			if (this->loaded_las_file_path != "" && ImGui::Button("Export loaded points as LAS", ImVec2(550, 20))) {
+
+				std::filesystem::path export_path = this->loaded_las_file_path.parent_path() / (this->loaded_las_file_path.stem().string() + "_export.las");
+				this->console_message = mesh.write_LAS(export_path) ? "exported the loaded points into " + export_path.string() + "\n" : "ERROR: export failed! The terminal says why.\n";
+
+			};
+
 		};
 
 		ImGui::Text(("Console: " + this->console_message).c_str());
@@ -581,6 +667,8 @@ void UI::shader_scene_and_model_manipulation(Shader& shader, bool& plot) {
 			ImGui::Checkbox("Texturing", &shader.get_reference_bool_uniform("texturing"));
 			ImGui::SameLine();
 			ImGui::Checkbox("Height Coloring", &shader.get_reference_bool_uniform("height_coloring"));
+			const char* color_modes[] = { "RGB", "intensity", "classification", "return", "GPS time" };
+			ImGui::Combo("Point Coloring", &shader.get_reference_int_uniform("color_mode"), color_modes, IM_ARRAYSIZE(color_modes));
 
 			ImGui::SeparatorText("Tesselation & Displacement");
 			ImGui::Checkbox("Displacement Mapping", &shader.get_reference_bool_uniform("displacement_mapping"));
@@ -588,6 +676,11 @@ void UI::shader_scene_and_model_manipulation(Shader& shader, bool& plot) {
 			ImGui::SliderFloat("Displacement Scale", &shader.get_reference_float_uniform("displacement_scale"), 0.0f, 500.0f);
 			ImGui::SliderFloat("Point Size", &shader.get_reference_float_uniform("point_size"), 1.0f, 200.0f);
 
+			ImGui::SeparatorText("Level of Detail Octree");
+			const uint64_t minimum_point_budget = 100000, maximum_point_budget = 50000000;
+			ImGui::SliderScalar("Point Budget", ImGuiDataType_U64, &shader.octree_point_budget, &minimum_point_budget, &maximum_point_budget);
+			ImGui::SliderFloat("Max Screen Space Error", &shader.octree_max_screen_space_error, 0.25f, 20.0f);
+
 		};
 
 	});
@@ -600,6 +693,8 @@ void UI::shader_scene_and_model_manipulation(Shader& shader, bool& plot) {
 			ImGui::Checkbox("Gamma Correction", &shader.get_reference_bool_uniform("gamma_correction"));
 			ImGui::SameLine();
 			ImGui::Checkbox("Normal Mapping", &shader.get_reference_bool_uniform("normal_mapping"));
+			ImGui::SameLine();
+			ImGui::Checkbox("Point Lighting", &shader.get_reference_bool_uniform("point_lighting"));
 
 			this->vec3_color_picker("Light Color", shader.get_reference_vec3_uniform("light_color"));
 
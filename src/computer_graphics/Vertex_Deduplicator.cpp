@@ -0,0 +1,148 @@
+#include "computer_graphics/Vertex_Deduplicator.h"
+
+Vertex_Deduplicator::Key::Key(const vec3& position, const vec3& normal, const vec2& uv) :
+
+	bits{ std::bit_cast<uint32_t>(position.x), std::bit_cast<uint32_t>(position.y), std::bit_cast<uint32_t>(position.z),
+		  std::bit_cast<uint32_t>(normal.x), std::bit_cast<uint32_t>(normal.y), std::bit_cast<uint32_t>(normal.z),
+		  std::bit_cast<uint32_t>(uv.x), std::bit_cast<uint32_t>(uv.y) } {};
+
+uint64_t Vertex_Deduplicator::Key::hash() const {
+
+	uint64_t value = 0;
+	for (int i = 0; i < 8; i += 2) { value = Hash_Binning::mix(value ^ (uint64_t(this->bits[i]) | (uint64_t(this->bits[i + 1]) << 32))); };
+	return value;
+
+};
+
+void Vertex_Deduplicator::rehash(const size_t& n_slots) {
+
+	this->slots.assign(n_slots, { 0, EMPTY });
+	const size_t mask = n_slots - 1;
+	for (uint32_t entry = 0; entry < this->keys.size(); entry++) {
+
+		const uint64_t hash = this->keys[entry].hash();
+		size_t slot = hash & mask;
+		while (this->slots[slot].entry != EMPTY) { slot = (slot + 1) & mask; };
+		this->slots[slot] = { uint32_t(hash >> 32), entry };
+
+	};
+
+};
+
+void Vertex_Deduplicator::reserve(const size_t& n_vertices) {
+
+	this->keys.reserve(n_vertices);
+	this->values.reserve(n_vertices);
+	const size_t n_slots = std::bit_ceil(std::max<size_t>(n_vertices * 2, 16));
+	if (n_slots > this->slots.size()) { this->rehash(n_slots); };
+
+};
+
+uint32_t Vertex_Deduplicator::find_or_insert(const Key& key, const uint32_t& value, bool& inserted) {
+
+	if ((this->keys.size() + 1) * 2 > this->slots.size()) { this->rehash(std::max<size_t>(this->slots.size() * 2, 16)); };
+
+	const uint64_t hash = key.hash();
+	const uint32_t tag = uint32_t(hash >> 32);
+	const size_t mask = this->slots.size() - 1;
+	size_t slot = hash & mask;
+	while (this->slots[slot].entry != EMPTY) {
+
+		if (this->slots[slot].tag == tag && this->keys[this->slots[slot].entry] == key) {
+
+			inserted = false;
+			return this->values[this->slots[slot].entry];
+
+		};
+		slot = (slot + 1) & mask;
+
+	};
+
+	this->slots[slot] = { tag, uint32_t(this->keys.size()) };
+	this->keys.push_back(key);
+	this->values.push_back(value);
+	inserted = true;
+	return value;
+
+};
+
+void Vertex_Deduplicator::clear() {
+
+	this->slots = std::vector<Slot>();
+	this->keys = std::vector<Key>();
+	this->values = std::vector<uint32_t>();
+
+};
+
+size_t Vertex_Deduplicator::deduplicate_by_sorting(const std::vector<Key>& keys, std::vector<uint32_t>& unique_indices, std::vector<uint32_t>& first_occurrences) {
+
+	if (keys.size() > UINT32_MAX) {
+
+		std::cerr << "ERROR: cannot deduplicate " << keys.size() << " vertices, at most " << UINT32_MAX << " are supported\n";
+		exit(EXIT_FAILURE);
+
+	};
+
+	auto start = std::chrono::steady_clock::now();
+	unique_indices.assign(keys.size(), 0);
+	first_occurrences.clear();
+	if (keys.empty()) { return 0; };
+
+	std::vector<Binned_Key> binned_keys;
+	const std::vector<size_t> bucket_offsets = Hash_Binning::bin(keys.size(), binned_keys,
+		[&](const size_t& i) { return Binned_Key{ keys[i].hash(), uint32_t(i) }; },
+		[](const Binned_Key& binned_key) { return binned_key.hash; });
+	const size_t n_buckets = bucket_offsets.size() - 1;
+
+	//sorting by the hash and then the index puts equal keys next to each other without reading them, with the first one of them first. Keys are only compared inside the runs of equal hashes,
+	//against the distinct keys met so far in the run, which are one unless the hashes collide. *representatives* then holds for every key the index of the first key equal to it
+	std::vector<uint32_t> representatives(keys.size());
+	Thread_Pool::shared().parallel_for(n_buckets, 1, [&](const size_t& first, const size_t& last) {
+
+		std::vector<uint32_t> distinct_keys;
+		for (size_t bucket = first; bucket < last; ++bucket) {
+
+			auto begin = binned_keys.begin() + bucket_offsets[bucket];
+			auto end = binned_keys.begin() + bucket_offsets[bucket + 1];
+
+			for (auto binned_key = begin; binned_key != end; ++binned_key) {
+
+				if (binned_key == begin || binned_key->hash != (binned_key - 1)->hash) { distinct_keys.clear(); };
+
+				uint32_t representative = binned_key->index;
+				for (const uint32_t& distinct_key : distinct_keys) {
+
+					if (keys[distinct_key] == keys[binned_key->index]) { representative = distinct_key; break; };
+
+				};
+				if (representative == binned_key->index) { distinct_keys.push_back(representative); };
+				representatives[binned_key->index] = representative;
+
+			};
+
+		};
+
+	});
+
+	//numbering the unique keys in the order they first appear is a prefix sum over the keys that are their own representative
+	for (uint32_t i = 0; i < keys.size(); i++) {
+
+		if (representatives[i] == i) {
+
+			unique_indices[i] = uint32_t(first_occurrences.size());
+			first_occurrences.push_back(i);
+
+		}
+		else {
+
+			unique_indices[i] = unique_indices[representatives[i]];
+
+		};
+
+	};
+
+	std::chrono::duration<double> elapsed_time = std::chrono::steady_clock::now() - start;
+	std::cout << "deduplicated " << keys.size() << " vertices into " << first_occurrences.size() << " by sorting in " << elapsed_time.count() * 1000.0 << " ms\n";
+	return first_occurrences.size();
+
+};
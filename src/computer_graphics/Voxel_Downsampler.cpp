@@ -0,0 +1,279 @@
+#include "computer_graphics/Voxel_Downsampler.h"
+
+Voxel_Downsampler::Bins Voxel_Downsampler::bin_points(const std::vector<vec3>& positions, const float& voxel_size) {
+
+	if (voxel_size <= 0.0f) {
+
+		std::cerr << "ERROR: voxel size " << voxel_size << " has to be positive\n";
+		exit(EXIT_FAILURE);
+
+	};
+	if (positions.size() > UINT32_MAX) {
+
+		std::cerr << "ERROR: cannot downsample " << positions.size() << " points, at most " << UINT32_MAX << " are supported\n";
+		exit(EXIT_FAILURE);
+
+	};
+
+	Bins bins;
+	bins.bucket_offsets.assign(2, 0);
+	if (positions.empty()) {
+
+		return bins;
+
+	};
+
+	std::pair<vec3, vec3> bounds = get_min_max(positions);
+	vec3 extent = bounds.second - bounds.first;
+	float largest_extent = std::max(extent.x, std::max(extent.y, extent.z));
+
+	//a grid finer than the key can hold gets coarser cells instead of colliding ones
+	float cell_size = voxel_size;
+	if (largest_extent / cell_size >= float(MAX_CELLS_PER_AXIS - 1)) {
+
+		cell_size = largest_extent / float(MAX_CELLS_PER_AXIS - 2);
+		std::cout << "WARNING: voxel size " << voxel_size << " is too fine for a cloud " << largest_extent << " wide, using " << cell_size << " instead\n";
+
+	};
+
+	const vec3 minimum = bounds.first;
+	const float inverse_cell_size = 1.0f / cell_size;
+	auto compute_key = [&](const vec3& position) {
+
+		uint64_t x = std::min(uint64_t((position.x - minimum.x) * inverse_cell_size), uint64_t(MAX_CELLS_PER_AXIS - 1));
+		uint64_t y = std::min(uint64_t((position.y - minimum.y) * inverse_cell_size), uint64_t(MAX_CELLS_PER_AXIS - 1));
+		uint64_t z = std::min(uint64_t((position.z - minimum.z) * inverse_cell_size), uint64_t(MAX_CELLS_PER_AXIS - 1));
+		return (x << 42) | (y << 21) | z;
+
+	};
+
+	bins.bucket_offsets = Hash_Binning::bin(positions.size(), bins.points,
+		[&](const size_t& i) { return Binned_Point{ compute_key(positions[i]), uint32_t(i) }; },
+		[](const Binned_Point& point) { return Hash_Binning::mix(point.key); });
+
+	return bins;
+
+};
+
+uint64_t Voxel_Downsampler::count_occupied_voxels(const std::vector<vec3>& positions, const float& voxel_size) {
+
+	Bins bins = bin_points(positions, voxel_size);
+
+	size_t n_buckets = bins.bucket_offsets.size() - 1;
+	std::vector<uint64_t> bucket_voxels(n_buckets, 0);
+	Thread_Pool::shared().parallel_for(n_buckets, 1, [&](const size_t& first, const size_t& last) {
+
+		for (size_t bucket = first; bucket < last; ++bucket) {
+
+			for (size_t i = bins.bucket_offsets[bucket]; i < bins.bucket_offsets[bucket + 1]; ++i) {
+
+				bucket_voxels[bucket] += (i == bins.bucket_offsets[bucket] || bins.points[i].key != bins.points[i - 1].key);
+
+			};
+
+		};
+
+	});
+
+	uint64_t n_voxels = 0;
+	for (const uint64_t& count : bucket_voxels) {
+
+		n_voxels += count;
+
+	};
+	return n_voxels;
+
+};
+
+float Voxel_Downsampler::compute_voxel_size(const std::vector<vec3>& positions, const uint64_t& point_budget) {
+
+	if (point_budget == 0 || positions.size() <= point_budget) {
+
+		return 0.0f;
+
+	};
+
+	std::pair<vec3, vec3> bounds = get_min_max(positions);
+	vec3 extent = bounds.second - bounds.first;
+	float extents[3] = { extent.x, extent.y, extent.z };
+	std::sort(extents, extents + 3);
+	if (extents[2] <= 0.0f) {
+
+		//every point is at the same place, a single cell holds them all
+		return 1.0f;
+
+	};
+
+	//LAS clouds mostly cover a surface, so the first guess spreads the budget over the two largest extents
+	double dimension = 2.0;
+	double size = std::sqrt(double(std::max(extents[1], extents[2] * 1e-3f)) * double(extents[2]) / double(point_budget));
+
+	double best_size = 0.0;
+	double previous_size = 0.0;
+	double previous_count = 0.0;
+	static constexpr uint8_t MAX_TRIES = 8;
+	for (uint8_t attempt = 0; attempt < MAX_TRIES; ++attempt) {
+
+		double count = double(count_occupied_voxels(positions, float(size)));
+		if (count <= double(point_budget) && (best_size == 0.0 || size < best_size)) {
+
+			best_size = size;
+
+		};
+
+		//close enough below the budget
+		if (count <= double(point_budget) && count >= 0.95 * double(point_budget)) {
+
+			break;
+
+		};
+
+		if (previous_size != 0.0 && previous_count != count && previous_size != size) {
+
+			dimension = std::clamp(std::log(previous_count / count) / std::log(size / previous_size), 1.0, 3.0);
+
+		};
+		previous_size = size;
+		previous_count = count;
+
+		//aims slightly under the budget so the next try is more likely to fit in it
+		size *= std::pow(count / (0.98 * double(point_budget)), 1.0 / dimension);
+
+	};
+
+	//nothing tried fits, grow the cells until one does
+	while (best_size == 0.0) {
+
+		size *= 1.25;
+		if (count_occupied_voxels(positions, float(size)) <= point_budget) {
+
+			best_size = size;
+
+		};
+
+	};
+
+	return float(best_size);
+
+};
+
+void Voxel_Downsampler::downsample(std::vector<vec3>& positions, std::vector<vec3>& colors, const float& voxel_size, const uint8_t& SELECTION, const uint64_t& seed, std::vector<uint32_t>* representatives) {
+
+	if (SELECTION > RANDOM_POINT) {
+
+		std::cerr << "ERROR: unknown voxel selection " << int(SELECTION) << "\n";
+		exit(EXIT_FAILURE);
+
+	};
+
+	auto start = std::chrono::steady_clock::now();
+	bool has_colors = colors.size() == positions.size();
+	Bins bins = bin_points(positions, voxel_size);
+
+	//the number of cells of every bucket gives every bucket its range of the output
+	size_t n_buckets = bins.bucket_offsets.size() - 1;
+	std::vector<size_t> output_offsets(n_buckets + 1, 0);
+	Thread_Pool::shared().parallel_for(n_buckets, 1, [&](const size_t& first, const size_t& last) {
+
+		for (size_t bucket = first; bucket < last; ++bucket) {
+
+			for (size_t i = bins.bucket_offsets[bucket]; i < bins.bucket_offsets[bucket + 1]; ++i) {
+
+				output_offsets[bucket + 1] += (i == bins.bucket_offsets[bucket] || bins.points[i].key != bins.points[i - 1].key);
+
+			};
+
+		};
+
+	});
+	for (size_t bucket = 0; bucket < n_buckets; ++bucket) {
+
+		output_offsets[bucket + 1] += output_offsets[bucket];
+
+	};
+
+	std::vector<vec3> downsampled_positions(output_offsets[n_buckets]);
+	std::vector<vec3> downsampled_colors(has_colors ? output_offsets[n_buckets] : 0);
+	if (representatives) { representatives->resize(output_offsets[n_buckets]); };
+	Thread_Pool::shared().parallel_for(n_buckets, 1, [&](const size_t& first, const size_t& last) {
+
+		for (size_t bucket = first; bucket < last; ++bucket) {
+
+			size_t output = output_offsets[bucket];
+			size_t run_start = bins.bucket_offsets[bucket];
+			size_t bucket_end = bins.bucket_offsets[bucket + 1];
+			while (run_start < bucket_end) {
+
+				size_t run_end = run_start + 1;
+				while (run_end < bucket_end && bins.points[run_end].key == bins.points[run_start].key) {
+
+					++run_end;
+
+				};
+
+				if (SELECTION == CENTROID) {
+
+					double position[3] = { 0.0, 0.0, 0.0 };
+					double color[3] = { 0.0, 0.0, 0.0 };
+					for (size_t i = run_start; i < run_end; ++i) {
+
+						const vec3& point = positions[bins.points[i].index];
+						position[0] += point.x; position[1] += point.y; position[2] += point.z;
+						if (has_colors) {
+
+							const vec3& point_color = colors[bins.points[i].index];
+							color[0] += point_color.x; color[1] += point_color.y; color[2] += point_color.z;
+
+						};
+
+					};
+
+					double n_points = double(run_end - run_start);
+					downsampled_positions[output] = vec3(float(position[0] / n_points), float(position[1] / n_points), float(position[2] / n_points));
+					if (has_colors) {
+
+						downsampled_colors[output] = vec3(float(color[0] / n_points), float(color[1] / n_points), float(color[2] / n_points));
+
+					};
+					if (representatives) { (*representatives)[output] = bins.points[run_start].index; };
+
+				}
+				else {
+
+					size_t chosen = run_start;
+					if (SELECTION == RANDOM_POINT) {
+
+						chosen += Hash_Binning::mix(bins.points[run_start].key ^ Hash_Binning::mix(seed)) % (run_end - run_start);
+
+					};
+
+					downsampled_positions[output] = positions[bins.points[chosen].index];
+					if (has_colors) {
+
+						downsampled_colors[output] = colors[bins.points[chosen].index];
+
+					};
+					if (representatives) { (*representatives)[output] = bins.points[chosen].index; };
+
+				};
+
+				++output;
+				run_start = run_end;
+
+			};
+
+		};
+
+	});
+
+	std::chrono::duration<double> elapsed_time = std::chrono::steady_clock::now() - start;
+	std::cout << "downsampled " << positions.size() << " points to " << downsampled_positions.size() << " voxels of size " << voxel_size << " in " << elapsed_time.count() * 1000.0 << " ms\n";
+
+	positions = std::move(downsampled_positions);
+	if (has_colors) {
+
+		colors = std::move(downsampled_colors);
+
+	};
+
+};